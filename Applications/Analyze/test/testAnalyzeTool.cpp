@@ -41,6 +41,7 @@ using namespace OpenSim;
 using namespace std;
 
 void testTutorialOne();
+void testParallelAnalyze();
 void testActuationAnalysisWithDisabledForce();
 
 // Test different default activations are respected when activation
@@ -60,6 +61,11 @@ int main()
         cout << e.what() << endl; failures.push_back("testTutorialOne");
     }
 
+    try { testParallelAnalyze(); }
+    catch (const std::exception& e) {
+        cout << e.what() << endl; failures.push_back("testParallelAnalyze");
+    }
+
     // produce passive force-length curve
     try { testTugOfWar("Tug_of_War_ConstantVelocity.sto", 0.01); }
     catch (const std::exception& e) {
@@ -132,6 +138,34 @@ void testTutorialOne() {
     cout << "testAnalyzeTutorialOne passed" << endl;
 }
 
+void testParallelAnalyze() {
+    // Analyzing blocks of states concurrently gives the same results as
+    // analyzing the states in sequence.
+    AnalyzeTool serial("PlotterTool.xml");
+    serial.setName("Serial");
+    serial.run();
+
+    AnalyzeTool parallel("PlotterTool.xml");
+    parallel.setName("Parallel");
+    parallel.setParallel(3);
+    parallel.run();
+
+    for (const string& suffix :
+            {"__FiberLength.sto", "_Actuation_force.sto"}) {
+        Storage serialResults("testPlotterTool/Serial" + suffix);
+        Storage parallelResults("testPlotterTool/Parallel" + suffix);
+        ASSERT(parallelResults.getSize() == serialResults.getSize());
+        ASSERT_EQUAL(serialResults.getFirstTime(),
+                parallelResults.getFirstTime(), 1e-12);
+        ASSERT_EQUAL(serialResults.getLastTime(),
+                parallelResults.getLastTime(), 1e-12);
+        CHECK_STORAGE_AGAINST_STANDARD(parallelResults, serialResults,
+            std::vector<double>(100, 1e-10), __FILE__, __LINE__,
+            "testParallelAnalyze failed for " + suffix);
+    }
+    cout << "testParallelAnalyze passed" << endl;
+}
+
 void testTugOfWar(const string& dataFileName, const double& defaultAct) {
     AnalyzeTool analyze("Tug_of_War_Setup_Analyze.xml");
     analyze.setCoordinatesFileName("");
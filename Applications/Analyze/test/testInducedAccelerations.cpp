@@ -28,6 +28,7 @@
 #include <OpenSim/Simulation/Control/PrescribedController.h>
 #include <OpenSim/Tools/AnalyzeTool.h>
 #include <OpenSim/Auxiliary/auxiliaryTestFunctions.h>
+#include <OpenSim/Analyses/InducedAccelerations.h>
 #include <OpenSim/Analyses/InducedAccelerationsSolver.h>
 
 using namespace OpenSim;
@@ -37,6 +38,7 @@ using namespace std;
 // Prototypes
 void testDoublePendulumWithSolver();
 void testDoublePendulum();
+void testRunningBatchedInParallel(const Storage& standard);
 Vector calcDoublePendulumUdot(const Model &model, State &s, double Torq1, double Torq2, bool gravity, bool velocity);
 
 int main()
@@ -57,6 +59,10 @@ int main()
             std::vector<double>(result1.getSmallestNumberOfStates(), 0.15),
             __FILE__, __LINE__, "Induced Accelerations of Running failed");
         cout << "Induced Accelerations of Running passed\n" << endl;
+
+        // The run above reports constraint reactions, so it realizes the
+        // model for each actuator.
+        testRunningBatchedInParallel(result1);
     }
     catch (const OpenSim::Exception& e) {
         e.print(cerr);
@@ -165,6 +171,28 @@ void testDoublePendulumWithSolver()
     cout << "Solver computed " << nt << " frames in " << 1.e3*(std::clock()-startTime)/CLOCKS_PER_SEC << "ms\n" << endl;
 }
 
+void testRunningBatchedInParallel(const Storage& standard)
+{
+    // Solving for the contributions of the muscles together, with blocks of
+    // states analyzed concurrently, gives the same accelerations as realizing
+    // the model for each muscle, one state at a time.
+    AnalyzeTool analyze("subject02_Setup_IAA_02_232.xml");
+    analyze.setName("subject02_running_arms_batched");
+    analyze.setParallel(2);
+    auto& iaa = dynamic_cast<InducedAccelerations&>(
+            analyze.getModel().updAnalysisSet().get("InducedAccelerations"));
+    iaa.setReportConstraintReactions(false);
+    ASSERT(iaa.getBatchActuatorContributions());
+    analyze.run();
+
+    Storage result("ResultsInducedAccelerations/subject02_running_arms_batched_InducedAccelerations_center_of_mass.sto");
+    ASSERT(result.getSize() == standard.getSize());
+    CHECK_STORAGE_AGAINST_STANDARD(result, standard,
+        std::vector<double>(standard.getSmallestNumberOfStates(), 1e-6),
+        __FILE__, __LINE__, "Batched Induced Accelerations of Running failed");
+    cout << "Batched Induced Accelerations of Running passed\n" << endl;
+}
+
 void testDoublePendulum()
 {
     std::clock_t startTime = std::clock();
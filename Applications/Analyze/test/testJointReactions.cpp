@@ -28,6 +28,42 @@
 using namespace OpenSim;
 using namespace std;
 
+// The reactions on the parent are found from the reactions on the children of
+// all mobilizers; they must match those computed joint by joint.
+void testReactionsOnParent()
+{
+    Model model("DoublePendulum3D.osim");
+    SimTK::State& s = model.initSystem();
+    const CoordinateSet& coordinates = model.getCoordinateSet();
+    for (int i = 0; i < coordinates.getSize(); ++i) {
+        coordinates[i].setValue(s, 0.3*(i + 1), false);
+        coordinates[i].setSpeedValue(s, -0.5*(i + 1));
+    }
+
+    JointReaction reaction(&model);
+    Array<std::string> onBody("parent", 1);
+    reaction.setOnBody(onBody);
+    reaction.setModel(model);
+    reaction.begin(s);
+    const Storage& loads = reaction.getReactionLoadsStorage();
+    ASSERT(loads.getSize() == 1);
+    const Array<double>& row = loads.getStateVector(0)->getData();
+
+    model.realizeAcceleration(s);
+    const JointSet& joints = model.getJointSet();
+    for (int i = 0; i < joints.getSize(); ++i) {
+        SimTK::SpatialVec expected =
+            joints[i].calcReactionOnParentExpressedInGround(s);
+        SimTK::Vec3 point =
+            joints[i].getParentFrame().getTransformInGround(s).p();
+        for (int j = 0; j < 3; ++j) {
+            ASSERT_EQUAL(expected[1][j], row[9*i + j], 1e-9);
+            ASSERT_EQUAL(expected[0][j], row[9*i + j + 3], 1e-9);
+            ASSERT_EQUAL(point[j], row[9*i + j + 6], 1e-9);
+        }
+    }
+}
+
 int main()
 {
     try {
@@ -66,6 +102,19 @@ int main()
             std::vector<double>(standard4.getSmallestNumberOfStates(), 1e-5), __FILE__, __LINE__,
             "DoublePendulum3D_FrameKeyword failed");
         cout << "DoublePendulum3D_FrameKeyword passed" << endl;
+
+        AnalyzeTool analyze5("DoublePendulum3D_Setup_JointReaction.xml");
+        analyze5.setName("DoublePendulum3D_parallel");
+        analyze5.setParallel(2);
+        analyze5.run();
+        Storage result5("DoublePendulum3D_parallel_JointReaction_ReactionLoads.sto");
+        CHECK_STORAGE_AGAINST_STANDARD(result5, standard2,
+            std::vector<double>(standard2.getSmallestNumberOfStates(), 1e-5), __FILE__, __LINE__,
+            "DoublePendulum3D in parallel failed");
+        cout << "DoublePendulum3D in parallel passed" << endl;
+
+        testReactionsOnParent();
+        cout << "Reactions on parent passed" << endl;
     }
     catch (const std::exception& e) {
         cout << e.what() << endl;
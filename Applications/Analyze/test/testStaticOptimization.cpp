@@ -25,6 +25,13 @@
 #include <OpenSim/Simulation/Model/Model.h>
 #include <OpenSim/Tools/AnalyzeTool.h>
 #include <OpenSim/Analyses/StaticOptimization.h>
+#include <OpenSim/Analyses/StaticOptimizationTarget.h>
+#include <OpenSim/Actuators/CoordinateActuator.h>
+#include <OpenSim/Common/GCVSplineSet.h>
+#include <OpenSim/Common/LinearFunction.h>
+#include <OpenSim/Simulation/Model/PathActuator.h>
+#include <OpenSim/Simulation/SimbodyEngine/CoordinateCouplerConstraint.h>
+#include <OpenSim/Simulation/SimbodyEngine/PinJoint.h>
 #include <OpenSim/Auxiliary/auxiliaryTestFunctions.h>
 
 using namespace OpenSim;
@@ -46,6 +53,19 @@ void testModelWithPassiveForces();
 
 void testRelativePathInExternalLoads();
 
+// Verify that solving the frames in parallel gives the same results as
+// solving them in sequence.
+void testParallel();
+
+// Verify that the quadratic programming solver finds the same solution as the
+// interior point optimizer.
+void testQPSolver();
+
+// Verify that the linear constraint matrix of StaticOptimizationTarget
+// matches the change in accelerations from perturbing each actuator, for a
+// model with a kinematic constraint, CoordinateActuators and a PathActuator.
+void testConstraintMatrix();
+
 int main()
 {
     Array<string> muscleModelNames;
@@ -105,6 +125,30 @@ int main()
         failures.push_back("testArm26DisabledMuscles");
     }
 
+    try {
+        testParallel();
+    }
+    catch (const std::exception& e) {
+        cout << e.what() << endl;
+        failures.push_back("testParallel");
+    }
+
+    try {
+        testQPSolver();
+    }
+    catch (const std::exception& e) {
+        cout << e.what() << endl;
+        failures.push_back("testQPSolver");
+    }
+
+    try {
+        testConstraintMatrix();
+    }
+    catch (const std::exception& e) {
+        cout << e.what() << endl;
+        failures.push_back("testConstraintMatrix");
+    }
+
     if (!failures.empty()) {
         cout << "Done, with failure(s): " << failures << endl;
         return 1;
@@ -265,4 +309,181 @@ void testArm26DisabledMuscles() {
     ASSERT_EQUAL(forces.getColumnLabels().findIndex("TRIlat"), -1);
     ASSERT_EQUAL(forces.getColumnLabels().findIndex("TRImed"), -1);
 
-}
\ No newline at end of file
+}
+
+void testParallel() {
+    const std::string serialDir = "Results_arm26_StaticOptimization_Serial";
+    const std::string parallelDir = "Results_arm26_StaticOptimization_Parallel";
+    {
+        AnalyzeTool analyze("arm26_Setup_StaticOptimization.xml");
+        analyze.setResultsDir(serialDir);
+        analyze.run();
+    }
+    {
+        AnalyzeTool analyze("arm26_Setup_StaticOptimization.xml");
+        analyze.setResultsDir(parallelDir);
+        auto& so = dynamic_cast<StaticOptimization&>(
+                analyze.updAnalysisSet().get("StaticOptimization"));
+        so.setParallel(4);
+        analyze.run();
+    }
+
+    Storage serialActivations(
+            serialDir + "/arm26_StaticOptimization_activation.sto");
+    Storage parallelActivations(
+            parallelDir + "/arm26_StaticOptimization_activation.sto");
+    ASSERT_EQUAL(serialActivations.getSize(), parallelActivations.getSize());
+    CHECK_STORAGE_AGAINST_STANDARD(parallelActivations, serialActivations,
+            std::vector<double>(6, 1e-3), __FILE__, __LINE__,
+            "Parallel activations do not match serial activations.");
+
+    Storage serialForces(serialDir + "/arm26_StaticOptimization_force.sto");
+    Storage parallelForces(parallelDir + "/arm26_StaticOptimization_force.sto");
+    ASSERT_EQUAL(serialForces.getSize(), parallelForces.getSize());
+    CHECK_STORAGE_AGAINST_STANDARD(parallelForces, serialForces,
+            std::vector<double>(6, 0.5), __FILE__, __LINE__,
+            "Parallel forces do not match serial forces.");
+    cout << "testParallel passed." << endl;
+}
+
+void testQPSolver() {
+    const std::string ipoptDir = "Results_arm26_StaticOptimization_IPOPT";
+    const std::string qpDir = "Results_arm26_StaticOptimization_QP";
+    for (bool useQPSolver : {false, true}) {
+        AnalyzeTool analyze("arm26_Setup_StaticOptimization.xml");
+        analyze.setResultsDir(useQPSolver ? qpDir : ipoptDir);
+        auto& so = dynamic_cast<StaticOptimization&>(
+                analyze.updAnalysisSet().get("StaticOptimization"));
+        so.setUseQPSolver(useQPSolver);
+        analyze.run();
+    }
+
+    Storage ipoptActivations(
+            ipoptDir + "/arm26_StaticOptimization_activation.sto");
+    Storage qpActivations(qpDir + "/arm26_StaticOptimization_activation.sto");
+    ASSERT_EQUAL(ipoptActivations.getSize(), qpActivations.getSize());
+    CHECK_STORAGE_AGAINST_STANDARD(qpActivations, ipoptActivations,
+            std::vector<double>(6, 1e-3), __FILE__, __LINE__,
+            "QP activations do not match IPOPT activations.");
+
+    Storage ipoptForces(ipoptDir + "/arm26_StaticOptimization_force.sto");
+    Storage qpForces(qpDir + "/arm26_StaticOptimization_force.sto");
+    CHECK_STORAGE_AGAINST_STANDARD(qpForces, ipoptForces,
+            std::vector<double>(6, 0.5), __FILE__, __LINE__,
+            "QP forces do not match IPOPT forces.");
+    cout << "testQPSolver passed." << endl;
+}
+
+void testConstraintMatrix() {
+    using SimTK::Vec3;
+
+    // A chain of three links whose last pin is coupled to the second one.
+    Model model;
+    model.setName("constrained_chain");
+    std::vector<Body*> bodies;
+    const PhysicalFrame* parent = &model.getGround();
+    for (int i = 0; i < 3; ++i) {
+        const std::string suffix = std::to_string(i + 1);
+        Body* body = new Body("b" + suffix, 1.0, Vec3(0, -0.25, 0),
+                SimTK::Inertia(0.01));
+        PinJoint* pin = new PinJoint("pin" + suffix, *parent,
+                Vec3(0, i == 0 ? 0 : -0.5, 0), Vec3(0), *body, Vec3(0),
+                Vec3(0));
+        pin->updCoordinate(PinJoint::Coord::RotationZ).setName("q" + suffix);
+        model.addBody(body);
+        model.addJoint(pin);
+        bodies.push_back(body);
+        parent = body;
+    }
+    CoordinateCouplerConstraint* coupler = new CoordinateCouplerConstraint();
+    coupler->setName("coupler");
+    coupler->setIndependentCoordinateNames(Array<std::string>("q2", 1));
+    coupler->setDependentCoordinateName("q3");
+    coupler->setFunction(LinearFunction(0.5, 0.0));
+    model.addConstraint(coupler);
+
+    for (int i = 0; i < 3; ++i) {
+        const std::string name = "q" + std::to_string(i + 1);
+        CoordinateActuator* act = new CoordinateActuator(name);
+        act->setName(name + "_actuator");
+        act->setOptimalForce(10.0 * (i + 1));
+        model.addForce(act);
+    }
+    PathActuator* pathAct = new PathActuator();
+    pathAct->setName("path_actuator");
+    pathAct->setOptimalForce(50.0);
+    pathAct->addNewPathPoint("origin", model.getGround(), Vec3(0.1, 0, 0));
+    pathAct->addNewPathPoint("insertion", *bodies[1], Vec3(0.05, -0.25, 0));
+    model.addForce(pathAct);
+
+    SimTK::State& s = model.initSystem();
+    model.getCoordinateSet().get("q1").setValue(s, 0.3, false);
+    model.getCoordinateSet().get("q2").setValue(s, 0.5, false);
+    model.assemble(s);
+    model.getCoordinateSet().get("q1").setSpeedValue(s, 1.0);
+    s.setTime(0.5);
+
+    std::vector<ScalarActuator*> actuators;
+    for (auto& act : model.updComponentList<ScalarActuator>()) {
+        act.overrideActuation(s, true);
+        actuators.push_back(&act);
+    }
+
+    // Desired speeds of the coordinates, to be splined by the target.
+    const auto coordinates = model.getCoordinatesInMultibodyTreeOrder();
+    Storage states;
+    Array<std::string> labels;
+    labels.append("time");
+    for (const auto& coord : coordinates) {
+        labels.append(coord->getStateVariableNames()[1]);
+    }
+    states.setColumnLabels(labels);
+    for (int k = 0; k <= 10; ++k) {
+        SimTK::Vector y((int)coordinates.size());
+        for (int i = 0; i < y.size(); ++i) y[i] = std::sin(0.1 * k + i);
+        states.append(0.1 * k, y);
+    }
+
+    std::vector<int> accelerationIndices;
+    for (int i = 0; i < (int)coordinates.size(); ++i) {
+        if (!coordinates[i]->isConstrained(s)) {
+            accelerationIndices.push_back(i);
+        }
+    }
+    ASSERT(accelerationIndices.size() == 2);
+
+    const int na = (int)actuators.size();
+    const int nc = (int)accelerationIndices.size();
+    StaticOptimizationTarget target(s, &model, na, nc, false);
+    target.setStatesStore(&states);
+    target.setStatesSplineSet(GCVSplineSet(5, &states));
+    SimTK::Vector parameters(na, 0.0);
+    target.prepareToOptimize(s, &parameters[0]);
+    SimTK::Matrix constraintMatrix;
+    target.constraintJacobian(parameters, true, constraintMatrix);
+    ASSERT(constraintMatrix.nrow() == nc && constraintMatrix.ncol() == na);
+
+    // Perturb one actuator at a time by its optimal force and realize the
+    // whole model, as the constraint matrix used to be computed.
+    auto computeUDot = [&](int perturbed) {
+        for (int p = 0; p < na; ++p) {
+            actuators[p]->setOverrideActuation(s,
+                    p == perturbed ? actuators[p]->getOptimalForce() : 0.0);
+        }
+        model.getMultibodySystem().realize(s, SimTK::Stage::Acceleration);
+        return SimTK::Vector(model.getMatterSubsystem().getUDot(s));
+    };
+    const SimTK::Vector udotZero = computeUDot(-1);
+    for (int p = 0; p < na; ++p) {
+        const SimTK::Vector udot = computeUDot(p);
+        for (int c = 0; c < nc; ++c) {
+            const int u = accelerationIndices[c];
+            const double expected = -(udot[u] - udotZero[u]);
+            cout << actuators[p]->getName() << ", constraint " << c
+                 << ": expected " << expected << ", got "
+                 << constraintMatrix(c, p) << endl;
+            ASSERT_EQUAL(expected, constraintMatrix(c, p),
+                    1e-8 * std::max(1.0, std::abs(expected)));
+        }
+    }
+}
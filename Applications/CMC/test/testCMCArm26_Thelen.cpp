@@ -54,6 +54,26 @@ void testCMCArm26() {
 }
 
 
+void testCMCArm26Parallel() {
+    cout << "\n******************************************************************" << endl;
+    cout << "*                  testCMCArm26_Thelen (parallel)                 *" << endl;
+    cout << "******************************************************************\n" << endl;
+    CMCTool cmc("arm26_Setup_CMC.xml");
+    cmc.setUseParallelPredictor(true);
+    cmc.setResultsDir("Results_Arm26_Parallel");
+    cmc.run();
+
+    // Same results as the serial predictor, to within the tolerance of the
+    // actuator integration.
+    Storage results("Results_Arm26_Parallel/arm26_states.sto"),
+            serial("Results_Arm26/arm26_states.sto");
+    std::vector<double> rms_tols(2*2+2*6, 1e-3);
+    CHECK_STORAGE_AGAINST_STANDARD(results, serial, rms_tols, __FILE__,
+            __LINE__, "testCMCArm26Parallel failed");
+
+    cout << "\ntestCMCArm26Parallel passed\n" << endl;
+}
+
 int main() {
 
     SimTK::Array_<std::string> failures;
@@ -64,6 +84,12 @@ int main() {
         cout << e.what() <<endl; failures.push_back("testCMCArm26"); 
     }
 
+    try{
+        testCMCArm26Parallel();
+    } catch(const std::exception& e) {
+        cout << e.what() <<endl; failures.push_back("testCMCArm26Parallel");
+    }
+
     if (!failures.empty()) {
         cout << "Done, with failure(s): " << failures << endl;
         return 1;
@@ -39,6 +39,7 @@ using namespace std;
 
 void testThoracoscapularShoulderModel();
 void testBallJoint();
+void testParallel();
 
 int main()
 {
@@ -59,6 +60,9 @@ int main()
             "testGait failed");
         cout << "testGait passed" << endl;
 
+        testParallel();
+        cout << "testParallel passed" << endl;
+
         testThoracoscapularShoulderModel();
         cout << "testThoracoscapularShoulderModel passed" << endl;
         // Commented out testBallJoint due to sporadic crash in Model destructor
@@ -218,4 +222,32 @@ void testBallJoint() {
     ASSERT_THROW(Exception,
             ASSERT_EQUAL(idSolverVecZeroUDot, idToolVec, 1e-6, 
             __FILE__, __LINE__, "testThoracoscapularShoulderModel failed"));
-}
\ No newline at end of file
+}
+
+void testParallel() {
+    // Solving the frames concurrently must not change the generalized forces
+    // or the equivalent body forces at the joints.
+    auto runTool = [](int parallel, const std::string& suffix) {
+        InverseDynamicsTool id("subject01_Setup_InverseDynamics.xml");
+        id.setParallel(parallel);
+        id.setOutputGenForceFileName("subject01_ID_" + suffix + ".sto");
+        id.getPropertySet().get("joints_to_report_body_forces")->setValue(
+                Array<std::string>("All", 1));
+        id.getPropertySet().get("output_body_forces_file")->setValue(
+                "subject01_ID_body_forces_" + suffix + ".sto");
+        ASSERT(id.run());
+    };
+    runTool(0, "serial");
+    runTool(4, "parallel");
+
+    for (const std::string prefix : {"subject01_ID_", "subject01_ID_body_forces_"}) {
+        Storage serial("Results/" + prefix + "serial.sto");
+        Storage parallel("Results/" + prefix + "parallel.sto");
+        ASSERT(serial.getSize() == parallel.getSize());
+        ASSERT(serial.getColumnLabels() == parallel.getColumnLabels());
+        const int nc = serial.getColumnLabels().getSize() - 1;
+        CHECK_STORAGE_AGAINST_STANDARD(parallel, serial,
+                std::vector<double>(nc, 1e-8), __FILE__, __LINE__,
+                "testParallel failed");
+    }
+}
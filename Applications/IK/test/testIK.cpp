@@ -30,6 +30,7 @@
 #include <OpenSim/Simulation/Model/Model.h>
 #include <OpenSim/Simulation/OrientationsReference.h>
 #include <OpenSim/Simulation/InverseKinematicsSolver.h>
+#include <OpenSim/Tools/BatchToolRunner.h>
 #include <OpenSim/Tools/InverseKinematicsTool.h>
 #include <OpenSim/Tools/IKTaskSet.h>
 #include <OpenSim/Auxiliary/auxiliaryTestFunctions.h>
@@ -42,6 +43,9 @@ void checkMarkersReferenceConsistencyFromTool(InverseKinematicsTool& ik);
 
 void testInverseKinematicsSolverWithOrientations();
 void testInverseKinematicsSolverWithEulerAnglesFromFile();
+void testInverseKinematicsToolInParallelWindows();
+void testBatchToolRunner();
+void testInverseKinematicsToolWithPredictor();
 
 int main()
 {
@@ -74,6 +78,33 @@ int main()
         failures.push_back("testMarkerWeightAssignments");
     }
 
+    try {
+        ++itc;
+        testInverseKinematicsToolInParallelWindows();
+    }
+    catch (const std::exception& e) {
+        cout << e.what() << endl;
+        failures.push_back("testInverseKinematicsToolInParallelWindows");
+    }
+
+    try {
+        ++itc;
+        testBatchToolRunner();
+    }
+    catch (const std::exception& e) {
+        cout << e.what() << endl;
+        failures.push_back("testBatchToolRunner");
+    }
+
+    try {
+        ++itc;
+        testInverseKinematicsToolWithPredictor();
+    }
+    catch (const std::exception& e) {
+        cout << e.what() << endl;
+        failures.push_back("testInverseKinematicsToolWithPredictor");
+    }
+
     Storage  standard("std_subject01_walk1_ik.mot");
     try {
         InverseKinematicsTool ik1("subject01_Setup_InverseKinematics.xml");
@@ -489,3 +520,122 @@ void testInverseKinematicsSolverWithEulerAnglesFromFile()
     const TimeSeriesTable standard("std_subject01_walk1_ik.mot");
     compareMotionTables(report, standard);
 }
+
+void testInverseKinematicsToolInParallelWindows()
+{
+    // Solve the same trial in sequence and in parallel windows; the motion,
+    // marker errors and model marker locations must agree.
+    auto runTool = [](const std::string& name, int parallel) {
+        InverseKinematicsTool ik("subject01_Setup_InverseKinematics.xml");
+        ik.setName(name);
+        ik.set_report_errors(true);
+        ik.set_report_marker_locations(true);
+        ik.set_parallel(parallel);
+        ik.set_parallel_window_overlap(5);
+        ik.setOutputMotionFileName(name + "_ik.mot");
+        ik.run();
+        return ik.getResultsDir();
+    };
+    const std::string resultsDir = runTool("subject01_serial", 0);
+    runTool("subject01_parallel", 4);
+
+    auto compare = [](const std::string& serialFile,
+                           const std::string& parallelFile, double tolerance) {
+        Storage serial(serialFile);
+        Storage parallel(parallelFile);
+        ASSERT(serial.getSize() == parallel.getSize(), __FILE__, __LINE__,
+                "Parallel IK solved a different number of frames.");
+        CHECK_STORAGE_AGAINST_STANDARD(parallel, serial,
+                std::vector<double>(serial.getColumnLabels().getSize(),
+                        tolerance),
+                __FILE__, __LINE__,
+                "Parallel IK differs from serial IK: " + parallelFile);
+    };
+    // Degrees, meters squared and meters.
+    compare("subject01_serial_ik.mot", "subject01_parallel_ik.mot", 1e-2);
+    compare(resultsDir + "/subject01_serial_ik_marker_errors.sto",
+            resultsDir + "/subject01_parallel_ik_marker_errors.sto", 1e-6);
+    compare(resultsDir + "/subject01_serial_ik_model_marker_locations.sto",
+            resultsDir + "/subject01_parallel_ik_model_marker_locations.sto",
+            1e-5);
+    cout << "testInverseKinematicsToolInParallelWindows passed" << endl;
+}
+
+void testBatchToolRunner()
+{
+    // Trials run in a batch must give the same results as running the tool
+    // by itself.
+    const std::string setupFile = "subject01_Setup_InverseKinematics.xml";
+    {
+        InverseKinematicsTool ik(setupFile);
+        ik.setName("subject01_batch_reference");
+        ik.setOutputMotionFileName("subject01_batch_reference_ik.mot");
+        ik.run();
+    }
+    BatchToolRunner runner;
+    for (int i = 0; i < 3; ++i) {
+        const std::string name = "subject01_batch" + std::to_string(i);
+        InverseKinematicsTool ik(setupFile, false);
+        ik.setName(name);
+        ik.setOutputMotionFileName(name + "_ik.mot");
+        ik.print(name + "_Setup_IK.xml");
+        runner.addSetupFile(name + "_Setup_IK.xml");
+    }
+    runner.setNumThreads(2);
+    const auto results = runner.run();
+    BatchToolRunner::printSummary(results);
+
+    Storage reference("subject01_batch_reference_ik.mot");
+    ASSERT(results.size() == 3, __FILE__, __LINE__,
+            "Expected a result for each setup file.");
+    for (const auto& result : results) {
+        ASSERT(result.success, __FILE__, __LINE__,
+                "Batch trial failed: " + result.message);
+        ASSERT(result.toolName == "InverseKinematicsTool");
+        Storage motion("subject01_batch" + std::to_string(result.trial) +
+                       "_ik.mot");
+        CHECK_STORAGE_AGAINST_STANDARD(motion, reference,
+                std::vector<double>(reference.getColumnLabels().getSize(),
+                        1e-6),
+                __FILE__, __LINE__, "Batch IK differs from IK.");
+    }
+    cout << "testBatchToolRunner passed" << endl;
+}
+
+void testInverseKinematicsToolWithPredictor()
+{
+    // Extrapolating the initial guess must not change the solution (beyond
+    // the accuracy of the solver).
+    std::vector<Storage> motions;
+    for (int order = 0; order <= 2; ++order) {
+        const std::string name = "subject01_predictor" + std::to_string(order);
+        InverseKinematicsTool ik("subject01_Setup_InverseKinematics.xml");
+        ik.setName(name);
+        ik.setOutputMotionFileName(name + "_ik.mot");
+        ik.set_predictor_order(order);
+        ik.set_report_solver_statistics(true);
+        ik.run();
+        motions.emplace_back(name + "_ik.mot");
+
+        Storage statistics(ik.getResultsDir() + "/" + name +
+                           "_ik_solver_statistics.sto");
+        ASSERT(statistics.getSize() == motions.back().getSize(), __FILE__,
+                __LINE__, "Expected solver statistics for every frame.");
+        Array<double> numIterations;
+        statistics.getDataColumn("num_iterations", numIterations);
+        double total = 0;
+        for (int i = 0; i < numIterations.getSize(); ++i)
+            total += numIterations[i];
+        cout << "Predictor order " << order << ": "
+             << total / numIterations.getSize() << " iterations per frame."
+             << endl;
+    }
+    for (int order = 1; order <= 2; ++order) {
+        CHECK_STORAGE_AGAINST_STANDARD(motions[order], motions[0],
+                std::vector<double>(
+                        motions[0].getColumnLabels().getSize(), 1e-2),
+                __FILE__, __LINE__,
+                "IK with a predictor differs from IK without one.");
+    }
+    cout << "testInverseKinematicsToolWithPredictor passed" << endl;
+}
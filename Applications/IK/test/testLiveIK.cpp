@@ -34,6 +34,8 @@
 #include <OpenSim/Tools/InverseKinematicsTool.h>
 #include <OpenSim/Tools/IKTaskSet.h>
 #include <OpenSim/Auxiliary/auxiliaryTestFunctions.h>
+#include <algorithm>
+#include <chrono>
 #include <thread> 
 
 using namespace OpenSim;
@@ -91,6 +93,11 @@ void compareMotionTables(
 void producer(std::shared_ptr<BufferedOrientationsReference> oRef,
         TimeSeriesTable_<SimTK::Rotation>& dataSource); 
 
+// Stream orientations to the solver in real time from another thread, and
+// report percentiles of the latency from putting each frame's values to the
+// completion of the track() call that solves the frame.
+void benchmarkStreamingLatency(int queueCapacity);
+
 int main() {
 
     try {
@@ -153,6 +160,11 @@ int main() {
         const TimeSeriesTable standard("std_subject01_walk1_ik.mot");
         compareMotionTables(report, standard);
         thread1.detach();
+
+        // Default queue, guarded by a mutex.
+        benchmarkStreamingLatency(0);
+        // Lock-free ring buffer.
+        benchmarkStreamingLatency(64);
     } 
     catch (const std::exception& e) { 
         cout << e.what() << endl; 
@@ -350,3 +362,77 @@ void producer(std::shared_ptr<BufferedOrientationsReference> oRef,
         oRef->putValues(t, dataSource.getNearestRow(t));
     }
 }
+
+void benchmarkStreamingLatency(int queueCapacity) {
+    using Clock = std::chrono::steady_clock;
+
+    Model model("subject01_simbody.osim");
+    TimeSeriesTable_<SimTK::Rotation> orientationsData =
+            convertMotionFileToRotations(model, "std_subject01_walk1_ik.mot");
+    TimeSeriesTable_<SimTK::Rotation> initialData{orientationsData};
+    initialData.trim(0.4, 0.41);
+    orientationsData.trimFrom(0.41);
+    std::shared_ptr<BufferedOrientationsReference> oRefs(
+            new BufferedOrientationsReference(initialData));
+    oRefs->set_default_weight(1.0);
+    oRefs->setQueueCapacity(queueCapacity);
+
+    TableReporter* ikReporter = new TableReporter();
+    ikReporter->setName("ik_reporter");
+    for (const auto& coord : model.getComponentList<Coordinate>()) {
+        ikReporter->updInput("inputs").connect(
+                coord.getOutput("value"), coord.getName());
+    }
+    model.addComponent(ikReporter);
+    SimTK::State& s0 = model.initSystem();
+
+    SimTK::Array_<CoordinateReference> coordinateRefs;
+    InverseKinematicsSolver ikSolver(model, nullptr, oRefs, coordinateRefs);
+    ikSolver.setAccuracy(1e-4);
+    s0.updTime() = oRefs->getValidTimeRange()[0];
+    ikSolver.assemble(s0);
+    model.realizeReport(s0);
+    ikSolver.setAdvanceTimeFromReference(true);
+
+    // Put the frames at the rate at which they were recorded.
+    const auto& times = orientationsData.getIndependentColumn();
+    const int nt = (int)times.size();
+    std::vector<Clock::time_point> putTimes(nt);
+    thread sensor([&]() {
+        const Clock::time_point start = Clock::now();
+        for (int i = 0; i < nt; ++i) {
+            std::this_thread::sleep_until(start +
+                    std::chrono::duration_cast<Clock::duration>(
+                            std::chrono::duration<double>(
+                                    times[i] - times[0])));
+            putTimes[i] = Clock::now();
+            oRefs->putValues(times[i], orientationsData.getRowAtIndex(i));
+        }
+    });
+
+    std::vector<double> latencies(nt);
+    for (int i = 0; i < nt; ++i) {
+        ikSolver.track(s0); // This call advances time in s0
+        // The values were put before they were taken off the queue.
+        latencies[i] = std::chrono::duration<double, std::milli>(
+                Clock::now() - putTimes[i]).count();
+        model.realizeReport(s0);
+    }
+    sensor.join();
+
+    std::sort(latencies.begin(), latencies.end());
+    auto percentile = [&](double p) {
+        return latencies[std::min(nt - 1, (int)(p / 100 * nt))];
+    };
+    cout << "Latency from putValues() to track() completion with the "
+         << (queueCapacity ? "lock-free ring buffer (capacity " +
+                        std::to_string(queueCapacity) + ")"
+                           : std::string("default queue"))
+         << " over " << nt << " frames: median " << percentile(50)
+         << " ms, 90th percentile " << percentile(90)
+         << " ms, 99th percentile " << percentile(99) << " ms, max "
+         << latencies.back() << " ms." << endl;
+
+    const TimeSeriesTable standard("std_subject01_walk1_ik.mot");
+    compareMotionTables(ikReporter->getTable(), standard);
+}
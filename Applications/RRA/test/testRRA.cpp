@@ -34,6 +34,9 @@ void checkAdjustedModelCOM(string modelFile, string body,
                 const SimTK::Vec3 &standardCOM, 
                 const Array<double> &tolerances);
 
+// Read the average residuals (FX, FY, FZ, MX, MY, MZ) written by RRATool.
+SimTK::Vec6 readAverageResiduals(const string& fileName);
+
 int main() {
     try {
         RRATool rra("subject01_Setup_RRA.xml");
@@ -50,6 +53,50 @@ int main() {
         else{
             throw(Exception("testRRA FAILED to run to completion."));
         }
+
+        // A second pass moves the torso COM again, to reduce the residuals
+        // of the first, and tracks the same kinematics.
+        RRATool rra2("subject01_Setup_RRA.xml");
+        rra2.setNumberOfPasses(2);
+        rra2.setResultsDir("ResultsRRA_TwoPasses");
+        rra2.setOutputModelFileName("subject01_RRA_adjusted_two_passes.osim");
+        if (!rra2.run())
+            throw(Exception("testRRA FAILED to run two passes to completion."));
+        checkAdjustedModelCOM("subject01_RRA_adjusted_two_passes.osim", "torso",
+                  SimTK::Vec3(0.00598028440188985017, 0.34551, 0.1),
+                  Array<double>(0.02, 3) );
+
+        // The second pass starts from the model adjusted by the first, so the
+        // COM moves again and the residuals do not grow.
+        const SimTK::Vec3 onePassCOM = Model("subject01_RRA_adjusted.osim")
+                .getBodySet().get("torso").getMassCenter();
+        const SimTK::Vec3 twoPassCOM =
+                Model("subject01_RRA_adjusted_two_passes.osim")
+                        .getBodySet().get("torso").getMassCenter();
+        cout << "COM moved by the second pass: " << twoPassCOM - onePassCOM
+             << endl;
+        ASSERT((twoPassCOM - onePassCOM).norm() > 1e-6, __FILE__, __LINE__,
+                "testRRA: the second pass did not move the COM.");
+
+        const SimTK::Vec6 onePass =
+                readAverageResiduals("ResultsRRA/subject01_walk1_RRA_avgResiduals.txt");
+        const SimTK::Vec6 twoPasses = readAverageResiduals(
+                "ResultsRRA_TwoPasses/subject01_walk1_RRA_avgResiduals.txt");
+        cout << "Average residuals after one pass:   " << onePass << endl;
+        cout << "Average residuals after two passes: " << twoPasses << endl;
+        ASSERT(twoPasses.getSubVec<3>(0).norm() <=
+                        1.01 * onePass.getSubVec<3>(0).norm(),
+                __FILE__, __LINE__,
+                "testRRA: residual forces grew in the second pass.");
+        ASSERT(twoPasses.getSubVec<3>(3).norm() <=
+                        1.01 * onePass.getSubVec<3>(3).norm(),
+                __FILE__, __LINE__,
+                "testRRA: residual moments grew in the second pass.");
+        Storage result2("ResultsRRA_TwoPasses/subject01_walk1_RRA_Kinematics_q.sto"),
+                standard2("subject01_walk1_RRA_Kinematics_q_standard.sto");
+        CHECK_STORAGE_AGAINST_STANDARD(result2, standard2,
+            std::vector<double>(24, 0.5),
+            __FILE__, __LINE__, "testRRA: two-pass kinematics comparison failed");
     }
     catch (const Exception& e) {
         e.print(cerr);
@@ -82,3 +129,23 @@ void checkAdjustedModelCOM(string resultsFile, string body,
     OPENSIM_THROW_IF(exfList.begin() != exfList.end(), Exception,
         "RRA adjusted model still contains ExternalForce(s).");
 }
+
+SimTK::Vec6 readAverageResiduals(const string& fileName)
+{
+    ifstream file(fileName);
+    OPENSIM_THROW_IF(!file.good(), Exception,
+        "Could not open average residuals file '" + fileName + "'.");
+    const std::vector<std::string> names{"FX", "FY", "FZ", "MX", "MY", "MZ"};
+    SimTK::Vec6 residuals(SimTK::NaN);
+    string line;
+    while (getline(file, line)) {
+        for (int i = 0; i < 6; ++i) {
+            const string prefix = names[i] + " average = ";
+            if (line.compare(0, prefix.size(), prefix) == 0)
+                residuals[i] = stod(line.substr(prefix.size()));
+        }
+    }
+    OPENSIM_THROW_IF(residuals.isNaN(), Exception,
+        "Average residuals file '" + fileName + "' is incomplete.");
+    return residuals;
+}
@@ -44,6 +44,7 @@
 #include <OpenSim/Tools/IMUInverseKinematicsTool.h>
 
 #include <ctime>  // clock(), clock_t, CLOCKS_PER_SEC
+#include <fstream>
 
 using namespace std;
 using namespace OpenSim;
@@ -57,6 +58,9 @@ TimeSeriesTable_<SimTK::Quaternion> readRotationsFromXSensFiles(const std::strin
 TimeSeriesTable_<SimTK::Quaternion> readRotationsFromAPDMFile(const std::string& file,
     const std::string& readerSetupFile);
 
+void streamInverseKinematics(const std::string& settingsFile,
+    const std::string& sourceFile, const std::string& outputFile);
+
 static void PrintUsage(const char *aProgName, ostream &aOStream);
 //______________________________________________________________________________
 /**
@@ -186,6 +190,44 @@ int main(int argc, char **argv)
                     setupFileName = argv[i + 1];
                     break;
                 }
+                else if ((option == "-StreamInverseKinematics") ||
+                         (option == "-SIK")) {
+                    if (argc < 5) {
+                        log_error("An inverse kinematics settings (.xml) "
+                                  "file, a source of orientations and an "
+                                  "output file are necessary to run IK on "
+                                  "streamed orientations.");
+                        PrintUsage(argv[0], cout);
+                        exit(-1);
+                    }
+                    std::string settingsFile{ argv[i + 1] };
+                    std::string sourceFile{ argv[i + 2] };
+                    std::string outputFile{ argv[i + 3] };
+                    streamInverseKinematics(
+                            settingsFile, sourceFile, outputFile);
+                    log_info("Done.");
+                    return 0;
+                }
+                else if ((option == "-Replay") || (option == "-R")) {
+                    if (argc < 4) {
+                        log_error("An orientations (.sto) file and a "
+                                  "destination (e.g., a named pipe) are "
+                                  "necessary to replay orientations.");
+                        PrintUsage(argv[0], cout);
+                        exit(-1);
+                    }
+                    TimeSeriesTable_<SimTK::Quaternion> orientations{
+                            argv[i + 1] };
+                    std::ofstream destination(argv[i + 2]);
+                    OPENSIM_THROW_IF(!destination, Exception,
+                            "Could not open '{}' for writing.", argv[i + 2]);
+                    log_info("Replaying {} rows of '{}' at their recorded "
+                             "rate.", orientations.getNumRows(), argv[i + 1]);
+                    IMUInverseKinematicsTool::writeOrientationsToStream(
+                            orientations, destination);
+                    log_info("Done.");
+                    return 0;
+                }
                 else if ((option == "-PrintSetup") || (option == "-PS")) {
                     IMUInverseKinematicsTool *imuIKTool = new IMUInverseKinematicsTool();
                     imuIKTool->setName("new");
@@ -287,6 +329,14 @@ void PrintUsage(const char *aProgName, ostream &aOStream)
     aOStream << "                                          The resultant model with IMU frames registered is written to file if output_model_file is specified\n";
     aOStream << "                                          in IMUPlacer_setup.xml. Additional options can be specified in IMUPlacer_setup.xml to perform heading correction.\n";
     aOStream << "-InverseKinematics, -IK ik_settings.xml   Run IK using an xml settings file to define the inverse kinematics problem.\n";
+    aOStream << "-StreamInverseKinematics, -SIK ik_settings.xml source output.sto\n";
+    aOStream << "                                          Run IK on orientations as they arrive from source (a named pipe, or a file\n";
+    aOStream << "                                          that is still being written) in the format of an orientations .sto file.\n";
+    aOStream << "                                          Each frame's joint angles, solve time and queue depth are written to\n";
+    aOStream << "                                          output.sto as soon as the frame is solved. If the solver falls behind,\n";
+    aOStream << "                                          it skips to the newest orientations. Stops 1 s after the source ends.\n";
+    aOStream << "-Replay, -R orientations.sto destination  Write orientations (e.g., from -ReadXsens or -ReadAPDM) to destination\n";
+    aOStream << "                                          (e.g., a named pipe) at the rate at which they were recorded.\n";
     aOStream << endl;
 /** Advanced options for experimental validation. Uncomment if/when ready to make public
     aOStream << "-Transform, -T markerFileWithIMUframes.trc  Transform experimental marker locations that define axes of IMUs, or the plates\n";
@@ -307,6 +357,52 @@ void PrintUsage(const char *aProgName, ostream &aOStream)
 **/
 }
 
+void streamInverseKinematics(const std::string& settingsFile,
+    const std::string& sourceFile, const std::string& outputFile)
+{
+    IMUInverseKinematicsTool ik(settingsFile);
+    Model model(ik.get_model_file());
+
+    auto source = std::make_shared<std::ifstream>(sourceFile);
+    OPENSIM_THROW_IF(!*source, Exception, "Could not open '{}'.", sourceFile);
+    std::ofstream output(outputFile);
+    OPENSIM_THROW_IF(!output, Exception,
+            "Could not open '{}' for writing.", outputFile);
+
+    // Rotational coordinates are written in degrees.
+    output << "name=" << ik.getName() << "\ninDegrees=yes\nendheader\ntime";
+    for (const auto& coord : model.getComponentList<Coordinate>()) {
+        output << "\t" << coord.getName();
+    }
+    output << "\tsolve_time\tqueue_depth" << std::endl;
+    // Found once the tool has initialized the model.
+    std::vector<const Coordinate*> coordinates;
+
+    const double idleTimeout = 1.0;
+    ik.runInverseKinematicsWithOrientationsFromStream(model, source,
+            [&](const State& s,
+                    const IMUInverseKinematicsTool::StreamingFrame& frame) {
+                if (coordinates.empty()) {
+                    for (const auto& coord :
+                            model.getComponentList<Coordinate>()) {
+                        coordinates.push_back(&coord);
+                    }
+                }
+                output << frame.time;
+                for (const auto* coord : coordinates) {
+                    double value = coord->getValue(s);
+                    if (coord->getMotionType() == Coordinate::Rotational) {
+                        value = convertRadiansToDegrees(value);
+                    }
+                    output << "\t" << value;
+                }
+                output << "\t" << frame.solveTime << "\t" << frame.queueDepth
+                       << std::endl;
+            },
+            1, idleTimeout);
+    log_info("Wrote IK with streamed IMU orientations to: '{}'.", outputFile);
+}
+
 TimeSeriesTable_<SimTK::Quaternion> readRotationsFromXSensFiles(const std::string& directory,
                                                     const std::string& readerSetupFile)
 {
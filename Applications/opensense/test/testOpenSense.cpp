@@ -30,9 +30,18 @@
 #include <OpenSim/Tools/IMUInverseKinematicsTool.h>
 #include <OpenSim/Auxiliary/auxiliaryTestFunctions.h>
 
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <sstream>
+#include <thread>
+
 using namespace OpenSim;
 using namespace std;
 
+void testStreamingInverseKinematics(const Model& calibratedModel);
 
 int main()
 {
@@ -75,6 +84,8 @@ int main()
     ik_hjc.set_results_directory("ik_hjc_" + facingNegX.getName());
     ik_hjc.run(false);
 
+    testStreamingInverseKinematics(facingX);
+
     Storage ik_X("ik_hjc_" + facingX.getName() + 
         "/ik_MT_012005D6_009-quaternions_RHJCSwinger.mot");
 
@@ -117,3 +128,149 @@ int main()
     std::cout << "Done. All testOpensense cases passed." << endl;
     return 0;
 }
+
+namespace {
+// A stream of the given text that records when its reader has reached the
+// end of the text.
+class StringStreamWithEndFlag : public std::istream {
+public:
+    explicit StringStreamWithEndFlag(const std::string& text)
+            : std::istream(nullptr), _buffer(text, _reachedEnd) {
+        rdbuf(&_buffer);
+    }
+    bool reachedEnd() const { return _reachedEnd; }
+private:
+    class Buffer : public std::stringbuf {
+    public:
+        Buffer(const std::string& text, std::atomic<bool>& reachedEnd)
+                : std::stringbuf(text, std::ios::in),
+                  _reachedEnd(reachedEnd) {}
+    protected:
+        int_type underflow() override {
+            const int_type c = std::stringbuf::underflow();
+            if (traits_type::eq_int_type(c, traits_type::eof())) {
+                _reachedEnd = true;
+            }
+            return c;
+        }
+    private:
+        std::atomic<bool>& _reachedEnd;
+    };
+    std::atomic<bool> _reachedEnd{false};
+    Buffer _buffer;
+};
+} // anonymous namespace
+
+// Replay a recording at its recorded rate into a file that the tool follows
+// as it is written, and compare with solving the rows from the file.
+void testStreamingInverseKinematics(const Model& calibratedModel) {
+    IMUInverseKinematicsTool ik("setup_IMUInverseKinematics_HJC_trial.xml");
+    ik.setStartTime(417);
+    ik.setEndTime(418);
+    ik.set_results_directory("ik_hjc_stream");
+    Model fileModel(calibratedModel);
+    ik.setModel(fileModel);
+    ik.run(false);
+    TimeSeriesTable fromFile(
+            "ik_hjc_stream/ik_MT_012005D6_009-quaternions_RHJCSwinger.mot");
+
+    TimeSeriesTable_<SimTK::Quaternion> recording(ik.get_orientations_file());
+    recording.trim(416.95, 418.05);
+    int numRowsInRange = 0;
+    for (double time : recording.getIndependentColumn()) {
+        if (time >= ik.getStartTime() && time <= ik.getEndTime()) {
+            ++numRowsInRange;
+        }
+    }
+
+    // Solve the rows of `source`, calling `onFirstFrame` before the first
+    // frame is recorded (the reader is running by then).
+    auto solveStream = [&](std::shared_ptr<std::istream> source,
+                               int maxQueueDepth, TimeSeriesTable& solved,
+                               const std::function<void()>& onFirstFrame) {
+        Model model(calibratedModel);
+        std::vector<std::string> labels;
+        for (const auto& coord : model.getComponentList<Coordinate>()) {
+            labels.push_back(coord.getName());
+        }
+        solved.setColumnLabels(labels);
+        int numDropped = 0;
+        const int numSolved =
+                ik.runInverseKinematicsWithOrientationsFromStream(model,
+                        source,
+                        [&](const SimTK::State& s,
+                                const IMUInverseKinematicsTool::StreamingFrame&
+                                        frame) {
+                            if (frame.index == 0 && onFirstFrame) {
+                                onFirstFrame();
+                            }
+                            ASSERT(frame.index == (int)solved.getNumRows());
+                            ASSERT(frame.solveTime >= 0);
+                            ASSERT(frame.queueDepth >= 1);
+                            SimTK::RowVector row((int)labels.size());
+                            int i = 0;
+                            for (const auto& coord :
+                                    model.getComponentList<Coordinate>()) {
+                                row[i++] = coord.getMotionType() ==
+                                                           Coordinate::Rotational
+                                                   ? SimTK::convertRadiansToDegrees(
+                                                             coord.getValue(s))
+                                                   : coord.getValue(s);
+                            }
+                            solved.appendRow(frame.time, row);
+                            numDropped = frame.numDropped;
+                        },
+                        maxQueueDepth, 0.5);
+        ASSERT(numSolved == (int)solved.getNumRows());
+        ASSERT(numSolved + numDropped == numRowsInRange);
+        return numDropped;
+    };
+
+    // Without dropping rows, the solution of the recording replayed at its
+    // recorded rate is the same as from the file.
+    TimeSeriesTable streamed;
+    {
+        const std::string streamFile = "stream_orientations.sto";
+        std::ofstream sink(streamFile);
+        auto source = std::make_shared<std::ifstream>(streamFile);
+        std::thread player([&]() {
+            IMUInverseKinematicsTool::writeOrientationsToStream(
+                    recording, sink);
+        });
+        const int numDropped = solveStream(source, 0, streamed, nullptr);
+        player.join();
+        ASSERT(numDropped == 0);
+    }
+    ASSERT(streamed.getNumRows() == fromFile.getNumRows());
+    for (size_t i = 0; i < streamed.getNumRows(); ++i) {
+        ASSERT_EQUAL(fromFile.getIndependentColumn()[i],
+                streamed.getIndependentColumn()[i], 1e-9);
+        for (const auto& label : streamed.getColumnLabels()) {
+            ASSERT_EQUAL(fromFile.getDependentColumn(label)[i],
+                    streamed.getDependentColumn(label)[i], 1e-2);
+        }
+    }
+
+    // Dropping rows when the solver falls behind; the frames that are solved
+    // are in order. The first frame is not recorded until the reader has
+    // queued every row, so the solver is behind by all of them. Only the rows
+    // in the time range are streamed so that the reader reads to the end.
+    TimeSeriesTable coalesced;
+    TimeSeriesTable_<SimTK::Quaternion> inRange(recording);
+    inRange.trim(ik.getStartTime(), ik.getEndTime());
+    std::ostringstream text;
+    IMUInverseKinematicsTool::writeOrientationsToStream(inRange, text, false);
+    auto source = std::make_shared<StringStreamWithEndFlag>(text.str());
+    const int numDropped = solveStream(source, 1, coalesced, [&]() {
+        while (!source->reachedEnd()) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    });
+    cout << "Streaming IK dropped " << numDropped << " of " << numRowsInRange
+         << " rows." << endl;
+    ASSERT(numDropped > 0);
+    const auto& solvedTimes = coalesced.getIndependentColumn();
+    for (size_t i = 1; i < solvedTimes.size(); ++i) {
+        ASSERT(solvedTimes[i] > solvedTimes[i - 1]);
+    }
+}
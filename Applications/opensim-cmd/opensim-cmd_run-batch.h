@@ -0,0 +1,102 @@
+#ifndef OPENSIM_CMD_RUN_BATCH_H_
+#define OPENSIM_CMD_RUN_BATCH_H_
+/* -------------------------------------------------------------------------- *
+ *                      OpenSim:  opensim-cmd_run-batch.h                     *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2021 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include <iostream>
+#include <sstream>
+
+#include <docopt.h>
+#include "parse_arguments.h"
+
+static const char HELP_RUN_BATCH[] =
+R"(Run the IK, ID, and Analyze setup files of many trials concurrently.
+
+Usage:
+  opensim-cmd [options]... run-batch [--threads=<n>] [--model=<model-file>] <trial>...
+  opensim-cmd run-batch -h | --help
+
+Options:
+  -L <path>, --library <path>  Load a plugin.
+  -o <level>, --log <level>  Logging level.
+  -j <n>, --threads <n>  Number of trials to run at once.
+  -m <model-file>, --model <model-file>  Use this model for every trial.
+
+Description:
+  Each <trial> is a setup file, or a comma-separated list of setup files
+  that are run in order (e.g., IK,ID), each after the previous one has
+  finished. Trials run concurrently. Supported tools are:
+
+            Inverse Kinematics           (IK)
+            Inverse Dynamics             (ID)
+            Analyze (e.g., StaticOptimization)
+
+  Each model file is loaded once and copied for each setup file, instead
+  of being loaded by every tool. By default, all hardware threads are used.
+  Trials whose setup files are in different directories do not run at the
+  same time. A summary of the time taken by each tool is printed at the end.
+
+Examples:
+  opensim-cmd run-batch walk1_IK.xml walk2_IK.xml walk3_IK.xml
+  opensim-cmd run-batch -j 4 walk1_IK.xml,walk1_ID.xml walk2_IK.xml,walk2_ID.xml
+  opensim-cmd run-batch --model=subject01_scaled.osim walk1_IK.xml walk2_IK.xml
+)";
+
+int run_batch(int argc, const char** argv) {
+
+    using namespace OpenSim;
+
+    std::map<std::string, docopt::value> args = OpenSim::parse_arguments(
+            HELP_RUN_BATCH, { argv + 1, argv + argc },
+            true); // show help if requested
+
+    std::unique_ptr<BatchToolRunner> runner;
+    if (args["--model"]) {
+        Model model(args["--model"].asString());
+        runner.reset(new BatchToolRunner(model));
+    } else {
+        runner.reset(new BatchToolRunner());
+    }
+
+    if (args["--threads"]) {
+        runner->setNumThreads(std::stoi(args["--threads"].asString()));
+    }
+
+    for (const auto& trial : args["<trial>"].asStringList()) {
+        std::vector<std::string> setupFiles;
+        std::stringstream ss(trial);
+        std::string setupFile;
+        while (std::getline(ss, setupFile, ',')) {
+            if (!setupFile.empty()) setupFiles.push_back(setupFile);
+        }
+        runner->addTrial(setupFiles);
+    }
+
+    const auto results = runner->run();
+    BatchToolRunner::printSummary(results);
+    for (const auto& result : results) {
+        if (!result.success) return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
+
+#endif // OPENSIM_CMD_RUN_BATCH_H_
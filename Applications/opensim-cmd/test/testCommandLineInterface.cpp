@@ -349,6 +349,51 @@ void testRunTool() {
     testLoadPluginLibraries("run-tool");
 }
 
+void testRunBatch() {
+    // Help.
+    // =====
+    {
+        StartsWith output("Run the IK, ID, and Analyze setup files ");
+        testCommand("run-batch -h", EXIT_SUCCESS, output);
+        testCommand("run-batch -help", EXIT_SUCCESS, output);
+    }
+
+    // Error messages.
+    // ===============
+    testCommand("run-batch", EXIT_FAILURE,
+            ContainsSubstring("Arguments did not match expected patterns"));
+    testCommand("run-batch --threads=-1 putes.xml", EXIT_FAILURE,
+            ContainsSubstring("Expected the number of threads to be "
+                              "non-negative, but got -1."));
+    // A failed step does not stop the other trials, but the later steps of
+    // its trial are skipped.
+    testCommand("print-xml ik testrunbatch_ik_setup.xml", EXIT_SUCCESS,
+            ContainsSubstring("Printing 'testrunbatch_ik_setup.xml'.\n"));
+    testCommand("print-xml id testrunbatch_id_setup.xml", EXIT_SUCCESS,
+            ContainsSubstring("Printing 'testrunbatch_id_setup.xml'.\n"));
+    testCommand("run-batch testrunbatch_ik_setup.xml,testrunbatch_id_setup.xml "
+                "testrunbatch_id_setup.xml", EXIT_FAILURE,
+            std::regex(RE_ANY +
+                    "(trial 0: testrunbatch_ik_setup.xml "
+                    "\\(InverseKinematicsTool\\) failed)" + RE_ANY +
+                    "(No model file was specified)" + RE_ANY +
+                    "(trial 0: testrunbatch_id_setup.xml "
+                    "\\(InverseDynamicsTool\\) failed: Skipped)" + RE_ANY +
+                    "(trial 1: testrunbatch_id_setup.xml "
+                    "\\(InverseDynamicsTool\\) failed)" + RE_ANY));
+    // Only some tools are supported.
+    testCommand("print-xml cmc testrunbatch_cmc_setup.xml", EXIT_SUCCESS,
+            ContainsSubstring("Printing 'testrunbatch_cmc_setup.xml'.\n"));
+    testCommand("run-batch testrunbatch_cmc_setup.xml", EXIT_FAILURE,
+            ContainsSubstring("but only InverseKinematicsTool, "
+                              "InverseDynamicsTool and AnalyzeTool setup "
+                              "files can be run in a batch."));
+
+    // Library option.
+    // ===============
+    testLoadPluginLibraries("run-batch");
+}
+
 void testPrintXML() {
     // Help.
     // =====
@@ -494,6 +539,7 @@ int main() {
     SimTK_START_TEST("testCommandLineInterface");
         SimTK_SUBTEST(testNoCommand);
         SimTK_SUBTEST(testRunTool);
+        SimTK_SUBTEST(testRunBatch);
         SimTK_SUBTEST(testPrintXML);
         SimTK_SUBTEST(testInfo);
         SimTK_SUBTEST(testUpdateFile);
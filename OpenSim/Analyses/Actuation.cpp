@@ -492,6 +492,19 @@ int Actuation::end(const SimTK::State& s)
 
     return(0);
 }
+//_____________________________________________________________________________
+/**
+* Append the results of a copy of this analysis that was performed on later
+* states.
+*/
+void Actuation::
+appendResults(Analysis& aAnalysis)
+{
+    auto& other = dynamic_cast<Actuation&>(aAnalysis);
+    _forceStore->append(*other._forceStore);
+    _speedStore->append(*other._speedStore);
+    _powerStore->append(*other._powerStore);
+}
 
 
 
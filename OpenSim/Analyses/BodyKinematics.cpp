@@ -677,6 +677,19 @@ end(const SimTK::State&s )
 
     return(0);
 }
+//_____________________________________________________________________________
+/**
+ * Append the results of a copy of this analysis that was performed on later
+ * states.
+ */
+void BodyKinematics::
+appendResults(Analysis& aAnalysis)
+{
+    auto& other = dynamic_cast<BodyKinematics&>(aAnalysis);
+    _pStore->append(*other._pStore);
+    _vStore->append(*other._vStore);
+    _aStore->append(*other._aStore);
+}
 
 
 
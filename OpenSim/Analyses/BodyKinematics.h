@@ -122,6 +122,10 @@ public:
         step(const SimTK::State& s, int setNumber ) override;
     int
         end(const SimTK::State& s ) override;
+    bool
+        isFrameIndependent() const override { return true; }
+    void
+        appendResults(Analysis& aAnalysis) override;
 protected:
     virtual int
         record(const SimTK::State& s );
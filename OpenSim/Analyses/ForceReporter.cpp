@@ -365,6 +365,17 @@ int ForceReporter::end(const SimTK::State& s )
 
     return(0);
 }
+//_____________________________________________________________________________
+/**
+ * Append the results of a copy of this analysis that was performed on later
+ * states.
+ */
+void ForceReporter::
+appendResults(Analysis& aAnalysis)
+{
+    auto& other = dynamic_cast<ForceReporter&>(aAnalysis);
+    _forceStore.append(other._forceStore);
+}
 
 
 
@@ -118,6 +118,8 @@ public:
     int begin(const SimTK::State& s ) override;
     int step(const SimTK::State& s, int setNumber ) override;
     int end(const SimTK::State& s ) override;
+    bool isFrameIndependent() const override { return true; }
+    void appendResults(Analysis& aAnalysis) override;
 
 protected:
     virtual int
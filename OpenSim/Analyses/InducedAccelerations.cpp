@@ -27,6 +27,9 @@
 #include <OpenSim/Common/IO.h>
 #include <OpenSim/Simulation/Model/Model.h>
 #include <OpenSim/Simulation/Model/ExternalForce.h>
+#include <OpenSim/Simulation/Model/PathActuator.h>
+#include <OpenSim/Actuators/CoordinateActuator.h>
+#include <OpenSim/Actuators/McKibbenActuator.h>
 #include "InducedAccelerations.h"
 
 using namespace OpenSim;
@@ -68,7 +71,8 @@ InducedAccelerations::InducedAccelerations(Model *aModel) :
     _constraintSet((ConstraintSet&)_constraintSetProp.getValueObj()),
     _forceThreshold(_forceThresholdProp.getValueDbl()),
     _computePotentialsOnly(_computePotentialsOnlyProp.getValueBool()),
-    _reportConstraintReactions(_reportConstraintReactionsProp.getValueBool())
+    _reportConstraintReactions(_reportConstraintReactionsProp.getValueBool()),
+    _batchActuatorContributions(_batchActuatorContributionsProp.getValueBool())
 {
     // make sure members point to NULL if not valid. 
     setNull();
@@ -96,7 +100,8 @@ InducedAccelerations::InducedAccelerations(const std::string &aFileName):
     _constraintSet((ConstraintSet&)_constraintSetProp.getValueObj()),
     _forceThreshold(_forceThresholdProp.getValueDbl()),
     _computePotentialsOnly(_computePotentialsOnlyProp.getValueBool()),
-    _reportConstraintReactions(_reportConstraintReactionsProp.getValueBool())
+    _reportConstraintReactions(_reportConstraintReactionsProp.getValueBool()),
+    _batchActuatorContributions(_batchActuatorContributionsProp.getValueBool())
 {
     setNull();
 
@@ -120,7 +125,8 @@ InducedAccelerations::InducedAccelerations(const InducedAccelerations &aInducedA
     _constraintSet((ConstraintSet&)_constraintSetProp.getValueObj()),
     _forceThreshold(_forceThresholdProp.getValueDbl()),
     _computePotentialsOnly(_computePotentialsOnlyProp.getValueBool()),
-    _reportConstraintReactions(_reportConstraintReactionsProp.getValueBool())
+    _reportConstraintReactions(_reportConstraintReactionsProp.getValueBool()),
+    _batchActuatorContributions(_batchActuatorContributionsProp.getValueBool())
 {
     setNull();
     // COPY TYPE AND NAME
@@ -152,6 +158,7 @@ operator=(const InducedAccelerations &aInducedAccelerations)
     _forceThreshold = aInducedAccelerations._forceThreshold;
     _computePotentialsOnly = aInducedAccelerations._computePotentialsOnly;
     _reportConstraintReactions = aInducedAccelerations._reportConstraintReactions;
+    _batchActuatorContributions = aInducedAccelerations._batchActuatorContributions;
     _includeCOM = aInducedAccelerations._includeCOM;
     return(*this);
 }
@@ -171,6 +178,7 @@ void InducedAccelerations::setNull()
     _bodyNames[0] = CENTER_OF_MASS_NAME;
     _computePotentialsOnly = false;
     _reportConstraintReactions = false;
+    _batchActuatorContributions = true;
     // Analysis does not own contents of these sets
     _coordSet.setMemoryOwner(false);
     _bodySet.setMemoryOwner(false);
@@ -213,6 +221,11 @@ void InducedAccelerations::setupProperties()
     _reportConstraintReactionsProp.setName("report_constraint_reactions");
     _reportConstraintReactionsProp.setComment("Report individual contributions to constraint reactions in addition to accelerations.");
     _propertySet.append(&_reportConstraintReactionsProp);
+
+    _batchActuatorContributionsProp.setName("batch_actuator_contributions");
+    _batchActuatorContributionsProp.setComment("Solve for the contributions of path actuators (including muscles) and coordinate actuators together at each time, "
+        "from their forces, instead of realizing the model once per actuator. Not used when constraint reactions are reported.");
+    _propertySet.append(&_batchActuatorContributionsProp);
 }
 
 //=============================================================================
@@ -459,6 +472,44 @@ void InducedAccelerations::setupStorage()
     _bodySet.setMemoryOwner(false);
 }
 
+//_____________________________________________________________________________
+/**
+ * Determine the actuators whose contributions are solved for together at
+ * each time. These are the path actuators (including muscles) and coordinate
+ * actuators, whose forces are their actuation applied along their path or to
+ * their coordinate, so that they can be applied without realizing the model.
+ */
+void InducedAccelerations::setupBatchedContributors()
+{
+    const Set<Actuator>& actuators = _model->getActuators();
+
+    _batchColumns.setSize(0);
+    _batchActuators.setSize(0);
+    for(int c=0; c<_contributors.getSize(); c++){
+        int ai = -1;
+        if(_batchActuatorContributions && !_reportConstraintReactions &&
+                _contributors[c] != "total" && _contributors[c] != "gravity" &&
+                _contributors[c] != "velocity")
+            ai = actuators.getIndex(_contributors[c]);
+
+        bool batched = false;
+        if(ai >= 0){
+            const Actuator& actuator = actuators.get(ai);
+            // McKibbenActuator does not record its actuation.
+            batched = (dynamic_cast<const PathActuator*>(&actuator) &&
+                       !dynamic_cast<const McKibbenActuator*>(&actuator)) ||
+                      dynamic_cast<const CoordinateActuator*>(&actuator);
+        }
+
+        if(batched){
+            _batchColumns.append(_batchActuators.getSize());
+            _batchActuators.append(ai);
+        }
+        else
+            _batchColumns.append(-1);
+    }
+}
+
 
 //=============================================================================
 // GET AND SET
@@ -539,9 +590,21 @@ int InducedAccelerations::record(const SimTK::State& s)
     //Use same conditions on constraints
     s_analysis.setTime(aT);
 
+    // Accelerations of the actuators that are solved for together, and the
+    // state (with zero speeds) they are solved at
+    SimTK::Matrix batchUDots;
+    SimTK::State s_batch;
+
     // Cycle through the force contributors to the system acceleration
     for(int c=0; c< _contributors.getSize(); c++){          
         //cout << "Solving for contributor: " << _contributors[c] << endl;
+        if(_batchColumns[c] >= 0){
+            if(batchUDots.ncol() == 0)
+                solveForBatchedContributions(s, s_analysis, s_batch, batchUDots);
+            appendInducedAccelerations(s_batch, batchUDots(_batchColumns[c]));
+            continue;
+        }
+
         // Need to be at the dynamics stage to disable a force
         _model->getMultibodySystem().realize(s_analysis, SimTK::Stage::Dynamics);
         
@@ -787,6 +850,189 @@ int InducedAccelerations::record(const SimTK::State& s)
     return(0);
 }
 
+//_____________________________________________________________________________
+/**
+ * Solve for the induced accelerations of all the actuators that are solved
+ * for together, as the original approach of realizing the model with only
+ * that actuator (and the forces that are not actuators) applied, at zero
+ * speeds, would compute them.
+ *
+ * The model is realized to Dynamics once with all actuators applying their
+ * forces, to get their actuations, and once without them, to get the forces
+ * that are applied for every actuator. The unconstrained accelerations of
+ * each actuator's forces are obtained with the articulated body inertias of
+ * the state, an O(n) operation per actuator. The constraint compliance matrix
+ * W = G*M^-1*~G of the active constraints is formed and factored once, and the
+ * multipliers of all actuators are solved for at once.
+ *
+ * @param s State being analyzed.
+ * @param s_analysis State of the analysis model, with the constraints
+ * enforced as they are for this time.
+ * @param s_batch State at which the accelerations were solved for (zero
+ * speeds), realized to Dynamics.
+ * @param udots Generalized accelerations, one column per actuator.
+ */
+void InducedAccelerations::solveForBatchedContributions(const SimTK::State& s,
+        const SimTK::State& s_analysis, SimTK::State& s_batch,
+        SimTK::Matrix& udots)
+{
+    const SimTK::MultibodySystem& system = _model->getMultibodySystem();
+    const SimTK::SimbodyMatterSubsystem& matter = _model->getMatterSubsystem();
+    Set<Actuator>& actuators = _model->updActuators();
+    int nu = _model->getNumSpeeds();
+    int na = _batchActuators.getSize();
+
+    // State with gravity and the actuators off, and zero speeds
+    SimTK::State s_other = s_analysis;
+    system.realize(s_other, SimTK::Stage::Dynamics);
+    _model->updForceSubsystem().setForceIsDisabled(s_other, _model->getGravityForce().getForceIndex(), true);
+    for(int f=0; f<actuators.getSize(); f++){
+        actuators.get(f).setAppliesForce(s_other, false);
+    }
+    s_other.setQ(s.getQ());
+    s_other.setU(SimTK::Vector(nu,0.0));
+    s_other.setZ(s.getZ());
+
+    // Same state with all actuators on
+    s_batch = s_other;
+    for(int f=0; f<actuators.getSize(); f++){
+        Actuator& actuator = actuators.get(f);
+        actuator.setAppliesForce(s_batch, true);
+        ScalarActuator* act = dynamic_cast<ScalarActuator*>(&actuator);
+        if(!act) continue;
+        act->overrideActuation(s_batch, false);
+        if(_computePotentialsOnly && dynamic_cast<Muscle*>(act)){
+            act->overrideActuation(s_batch, true);
+            act->setOverrideActuation(s_batch, 1.0);
+        }
+    }
+
+    // Forces that are not actuators are applied for every actuator
+    system.realize(s_other, SimTK::Stage::Dynamics);
+    const SimTK::Vector_<SimTK::SpatialVec>& otherBodyForces =
+            system.getRigidBodyForces(s_other, SimTK::Stage::Dynamics);
+    const SimTK::Vector& otherMobilityForces =
+            system.getMobilityForces(s_other, SimTK::Stage::Dynamics);
+
+    system.realize(s_batch, SimTK::Stage::Dynamics);
+    matter.realizeArticulatedBodyInertias(s_batch);
+
+    // Unconstrained accelerations of each actuator's forces
+    udots.resize(nu, na);
+    SimTK::Vector_<SimTK::SpatialVec> bodyForces, A_GB;
+    SimTK::Vector mobilityForces, udot;
+    for(int j=0; j<na; j++){
+        const ScalarActuator& act = dynamic_cast<const ScalarActuator&>(
+                actuators.get(_batchActuators[j]));
+        bodyForces = otherBodyForces;
+        mobilityForces = otherMobilityForces;
+        double force = act.getActuation(s_batch);
+        const PathActuator* pathAct = dynamic_cast<const PathActuator*>(&act);
+        if(pathAct){
+            pathAct->getGeometryPath().addInEquivalentForces(
+                    s_batch, force, bodyForces, mobilityForces);
+        }
+        else{
+            const Coordinate* coord =
+                    dynamic_cast<const CoordinateActuator&>(act).getCoordinate();
+            matter.addInMobilityForce(s_batch, coord->getBodyIndex(),
+                    SimTK::MobilizerUIndex(coord->getMobilizerQIndex()),
+                    force, mobilityForces);
+        }
+        matter.calcAccelerationIgnoringConstraints(s_batch, mobilityForces,
+                bodyForces, udot, A_GB);
+        udots(j) = udot;
+    }
+
+    // Enforce the active constraints: W*lambda = G*udot + b, where b is the
+    // bias of the acceleration constraint errors G*udot + b (Simbody's sign
+    // convention), and udot -= M^-1*~G*lambda, for all actuators at once
+    SimTK::Vector bias;
+    matter.calcBiasForAccelerationConstraints(s_batch, bias);
+    int m = bias.size();
+    if(m == 0) return;
+
+    SimTK::Matrix W;
+    matter.calcProjectedMInv(s_batch, W);
+    SimTK::FactorQTZ qtz(W);
+
+    SimTK::Vector biasG, Gudot;
+    matter.calcBiasForMultiplyByG(s_batch, biasG);
+    SimTK::Matrix aerr(m, na);
+    for(int j=0; j<na; j++){
+        matter.multiplyByG(s_batch, udots(j), biasG, Gudot);
+        aerr(j) = Gudot + bias;
+    }
+
+    SimTK::Matrix lambda;
+    qtz.solve(aerr, lambda);
+
+    SimTK::Vector constraintForces, du;
+    for(int j=0; j<na; j++){
+        matter.multiplyByGTranspose(s_batch, lambda(j), constraintForces);
+        matter.multiplyByMInv(s_batch, constraintForces, du);
+        udots(j) -= du;
+    }
+}
+
+//_____________________________________________________________________________
+/**
+ * Append the accelerations of the coordinates, bodies and center of mass
+ * that result from the given generalized accelerations at a state with zero
+ * speeds, as the contribution of the next contributor.
+ */
+void InducedAccelerations::appendInducedAccelerations(
+        const SimTK::State& s_batch, const SimTK::Vector& udot)
+{
+    const SimTK::SimbodyMatterSubsystem& matter = _model->getMatterSubsystem();
+
+    // Body accelerations; there are no velocity-dependent terms
+    SimTK::Vector_<SimTK::SpatialVec> A_GB;
+    matter.calcBodyAccelerationFromUDot(s_batch, udot, A_GB);
+
+    for(int i=0;i<_coordSet.getSize();i++) {
+        const Coordinate& coord = _coordSet.get(i);
+        double acc = matter.getMobilizedBody(coord.getBodyIndex())
+                .getOneFromUPartition(s_batch, coord.getMobilizerQIndex(), udot);
+
+        if(getInDegrees()) 
+            acc *= SimTK_RADIAN_TO_DEGREE;  
+        _coordIndAccs[i]->append(1, &acc);
+    }
+
+    for(int i=0;i<_bodySet.getSize();i++) {
+        const Body& body = _bodySet.get(i);
+        const SimTK::SpatialVec& A = A_GB[body.getMobilizedBodyIndex()];
+        const SimTK::Vec3 com = body.getMobilizedBody().getBodyRotation(s_batch)
+                * body.get_mass_center();
+
+        SimTK::Vec3 vec = A[1] + A[0] % com;
+        SimTK::Vec3 angVec = A[0];
+
+        if(getInDegrees()) 
+            angVec *= SimTK_RADIAN_TO_DEGREE;   
+
+        _bodyIndAccs[i]->append(3, &vec[0]);
+        _bodyIndAccs[i]->append(3, &angVec[0]);
+    }
+
+    if(_includeCOM){
+        SimTK::Vec3 vec(0);
+        double mass = 0;
+        for(SimTK::MobilizedBodyIndex mbx(1); mbx < matter.getNumBodies(); ++mbx){
+            const SimTK::MobilizedBody& mobod = matter.getMobilizedBody(mbx);
+            const double m = mobod.getBodyMass(s_batch);
+            const SimTK::Vec3 com = mobod.getBodyRotation(s_batch)
+                    * mobod.getBodyMassCenterStation(s_batch);
+            vec += m * (A_GB[mbx][1] + A_GB[mbx][0] % com);
+            mass += m;
+        }
+        vec /= mass;
+
+        _comIndAccs.append(3, &vec[0]);
+    }
+}
+
 /**
  * This method is called at the beginning of an analysis so that any
  * necessary initializations may be performed.
@@ -827,6 +1073,7 @@ void InducedAccelerations::initialize(const SimTK::State& s)
     // UPDATE VARIABLES IN THIS CLASS
     constructDescription();
     setupStorage();
+    setupBatchedContributors();
 }
 
 //_____________________________________________________________________________
@@ -901,6 +1148,22 @@ int InducedAccelerations::end(const SimTK::State &s)
 
     return(0);
 }
+//_____________________________________________________________________________
+/**
+ * Append the results of a copy of this analysis that was performed on later
+ * states.
+ */
+void InducedAccelerations::appendResults(Analysis& aAnalysis)
+{
+    auto& other = dynamic_cast<InducedAccelerations&>(aAnalysis);
+    for(int i = 0; i<_storeInducedAccelerations.getSize(); i++){
+        _storeInducedAccelerations[i]->append(
+                *other._storeInducedAccelerations[i]);
+    }
+    if(_reportConstraintReactions){
+        _storeConstraintReactions->append(*other._storeConstraintReactions);
+    }
+}
 
 
 
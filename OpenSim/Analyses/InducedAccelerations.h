@@ -102,6 +102,12 @@ protected:
     PropertyBool _reportConstraintReactionsProp;
     bool &_reportConstraintReactions;
 
+    /** Flag to solve for the contributions of path and coordinate actuators
+        together, from their forces, instead of realizing the model once per
+        actuator. */
+    PropertyBool _batchActuatorContributionsProp;
+    bool &_batchActuatorContributions;
+
     /** Storages for recording induced accelerations for specified coordinates and/or bodies. */
     Array<Storage *> _storeInducedAccelerations;
     Storage* _storeConstraintReactions;
@@ -109,6 +115,12 @@ protected:
     /** List of all the contributors to the model acceleration */
     Array<std::string> _contributors;
 
+    /** For each contributor, its column in the accelerations that are solved
+        for together, or -1 if the model is realized for it. */
+    Array<int> _batchColumns;
+    /** Index in the model's actuators of each of those columns. */
+    Array<int> _batchActuators;
+
     bool _includeCOM;
 
     // Internal work arrays to hold the induced accelerations at a given instant
@@ -186,6 +198,26 @@ public:
     //-------------------------------------------------------------------------
     void setModel(Model &aModel) override;
 
+    void setReportConstraintReactions(bool aTrueFalse) {
+        _reportConstraintReactions = aTrueFalse;
+    }
+    bool getReportConstraintReactions() const {
+        return _reportConstraintReactions;
+    }
+    /** Solve for the contributions of all the path actuators (including
+        muscles) and coordinate actuators at each time with one realization
+        of the model, by applying their forces and solving for the
+        accelerations with the mass matrix and constraint Jacobian of that
+        time, instead of realizing the model for each actuator. Other
+        contributors, and all contributors when constraint reactions are
+        reported, are computed by realizing the model. True by default. */
+    void setBatchActuatorContributions(bool aTrueFalse) {
+        _batchActuatorContributions = aTrueFalse;
+    }
+    bool getBatchActuatorContributions() const {
+        return _batchActuatorContributions;
+    }
+
     //-------------------------------------------------------------------------
     // INTEGRATION
     //-------------------------------------------------------------------------
@@ -193,6 +225,8 @@ public:
     int begin( const SimTK::State& s) override;
     int step( const SimTK::State& s, int stepNumber) override;
     int end( const SimTK::State& s) override;
+    bool isFrameIndependent() const override { return true; }
+    void appendResults(Analysis& aAnalysis) override;
 
     //-------------------------------------------------------------------------
     // IO
@@ -215,6 +249,12 @@ protected:
     Array<std::string> constructColumnLabelsForCOM();
     Array<std::string> constructColumnLabelsForConstraintReactions();
     void setupStorage();
+    void setupBatchedContributors();
+    void solveForBatchedContributions(const SimTK::State& s,
+            const SimTK::State& s_analysis, SimTK::State& s_batch,
+            SimTK::Matrix& udots);
+    void appendInducedAccelerations(const SimTK::State& s_batch,
+            const SimTK::Vector& udot);
 
     Array<bool> applyConstraintsAccordingToExternalForces(SimTK::State &s);
 
@@ -25,6 +25,7 @@
 //=============================================================================
 // INCLUDES
 //=============================================================================
+#include <OpenSim/Common/StorageInterpolator.h>
 #include <OpenSim/Simulation/Model/Model.h>
 #include <OpenSim/Simulation/Model/Actuator.h>
 #include "JointReaction.h"
@@ -279,6 +280,7 @@ void JointReaction::setupReactionList()
     /* setup the JointReactionKey and, for valid joint names, determine and set the 
     *  reactionIndex, onBodyIndex, and inFrameIndex of each JointReactionKey */
     _reactionList.setSize(0);
+    _expressedInFrames.clear();
     int index = -1;
     for (int i = 0; i < _jointNames.getSize(); ++i) {
         JointReactionKey currentKey;
@@ -332,6 +334,14 @@ void JointReaction::setupReactionList()
                                   "name or the keyword 'child' or 'parent'.")
                 }
             }
+
+            // frames shared by several reactions are transformed only once
+            auto frameIt = std::find(_expressedInFrames.begin(),
+                _expressedInFrames.end(), currentKey.expressedInFrame);
+            currentKey.expressedInFrameIndex =
+                int(frameIt - _expressedInFrames.begin());
+            if (frameIt == _expressedInFrames.end())
+                _expressedInFrames.push_back(currentKey.expressedInFrame);
             
             _reactionList.append(currentKey);
         }
@@ -419,6 +429,9 @@ void JointReaction::loadForcesFromFile()
         
         log_info("Loading actuator forces from file {}.", _forcesFileName);
         _storeActuation = new Storage(_forcesFileName);
+        _actuationInterpolator.reset(new StorageInterpolator(*_storeActuation));
+        _actuationCursor.reset(
+                new StorageInterpolator::Cursor(*_actuationInterpolator));
         int storeSize = _storeActuation->getSmallestNumberOfStates();
 
         log_info("Found {} actuator forces with time stamps ranging from {}"
@@ -515,6 +528,7 @@ setModel(Model& aModel)
     Analysis::setModel(aModel);
 
     // UPDATE VARIABLES IN THIS CLASS
+    _stateWithActuation = SimTK::State();
     setupReactionList();
     constructDescription();
     constructColumnLabels();
@@ -533,28 +547,35 @@ setModel(Model& aModel)
 /**
  * Compute and record the results.
  *
- * This method computes the reaction loads at all joints in the model, then
- * truncates the results to contain only the loads at the requested joints
- * and finally, if necessary, modifies the loads to be acting on the specified
- * body and expressed in the specified frame
+ * This method computes the reaction loads at all mobilizers in the model
+ * with one realization to acceleration, then picks the loads at the requested
+ * joints and finally, if necessary, shifts them to act on the parent body and
+ * expresses them in the specified frame.
  *
- * @param aT Current time in the simulation.
- * @param aX Current values of the controls.
- * @param aY Current values of the states.
+ * @param s Current state of the model.
  */
 int JointReaction::
 record(const SimTK::State& s)
 {
     /** if a forces file is specified replace the computed actuation with the 
-        forces from storage.*/
-    SimTK::State s_analysis = s;
-
-    _model->updMultibodySystem().realize(s_analysis, s.getSystemStage());
+        forces from storage. Otherwise, the reactions are computed from s
+        itself, without a copy.*/
+    const SimTK::State* analysisState = &s;
     if(_useForceStorage){
+        if(_stateWithActuation.getNumSubsystems() == 0) {
+            _stateWithActuation = s;
+        }
+        else {
+            _stateWithActuation.setTime(s.getTime());
+            _stateWithActuation.updY() = s.getY();
+        }
+        SimTK::State& s_analysis = _stateWithActuation;
+        _model->updMultibodySystem().realize(s_analysis, s.getSystemStage());
+
         const auto& actuatorSet = _model->getActuators();
         int nA = actuatorSet.getSize();
-        Array<double> forces(0,nA);
-        _storeActuation->getDataAtTime(s.getTime(),nA,forces);
+        StorageInterpolator::Cursor& forces = *_actuationCursor;
+        forces.seek(s.getTime());
         int storageIndex = -1;
         for(int actuatorIndex=0;actuatorIndex<nA;actuatorIndex++)
         {
@@ -569,66 +590,72 @@ record(const SimTK::State& s)
             const ScalarActuator* act = dynamic_cast<const ScalarActuator*>(&actuatorSet[actuatorIndex]);
             if (act){
                 act->overrideActuation(s_analysis, true);
-                act->setOverrideActuation(s_analysis, forces[storageIndex]);
+                act->setOverrideActuation(s_analysis,
+                        forces.getValue(storageIndex));
             }
         }
+        analysisState = &s_analysis;
     }
-    // VARIABLES
-    const Ground& ground = _model->getGround();
+    const SimTK::State& s_analysis = *analysisState;
 
     _model->realizeAcceleration(s_analysis);
 
+    /* reaction loads of all mobilizers at once, on the child body at M and
+    *  expressed in ground*/
+    _model->getMatterSubsystem().calcMobilizerReactionForces(s_analysis,
+        _mobilizerReactions);
+
+    /* transform of each frame in which reactions are expressed*/
+    int numFrames = (int)_expressedInFrames.size();
+    std::vector<Transform> framesInGround(numFrames);
+    for(int i=0; i<numFrames; i++) {
+        framesInGround[i] = _expressedInFrames[i]->getTransformInGround(s_analysis);
+    }
+
     /* retrieved desired joint reactions, convert to desired bodies, and convert
     *  to desired reference frames*/
     int numOutputJoints = _reactionList.getSize();
-    Vector_<Vec3> forcesVec(numOutputJoints), momentsVec(numOutputJoints), pointsVec(numOutputJoints);
     for(int i=0; i<numOutputJoints; i++) {
-        JointReactionKey currentKey = _reactionList[i];
+        const JointReactionKey& currentKey = _reactionList[i];
         const Joint& joint = *currentKey.joint;
-        const Frame& expressedInBody = *currentKey.expressedInFrame;
-        SpatialVec jointReaction;
-        Vec3 pointOfApplication;
-        
+        const Transform& X_GE = framesInGround[currentKey.expressedInFrameIndex];
+        const MobilizedBody& mobod = joint.getChildFrame().getMobilizedBody();
+        SpatialVec jointReaction =
+            _mobilizerReactions[mobod.getMobilizedBodyIndex()];
+        Vec3 locationInGround;
+
         // check if the load requested is on the parent or child
         if(!currentKey.isAppliedOnChild){
-            jointReaction = joint.calcReactionOnParentExpressedInGround(s_analysis);
-
-            // find the point of application in immediate parent frame, then
-            // transform to the base frame of the parent (expressedInBody)
-            Vec3 parentLocationInGlobal = joint.getParentFrame().getTransformInGround(s_analysis).p();
-            pointOfApplication = 
-                ground.findStationLocationInAnotherFrame(s_analysis, parentLocationInGlobal, expressedInBody);
+            // equal and opposite reaction on the parent, shifted from the
+            // mobilizer frame M on the child to the frame F on the parent
+            Vec3 p_GM = (mobod.getBodyTransform(s_analysis)
+                         * mobod.getOutboardFrame(s_analysis)).p();
+            Vec3 p_GF = (mobod.getParentMobilizedBody()
+                         .getBodyTransform(s_analysis)
+                         * mobod.getInboardFrame(s_analysis)).p();
+            jointReaction = -shiftForceFromTo(jointReaction, p_GM, p_GF);
+
+            // the point of application is the origin of the parent frame
+            locationInGround = joint.getParentFrame().getTransformInGround(s_analysis).p();
         }
         else{
-            jointReaction = joint.calcReactionOnChildExpressedInGround(s_analysis);
-
-            // find the point of application in immediate child frame, then
-            // transform to the base frame of the child (expressedInBody)
-            Vec3 childLocationInGlobal = joint.getChildFrame().getTransformInGround(s_analysis).p();
-            pointOfApplication =
-                ground.findStationLocationInAnotherFrame(s_analysis, childLocationInGlobal, expressedInBody);
+            // the point of application is the origin of the child frame
+            locationInGround = joint.getChildFrame().getTransformInGround(s_analysis).p();
         }
 
-        // transform SpatialVec of reaction forces and moments to the
-        // requested base frame (expressedInBody)
-        Vec3 force = ground.expressVectorInAnotherFrame(s_analysis, jointReaction[1], expressedInBody);
-        Vec3 moment = ground.expressVectorInAnotherFrame(s_analysis, jointReaction[0], expressedInBody);
-
-        /* place results in the truncated loads vectors*/
-        forcesVec[i] = force;
-        momentsVec[i] = moment;
-        pointsVec[i] = pointOfApplication;
-    }
-
-    /* fill out row construction array*/
-    for(int i=0;i<numOutputJoints;i++) {
+        // express the reaction forces and moments and the point of
+        // application in the requested frame (expressedInBody)
         int I = 9*i;
+        Vec3 force = X_GE.xformBaseVecToFrame(jointReaction[1]);
+        Vec3 moment = X_GE.xformBaseVecToFrame(jointReaction[0]);
+        Vec3 pointOfApplication = X_GE.shiftBaseStationToFrame(locationInGround);
         for(int j=0;j<3;j++) {
-            _Loads[I+j] = forcesVec[i][j];
-            _Loads[I+j+3] = momentsVec[i][j];
-            _Loads[I+j+6] = pointsVec[i][j];
+            _Loads[I+j] = force[j];
+            _Loads[I+j+3] = moment[j];
+            _Loads[I+j+6] = pointOfApplication[j];
         }
     }
+
     /* Write the reaction data to storage*/
     _storeReactionLoads.append(s.getTime(),_Loads.getSize(),&_Loads[0]);
 
@@ -651,6 +678,8 @@ begin(const SimTK::State& s)
     if(!proceed()) return(0);
     // Read forces file here rather than during initialization
     setupStorage();
+    // copy the discrete variables of this run's state at the first record
+    _stateWithActuation = SimTK::State();
 
     // RESET STORAGE
     _storeReactionLoads.reset(s.getTime());
@@ -701,6 +730,17 @@ end(const SimTK::State&s)
 
     return(0);
 }
+//_____________________________________________________________________________
+/**
+ * Append the results of a copy of this analysis that was performed on later
+ * states.
+ */
+void JointReaction::
+appendResults(Analysis& aAnalysis)
+{
+    auto& other = dynamic_cast<JointReaction&>(aAnalysis);
+    _storeReactionLoads.append(other._storeReactionLoads);
+}
 
 
 
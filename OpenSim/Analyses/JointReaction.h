@@ -29,6 +29,7 @@
 //=============================================================================
 #include <OpenSim/Common/PropertyStr.h>
 #include <OpenSim/Common/PropertyStrArray.h>
+#include <OpenSim/Common/StorageInterpolator.h>
 #include <OpenSim/Simulation/Model/Analysis.h>
 #include "osimAnalysesDLL.h"
 
@@ -79,6 +80,8 @@ private:
         const Frame* appliedOnBody;
         /* The reference Frame in which the force should be expressed. */
         const Frame* expressedInFrame;
+        /* Index of expressedInFrame in _expressedInFrames. */
+        int expressedInFrameIndex;
     };
 
 protected:
@@ -112,6 +115,12 @@ protected:
     /** Storage for holding actuator forces IF SPECIFIED by user.*/
     Storage *_storeActuation;
 
+    /** Interpolator of _storeActuation, built when the file is loaded.*/
+    std::unique_ptr<StorageInterpolator> _actuationInterpolator;
+    /** Cursor of _actuationInterpolator at the last recorded time; rebuilt
+    with the interpolator.*/
+    std::unique_ptr<StorageInterpolator::Cursor> _actuationCursor;
+
     /** Storage for recording joint Reaction loads.*/
     Storage _storeReactionLoads;
 
@@ -135,6 +144,19 @@ protected:
     *   desired joints, onBody, and inFrame to be output*/
     Array<JointReactionKey> _reactionList;
 
+    /** Internal work array for holding the distinct frames in which loads
+    *   are expressed, so that each is transformed once per time*/
+    std::vector<const Frame*> _expressedInFrames;
+
+    /** Internal work array for holding the reaction loads of all mobilizers,
+    *   on the child body at its mobilizer frame, expressed in ground*/
+    SimTK::Vector_<SimTK::SpatialVec> _mobilizerReactions;
+
+    /** State in which the actuation is overridden with the forces file. Its
+    *   discrete variables are copied once per run; the continuous state
+    *   variables and time are copied at each record*/
+    SimTK::State _stateWithActuation;
+
     bool _useForceStorage;
 
 //=============================================================================
@@ -181,6 +203,9 @@ public:
     const Array<std::string>& getInFrame() const { return _inFrame; }
     void setInFrame( Array<std::string>& inFrame) { _inFrame = inFrame; }
 
+    /** The reaction loads recorded so far */
+    const Storage& getReactionLoadsStorage() const { return _storeReactionLoads; }
+
     //-------------------------------------------------------------------------
     // INTEGRATION
     //----------------------------------------------------------------------
@@ -190,6 +215,10 @@ public:
         step( const SimTK::State& s, int setNumber ) override;
     int
         end( const SimTK::State& s ) override;
+    bool
+        isFrameIndependent() const override { return true; }
+    void
+        appendResults(Analysis& aAnalysis) override;
 
 
     //-------------------------------------------------------------------------
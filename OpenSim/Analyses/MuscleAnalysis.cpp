@@ -28,11 +28,123 @@
 //=============================================================================
 #include <OpenSim/Common/IO.h>
 #include <OpenSim/Simulation/Model/Model.h>
+#include <OpenSim/Simulation/Model/MovingPathPoint.h>
+#include <OpenSim/Simulation/MomentArmSolver.h>
+#include <OpenSim/Simulation/Wrap/PathWrap.h>
+#include <OpenSim/Simulation/Wrap/WrapObject.h>
 #include "MuscleAnalysis.h"
 
+#include <numeric>
+
 using namespace OpenSim;
 using namespace std;
 
+namespace {
+// Indices of the buffers of the quantities recorded for each muscle.
+enum Quantity {
+    PennationAngle, Length, FiberLength, NormalizedFiberLength, TendonLength,
+    FiberVelocity, NormFiberVelocity, PennationAngularVelocity,
+    TendonForce, FiberForce, ActiveFiberForce, PassiveFiberForce,
+    ActiveFiberForceAlongTendon, PassiveFiberForceAlongTendon,
+    FiberActivePower, FiberPassivePower, TendonPower, MusclePower,
+    NumQuantities
+};
+
+// Whether the mobilities of each mobilized body can change the length of a
+// path: either the mobilizer separates frames to which points or wrap objects
+// of the path are attached, or one of its coordinates moves a MovingPathPoint.
+// Moving a body whose subtree holds all (or none) of the attached frames moves
+// the path rigidly (or not at all).
+std::vector<bool> findSpannedMobilizers(
+        const SimTK::SimbodyMatterSubsystem& matter, const GeometryPath& path)
+{
+    const int nb = matter.getNumBodies();
+    std::vector<bool> attached(nb, false);
+    std::vector<bool> spanned(nb, false);
+
+    const PathPointSet& points = path.getPathPointSet();
+    for(int i=0; i<points.getSize(); ++i) {
+        const AbstractPathPoint& point = points.get(i);
+        attached[point.getParentFrame().getMobilizedBodyIndex()] = true;
+        const MovingPathPoint* moving =
+                dynamic_cast<const MovingPathPoint*>(&point);
+        if(moving == nullptr) continue;
+        if(moving->hasXCoordinate())
+            spanned[moving->getXCoordinate().getBodyIndex()] = true;
+        if(moving->hasYCoordinate())
+            spanned[moving->getYCoordinate().getBodyIndex()] = true;
+        if(moving->hasZCoordinate())
+            spanned[moving->getZCoordinate().getBodyIndex()] = true;
+    }
+    const PathWrapSet& wraps = path.getWrapSet();
+    for(int i=0; i<wraps.getSize(); ++i) {
+        const WrapObject* wrapObject = wraps.get(i).getWrapObject();
+        if(wrapObject)
+            attached[wrapObject->getFrame().getMobilizedBodyIndex()] = true;
+    }
+
+    // Count the attached frames in the subtree of each body.
+    std::vector<int> numInSubtree(nb, 0);
+    int numAttached = 0;
+    for(SimTK::MobilizedBodyIndex b(0); b < nb; ++b) {
+        if(!attached[b]) continue;
+        ++numAttached;
+        for(const SimTK::MobilizedBody* body = &matter.getMobilizedBody(b);
+                !body->isGround(); body = &body->getParentMobilizedBody()) {
+            ++numInSubtree[body->getMobilizedBodyIndex()];
+        }
+    }
+    for(int b=0; b<nb; ++b) {
+        if(numInSubtree[b] > 0 && numInSubtree[b] < numAttached)
+            spanned[b] = true;
+    }
+    return spanned;
+}
+
+// Group the mobilized bodies whose mobilities are coupled by a constraint of
+// the model (enabled or not), and return the group of each body.
+std::vector<int> groupConstrainedMobilizers(
+        const SimTK::SimbodyMatterSubsystem& matter)
+{
+    std::vector<int> group(matter.getNumBodies());
+    std::iota(group.begin(), group.end(), 0);
+    auto findGroup = [&group](int b) {
+        while(group[b] != b) b = group[b] = group[group[b]];
+        return b;
+    };
+
+    for(SimTK::ConstraintIndex c(0); c < matter.getNumConstraints(); ++c) {
+        const SimTK::Constraint& constraint = matter.getConstraint(c);
+        std::vector<int> involved;
+        for(SimTK::ConstrainedMobilizerIndex m(0);
+                m < constraint.getNumConstrainedMobilizers(); ++m) {
+            involved.push_back(constraint
+                    .getMobilizedBodyFromConstrainedMobilizer(m)
+                    .getMobilizedBodyIndex());
+        }
+        // A constrained body involves the mobilities between it and the
+        // ancestor of the constraint.
+        if(constraint.getNumConstrainedBodies() > 0) {
+            const SimTK::MobilizedBodyIndex ancestor =
+                    constraint.getAncestorMobilizedBody()
+                            .getMobilizedBodyIndex();
+            for(SimTK::ConstrainedBodyIndex cb(0);
+                    cb < constraint.getNumConstrainedBodies(); ++cb) {
+                for(const SimTK::MobilizedBody* body =
+                            &constraint.getMobilizedBodyFromConstrainedBody(cb);
+                        body->getMobilizedBodyIndex() != ancestor;
+                        body = &body->getParentMobilizedBody()) {
+                    involved.push_back(body->getMobilizedBodyIndex());
+                }
+            }
+        }
+        for(int b : involved) group[findGroup(b)] = findGroup(involved[0]);
+    }
+    for(int b=0; b<(int)group.size(); ++b) group[b] = findGroup(b);
+    return group;
+}
+} // anonymous namespace
+
 
 //=============================================================================
 // CONSTANTS
@@ -197,12 +309,17 @@ void MuscleAnalysis::allocateStorageObjects()
     if(_model==NULL) return;
 
     // CLEAR EXISTING WORK ARRAYS
+    // (the buffers refer to the storages, which are deleted)
+    clearResultBuffers();
+    _quantityBuffers.clear();
     _storageList.setMemoryOwner(true);
     _storageList.setSize(0);
     _momentArmStorageArray.setMemoryOwner(true);
     _momentArmStorageArray.setSize(0);
     _muscleArray.setMemoryOwner(false);
     _muscleArray.setSize(0);
+    _momentArmSolver.reset();
+    _momentArmDependencies.clear();
 
     // FOR MOMENT ARMS AND MOMENTS
     if(_computeMoments) {
@@ -375,6 +492,25 @@ void MuscleAnalysis::allocateStorageObjects()
         if(store==NULL) continue;
         store->setColumnLabels(getColumnLabels());
     }
+
+    // BUFFERS FOR RECORDING, ONE COLUMN PER MUSCLE
+    nm = _muscleArray.getSize();
+    for(int i=0; i<_momentArmStorageArray.getSize(); i++) {
+        StorageCoordinatePair* pair = _momentArmStorageArray[i];
+        pair->momentArmBuffer = &addResultBuffer(*pair->momentArmStore, nm);
+        pair->momentBuffer = &addResultBuffer(*pair->momentStore, nm);
+    }
+    Storage* quantityStores[NumQuantities] = {_pennationAngleStore,
+        _lengthStore, _fiberLengthStore, _normalizedFiberLengthStore,
+        _tendonLengthStore, _fiberVelocityStore, _normFiberVelocityStore,
+        _pennationAngularVelocityStore, _forceStore, _fiberForceStore,
+        _activeFiberForceStore, _passiveFiberForceStore,
+        _activeFiberForceAlongTendonStore, _passiveFiberForceAlongTendonStore,
+        _fiberActivePowerStore, _fiberPassivePowerStore, _tendonPowerStore,
+        _musclePowerStore};
+    for(Storage* quantityStore : quantityStores) {
+        _quantityBuffers.push_back(&addResultBuffer(*quantityStore, nm));
+    }
 }
 
 //-----------------------------------------------------------------------------
@@ -396,6 +532,42 @@ void MuscleAnalysis::constructColumnLabels()
     setColumnLabels(labels);
 }
 
+//-----------------------------------------------------------------------------
+// MOMENT ARM DEPENDENCIES
+//-----------------------------------------------------------------------------
+//_____________________________________________________________________________
+/**
+ * Find which muscles can have a nonzero moment arm about each coordinate, from
+ * the frames of their path points and wrap objects, the coordinates of their
+ * moving path points, and the constraints of the model. The moment arms of the
+ * other muscles are zero by construction and are not computed in record().
+ */
+void MuscleAnalysis::computeMomentArmDependencies()
+{
+    const SimTK::SimbodyMatterSubsystem& matter = _model->getMatterSubsystem();
+    // A coordinate coupled by constraints to the mobilities of other bodies
+    // depends on every muscle that spans any of them.
+    std::vector<int> group = groupConstrainedMobilizers(matter);
+
+    int nm = _muscleArray.getSize();
+    int nq = _momentArmStorageArray.getSize();
+    _momentArmDependencies.assign(nq, std::vector<bool>(nm, false));
+    for(int j=0; j<nm; j++) {
+        std::vector<bool> spanned = findSpannedMobilizers(matter,
+                _muscleArray[j]->getGeometryPath());
+        std::vector<bool> groupSpanned(spanned.size(), false);
+        for(int b=0; b<(int)spanned.size(); b++) {
+            if(spanned[b]) groupSpanned[group[b]] = true;
+        }
+        for(int i=0; i<nq; i++) {
+            int b = _momentArmStorageArray[i]->q->getBodyIndex();
+            _momentArmDependencies[i][j] = groupSpanned[group[b]];
+        }
+    }
+
+    _momentArmSolver.reset(new MomentArmSolver(*_model));
+}
+
 
 //=============================================================================
 // OPERATORS
@@ -505,24 +677,39 @@ int MuscleAnalysis::record(const SimTK::State& s)
     // LOOP THROUGH MUSCLES
     int nm = _muscleArray.getSize();
 
-    double nan = SimTK::NaN;
+    // APPEND A ROW TO THE BUFFER OF EACH QUANTITY
+    // Quantities that cannot be evaluated are left as NaN.
+    int row = 0;
+    for(ResultBuffer* buffer : _quantityBuffers) {
+        row = buffer->appendRow(tReal);
+    }
     // Angles and lengths
-    Array<double> penang(nan,nm);
-    Array<double> len(nan,nm), tlen(nan,nm);
-    Array<double> fiblen(nan,nm), normfiblen(nan,nm);
+    ResultBuffer& penang = *_quantityBuffers[PennationAngle];
+    ResultBuffer& len = *_quantityBuffers[Length];
+    ResultBuffer& tlen = *_quantityBuffers[TendonLength];
+    ResultBuffer& fiblen = *_quantityBuffers[FiberLength];
+    ResultBuffer& normfiblen = *_quantityBuffers[NormalizedFiberLength];
 
     // Muscle velocity information
-    Array<double> fibVel(nan,nm), normFibVel(nan,nm);
-    Array<double> penAngVel(nan,nm);
+    ResultBuffer& fibVel = *_quantityBuffers[FiberVelocity];
+    ResultBuffer& normFibVel = *_quantityBuffers[NormFiberVelocity];
+    ResultBuffer& penAngVel = *_quantityBuffers[PennationAngularVelocity];
 
     // Muscle component forces
-    Array<double> force(nan, nm), fibforce(nan, nm);
-    Array<double> actfibforce(nan,nm), passfibforce(nan,nm);
-    Array<double> actfibforcealongten(nan,nm), passfibforcealongten(nan,nm);
+    ResultBuffer& force = *_quantityBuffers[TendonForce];
+    ResultBuffer& fibforce = *_quantityBuffers[FiberForce];
+    ResultBuffer& actfibforce = *_quantityBuffers[ActiveFiberForce];
+    ResultBuffer& passfibforce = *_quantityBuffers[PassiveFiberForce];
+    ResultBuffer& actfibforcealongten =
+            *_quantityBuffers[ActiveFiberForceAlongTendon];
+    ResultBuffer& passfibforcealongten =
+            *_quantityBuffers[PassiveFiberForceAlongTendon];
 
     // Muscle and component powers
-    Array<double> fibActivePower(nan,nm), fibPassivePower(nan,nm),
-                  tendonPower(nan,nm), muscPower(nan,nm);
+    ResultBuffer& fibActivePower = *_quantityBuffers[FiberActivePower];
+    ResultBuffer& fibPassivePower = *_quantityBuffers[FiberPassivePower];
+    ResultBuffer& tendonPower = *_quantityBuffers[TendonPower];
+    ResultBuffer& muscPower = *_quantityBuffers[MusclePower];
 
     double sysMass = _model->getMatterSubsystem().calcSystemMass(s);
     bool hasMass = sysMass > SimTK::Eps;
@@ -534,11 +721,11 @@ int MuscleAnalysis::record(const SimTK::State& s)
 
     for(int i=0; i<nm; ++i) {
         try{
-            len[i] = _muscleArray[i]->getLength(s);
-            tlen[i] = _muscleArray[i]->getTendonLength(s);
-            fiblen[i] = _muscleArray[i]->getFiberLength(s);
-            normfiblen[i] = _muscleArray[i]->getNormalizedFiberLength(s);
-            penang[i] = _muscleArray[i]->getPennationAngle(s);
+            len.setValue(row, i, _muscleArray[i]->getLength(s));
+            tlen.setValue(row, i, _muscleArray[i]->getTendonLength(s));
+            fiblen.setValue(row, i, _muscleArray[i]->getFiberLength(s));
+            normfiblen.setValue(row, i, _muscleArray[i]->getNormalizedFiberLength(s));
+            penang.setValue(row, i, _muscleArray[i]->getPennationAngle(s));
         }
         catch (const std::exception& e) {
             if(!lengthWarning){
@@ -554,12 +741,12 @@ int MuscleAnalysis::record(const SimTK::State& s)
             // Compute muscle forces that are dependent on Positions, Velocities
             // so that later quantities are valid and setForce is called
             _muscleArray[i]->computeActuation(s);
-            force[i] = _muscleArray[i]->getActuation(s);
-            fibforce[i] = _muscleArray[i]->getFiberForce(s);
-            actfibforce[i] = _muscleArray[i]->getActiveFiberForce(s);
-            passfibforce[i] = _muscleArray[i]->getPassiveFiberForce(s);
-            actfibforcealongten[i] = _muscleArray[i]->getActiveFiberForceAlongTendon(s);
-            passfibforcealongten[i] = _muscleArray[i]->getPassiveFiberForceAlongTendon(s);
+            force.setValue(row, i, _muscleArray[i]->getActuation(s));
+            fibforce.setValue(row, i, _muscleArray[i]->getFiberForce(s));
+            actfibforce.setValue(row, i, _muscleArray[i]->getActiveFiberForce(s));
+            passfibforce.setValue(row, i, _muscleArray[i]->getPassiveFiberForce(s));
+            actfibforcealongten.setValue(row, i, _muscleArray[i]->getActiveFiberForceAlongTendon(s));
+            passfibforcealongten.setValue(row, i, _muscleArray[i]->getPassiveFiberForceAlongTendon(s));
         }
         catch (const std::exception& e) {
             if(!forceWarning){
@@ -580,14 +767,14 @@ int MuscleAnalysis::record(const SimTK::State& s)
         for(int i=0; i<nm; ++i) {
             try{
                 //Velocities
-                fibVel[i] = _muscleArray[i]->getFiberVelocity(s);
-                normFibVel[i] =  _muscleArray[i]->getNormalizedFiberVelocity(s);
-                penAngVel[i] =  _muscleArray[i]->getPennationAngularVelocity(s);
+                fibVel.setValue(row, i, _muscleArray[i]->getFiberVelocity(s));
+                normFibVel.setValue(row, i, _muscleArray[i]->getNormalizedFiberVelocity(s));
+                penAngVel.setValue(row, i, _muscleArray[i]->getPennationAngularVelocity(s));
                 //Powers
-                fibActivePower[i] = _muscleArray[i]->getFiberActivePower(s);
-                fibPassivePower[i] = _muscleArray[i]->getFiberPassivePower(s);
-                tendonPower[i] = _muscleArray[i]->getTendonPower(s);
-                muscPower[i] = _muscleArray[i]->getMusclePower(s);
+                fibActivePower.setValue(row, i, _muscleArray[i]->getFiberActivePower(s));
+                fibPassivePower.setValue(row, i, _muscleArray[i]->getFiberPassivePower(s));
+                tendonPower.setValue(row, i, _muscleArray[i]->getTendonPower(s));
+                muscPower.setValue(row, i, _muscleArray[i]->getMusclePower(s));
             }
             catch (const std::exception& e) {
                 if(!dynamicsWarning){
@@ -609,59 +796,50 @@ int MuscleAnalysis::record(const SimTK::State& s)
         }
     }
 
-    // APPEND TO STORAGE
-    _pennationAngleStore->append(tReal,penang.getSize(),&penang[0]);
-    _lengthStore->append(tReal,len.getSize(),&len[0]);
-    _fiberLengthStore->append(tReal,fiblen.getSize(),&fiblen[0]);
-    _normalizedFiberLengthStore
-        ->append(tReal,normfiblen.getSize(),&normfiblen[0]);
-    _tendonLengthStore->append(tReal,tlen.getSize(),&tlen[0]);
-
-    _fiberVelocityStore->append(tReal,fibVel.getSize(),&fibVel[0]);
-    _normFiberVelocityStore->append(tReal,normFibVel.getSize(),&normFibVel[0]);
-    _pennationAngularVelocityStore
-        ->append(tReal,penAngVel.getSize(),&penAngVel[0]);
-
-    _forceStore->append(tReal,force.getSize(),&force[0]);
-    _fiberForceStore->append(tReal,fibforce.getSize(),&fibforce[0]);
-    _activeFiberForceStore->append(tReal,actfibforce.getSize(),&actfibforce[0]);
-    _passiveFiberForceStore
-        ->append(tReal,passfibforce.getSize(),&passfibforce[0]);
-    _activeFiberForceAlongTendonStore
-        ->append(tReal,actfibforcealongten.getSize(),&actfibforcealongten[0]);
-    _passiveFiberForceAlongTendonStore
-        ->append(tReal,passfibforcealongten.getSize(),&passfibforcealongten[0]);
-
-    _fiberActivePowerStore
-        ->append(tReal,fibActivePower.getSize(),&fibActivePower[0]);
-    _fiberPassivePowerStore
-        ->append(tReal,fibPassivePower.getSize(),&fibPassivePower[0]);
-    _tendonPowerStore->append(tReal,tendonPower.getSize(),&tendonPower[0]);
-    _musclePowerStore->append(tReal,muscPower.getSize(),&muscPower[0]);
-
     if (_computeMoments){
+        // The dependencies of the moment arms on the coordinates are found
+        // once the model's system exists.
+        if(!_momentArmSolver) computeMomentArmDependencies();
+
+        _model->getMultibodySystem().realize(s, s.getSystemStage());
+
+        // Generalized forces of a unit tension in the path of each muscle,
+        // which are shared by all coordinates.
+        std::vector<SimTK::Vector> pathForces(nm);
+
         // LOOP OVER ACTIVE MOMENT ARM STORAGE OBJECTS
         Coordinate *q = NULL;
-        Storage *maStore=NULL, *mStore=NULL;
         int nq = _momentArmStorageArray.getSize();
-        Array<double> ma(0.0,nm),m(0.0,nm);
 
         for(int i=0; i<nq; i++) {
 
             q = _momentArmStorageArray[i]->q;
-            maStore = _momentArmStorageArray[i]->momentArmStore;
-            mStore = _momentArmStorageArray[i]->momentStore;
-           
-            // bool locked = q->getLocked(s);
+            ResultBuffer& ma = *_momentArmStorageArray[i]->momentArmBuffer;
+            ResultBuffer& m = *_momentArmStorageArray[i]->momentBuffer;
+            int maRow = ma.appendRow(tReal);
+            m.appendRow(tReal);
+
+            // Coupling of the coordinate to the other mobilities due to
+            // constraints, which is shared by all muscles.
+            SimTK::Vector coupling = _momentArmSolver->computeCoupling(s, *q);
 
-            _model->getMultibodySystem().realize(s, s.getSystemStage());
             // LOOP OVER MUSCLES
+            const std::vector<bool>& dependent = _momentArmDependencies[i];
             for(int j=0; j<nm; j++) {
-                ma[j] = _muscleArray[j]->computeMomentArm(s,*q);
-                m[j] = ma[j] * force[j];
+                // Muscles that do not span the coordinate have a moment arm
+                // of zero.
+                double momentArm = 0.0;
+                if(dependent[j]) {
+                    if(pathForces[j].size() == 0) {
+                        pathForces[j] =
+                            _momentArmSolver->computeGeneralizedForces(s,
+                                    _muscleArray[j]->getGeometryPath());
+                    }
+                    momentArm = ~coupling*pathForces[j];
+                }
+                ma.setValue(maRow, j, momentArm);
+                m.setValue(maRow, j, momentArm * force.getValue(row, j));
             }
-            maStore->append(s.getTime(),nm,&ma[0]);
-            mStore->append(s.getTime(),nm,&m[0]);
         }
     }
     return 0;
@@ -759,6 +937,7 @@ int MuscleAnalysis::end(const SimTK::State& s )
 {
     if (!proceed()) return 0;
     record(s);
+    flushResultBuffers();
     return 0;
 }
 
@@ -784,6 +963,7 @@ printResults(const string &aBaseName,const string &aDir,double aDT,
         return 0;
     }
 
+    flushResultBuffers();
     std::string prefix = aBaseName + "_" + getName() + "_";
     for(int i=0; i<_storageList.getSize(); ++i){
         Storage::printResult(_storageList[i],prefix+_storageList[i]->getName(),aDir,aDT,aExtension);
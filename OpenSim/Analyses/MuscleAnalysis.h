@@ -45,6 +45,7 @@
 namespace OpenSim { 
 
 class Coordinate;
+class MomentArmSolver;
 
 //=============================================================================
 //=============================================================================
@@ -69,6 +70,8 @@ public:
         Coordinate *q;
         Storage *momentArmStore;
         Storage *momentStore;
+        ResultBuffer *momentArmBuffer;
+        ResultBuffer *momentBuffer;
     }  
 // Excluding this from Doxygen until it has better documentation! -Sam Hamner
     /// @cond
@@ -137,6 +140,15 @@ private:
 #ifndef SWIG
     /** Array of active storage and coordinate pairs. */
     ArrayPtrs<StorageCoordinatePair> _momentArmStorageArray;
+    /** Buffers of the storages of muscle quantities above, in the order in
+    which they are declared, to which record() appends its results. */
+    std::vector<ResultBuffer*> _quantityBuffers;
+    /** Solver for the moment arms of all muscles, which shares the
+    constraint coupling of each coordinate among the muscles. */
+    std::unique_ptr<MomentArmSolver> _momentArmSolver;
+    /** For each pair in _momentArmStorageArray, whether the path of each
+    muscle can have a nonzero moment arm about the coordinate. */
+    std::vector<std::vector<bool>> _momentArmDependencies;
 #endif
     /** Array of active muscles. */
     ArrayPtrs<Muscle> _muscleArray;
@@ -155,6 +167,7 @@ private:
     void setupProperties();
     void constructDescription();
     void constructColumnLabels();
+    void computeMomentArmDependencies();
 
 public:
     //--------------------------------------------------------------------------
@@ -170,44 +183,44 @@ public:
     void setStorageCapacityIncrements(int aIncrement);
 
     Storage* getPennationAngleStorage() const { 
-        return _pennationAngleStore; }
+        flushResultBuffers(); return _pennationAngleStore; }
     Storage* getMuscleTendonLengthStorage() const { 
-        return _lengthStore; }
+        flushResultBuffers(); return _lengthStore; }
     Storage* getFiberLengthStorage() const { 
-        return _fiberLengthStore; }
+        flushResultBuffers(); return _fiberLengthStore; }
     Storage* getNormalizedFiberLengthStorage() const { 
-        return _normalizedFiberLengthStore; }
+        flushResultBuffers(); return _normalizedFiberLengthStore; }
     Storage* getTendonLengthStorage() const { 
-        return _tendonLengthStore; }
+        flushResultBuffers(); return _tendonLengthStore; }
 
     Storage* getFiberVelocityStorage() const { 
-        return _fiberVelocityStore; }
+        flushResultBuffers(); return _fiberVelocityStore; }
     Storage* getNormalizedFiberVelocityStorage() const { 
-        return _normFiberVelocityStore; }
+        flushResultBuffers(); return _normFiberVelocityStore; }
     Storage* getPennationAngularVelocityStorage() const { 
-        return _pennationAngularVelocityStore; }
+        flushResultBuffers(); return _pennationAngularVelocityStore; }
 
     Storage* getForceStorage() const { 
-        return _forceStore; }
+        flushResultBuffers(); return _forceStore; }
     Storage* getFiberForceStorage() const { 
-        return _fiberForceStore; }
+        flushResultBuffers(); return _fiberForceStore; }
     Storage* getActiveFiberForceStorage() const { 
-        return _activeFiberForceStore; }
+        flushResultBuffers(); return _activeFiberForceStore; }
     Storage* getPassiveFiberForceStorage() const { 
-        return _passiveFiberForceStore; }
+        flushResultBuffers(); return _passiveFiberForceStore; }
     Storage* getActiveFiberForceAlongTendonStorage() const { 
-        return _activeFiberForceAlongTendonStore; }
+        flushResultBuffers(); return _activeFiberForceAlongTendonStore; }
     Storage* getPassiveFiberForceAlongTendonStorage() const { 
-        return _passiveFiberForceAlongTendonStore; }
+        flushResultBuffers(); return _passiveFiberForceAlongTendonStore; }
     
     Storage* getFiberActivePowerStorage() const { 
-        return _fiberActivePowerStore; }
+        flushResultBuffers(); return _fiberActivePowerStore; }
     Storage* getFiberPassivePowerStorage() const { 
-        return _fiberPassivePowerStore; }
+        flushResultBuffers(); return _fiberPassivePowerStore; }
     Storage* getTendonPowerStorage() const { 
-        return _tendonPowerStore; }
+        flushResultBuffers(); return _tendonPowerStore; }
     Storage* getMusclePowerStorage() const { 
-        return _musclePowerStore; }
+        flushResultBuffers(); return _musclePowerStore; }
 
     void setMuscles(Array<std::string>& aMuscles);
     void setCoordinates(Array<std::string>& aCoordinates);
@@ -219,7 +232,8 @@ public:
         return _computeMoments;
     }
 #ifndef SWIG
-    const ArrayPtrs<StorageCoordinatePair>& getMomentArmStorageArray() const { return _momentArmStorageArray; }
+    const ArrayPtrs<StorageCoordinatePair>& getMomentArmStorageArray() const {
+        flushResultBuffers(); return _momentArmStorageArray; }
 #endif
     //--------------------------------------------------------------------------
     // ANALYSIS
@@ -230,6 +244,8 @@ public:
         step(const SimTK::State& s, int setNumber ) override;
     int
         end( const SimTK::State& s ) override;
+    bool
+        isFrameIndependent() const override { return true; }
 protected:
     virtual int
         record(const SimTK::State& s );
@@ -631,6 +631,19 @@ end( const SimTK::State& s)
     log_info("PointKinematics.end: Finalizing analysis {}.", getName());
     return 0 ;
 }
+//_____________________________________________________________________________
+/**
+ * Append the results of a copy of this analysis that was performed on later
+ * states.
+ */
+void PointKinematics::
+appendResults(Analysis& aAnalysis)
+{
+    auto& other = dynamic_cast<PointKinematics&>(aAnalysis);
+    _pStore->append(*other._pStore);
+    _vStore->append(*other._vStore);
+    _aStore->append(*other._aStore);
+}
 
 
 
@@ -336,6 +336,17 @@ end(const SimTK::State&s )
 
     return 0;
 }
+//_____________________________________________________________________________
+/**
+ * Append the results of a copy of this analysis that was performed on later
+ * states.
+ */
+void ProbeReporter::
+appendResults(Analysis& aAnalysis)
+{
+    auto& other = dynamic_cast<ProbeReporter&>(aAnalysis);
+    _probeStore.append(other._probeStore);
+}
 
 
 
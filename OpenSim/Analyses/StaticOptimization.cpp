@@ -25,6 +25,7 @@
 //=============================================================================
 // INCLUDES
 //=============================================================================
+#include <OpenSim/Common/CommonUtilities.h>
 #include <OpenSim/Common/IO.h>
 #include <OpenSim/Simulation/Model/Model.h>
 #include <OpenSim/Actuators/CoordinateActuator.h>
@@ -33,6 +34,8 @@
 #include "StaticOptimizationTarget.h"
 #include <OpenSim/Simulation/Model/ActivationFiberLengthMuscle.h>
 
+#include <algorithm>
+#include <thread>
 
 using namespace OpenSim;
 using namespace std;
@@ -61,6 +64,8 @@ StaticOptimization::StaticOptimization(Model *aModel) :
     _useMusclePhysiology(_useMusclePhysiologyProp.getValueBool()),
     _convergenceCriterion(_convergenceCriterionProp.getValueDbl()),
     _maximumIterations(_maximumIterationsProp.getValueInt()),
+    _useQPSolver(_useQPSolverProp.getValueBool()),
+    _parallel(_parallelProp.getValueInt()),
     _modelWorkingCopy(NULL)
 {
     setNull();
@@ -82,6 +87,8 @@ StaticOptimization::StaticOptimization(const StaticOptimization &aStaticOptimiza
     _useMusclePhysiology(_useMusclePhysiologyProp.getValueBool()),
     _convergenceCriterion(_convergenceCriterionProp.getValueDbl()),
     _maximumIterations(_maximumIterationsProp.getValueInt()),
+    _useQPSolver(_useQPSolverProp.getValueBool()),
+    _parallel(_parallelProp.getValueInt()),
     _modelWorkingCopy(NULL)
 {
     setNull();
@@ -114,6 +121,8 @@ operator=(const StaticOptimization &aStaticOptimization)
     _activationExponent=aStaticOptimization._activationExponent;
     _convergenceCriterion=aStaticOptimization._convergenceCriterion;
     _maximumIterations=aStaticOptimization._maximumIterations;
+    _useQPSolver = aStaticOptimization._useQPSolver;
+    _parallel = aStaticOptimization._parallel;
     _forceReporter = nullptr;
     _useMusclePhysiology=aStaticOptimization._useMusclePhysiology;
     return(*this);
@@ -138,6 +147,8 @@ void StaticOptimization::setNull()
     _numCoordinateActuators = 0;
     _convergenceCriterion = 1e-4;
     _maximumIterations = 100;
+    _useQPSolver = true;
+    _parallel = 0;
     _forceReporter = nullptr;
     setName("StaticOptimization");
 }
@@ -173,6 +184,22 @@ setupProperties()
         "An integer for setting the maximum number of iterations the optimizer can use at each time.  ");
     _maximumIterationsProp.setName("optimizer_max_iterations");
     _propertySet.append(&_maximumIterationsProp);
+
+    _useQPSolverProp.setComment("If true and activation_exponent is 2, "
+        "solve each time frame as a dense quadratic program, and use the "
+        "interior point optimizer only if that fails.");
+    _useQPSolverProp.setName("use_qp_solver");
+    _propertySet.append(&_useQPSolverProp);
+
+    _parallelProp.setComment("Solve the time frames in parallel? "
+        "0: no, solve each frame as it is recorded (default); 1: use all "
+        "cores; greater than 1: use this number of threads. The frames are "
+        "then solved at the end of the analysis; each thread solves a block "
+        "of consecutive frames with its own copy of the model, starting from "
+        "the solution of the previous frame.");
+    _parallelProp.setName("parallel");
+    _parallelProp.setValue(0);
+    _propertySet.append(&_parallelProp);
 }
 
 //=============================================================================
@@ -316,14 +343,6 @@ record(const SimTK::State& s)
     sWorkingCopy.setQ(s.getQ());
     sWorkingCopy.setU(s.getU());
 
-    _modelWorkingCopy->getMultibodySystem().realize(sWorkingCopy, SimTK::Stage::Velocity);
-    //_modelWorkingCopy->equilibrateMuscles(sWorkingCopy);
-
-    const Set<Actuator>& fs = _modelWorkingCopy->getActuators();
-
-    int na = fs.getSize();
-    int nacc = _accelerationIndices.getSize();
-
     // IPOPT
     _numericalDerivativeStepSize = 0.0001;
     _optimizerAlgorithm = "ipopt";
@@ -331,20 +350,82 @@ record(const SimTK::State& s)
     //_optimizationConvergenceTolerance = 1e-004;
     //_maxIterations = 2000;
 
+    _parameters = 0; // Set initial guess to zeros
+    solveFrame(*_modelWorkingCopy, sWorkingCopy, _parameters, *_forceReporter);
+
+    int na = _modelWorkingCopy->getActuators().getSize();
+    _activationStorage->append(sWorkingCopy.getTime(),na,&_parameters[0]);
+
+    _forceReporter->step(sWorkingCopy, 1);
+
+    return 0;
+}
+//_____________________________________________________________________________
+/**
+ * Solve the optimization problem of one time frame.
+ */
+void StaticOptimization::
+solveFrame(Model& model, SimTK::State& sWorkingCopy, SimTK::Vector& parameters,
+        ForceReporter& forceReporter) const
+{
+    model.getMultibodySystem().realize(sWorkingCopy, SimTK::Stage::Velocity);
+    //model.equilibrateMuscles(sWorkingCopy);
+
+    const Set<Actuator>& fs = model.getActuators();
+
+    int na = fs.getSize();
+    int nacc = _accelerationIndices.getSize();
+
     // Optimization target
-    _modelWorkingCopy->setAllControllersEnabled(false);
-    StaticOptimizationTarget target(sWorkingCopy,_modelWorkingCopy,na,nacc,_useMusclePhysiology);
+    model.setAllControllersEnabled(false);
+    StaticOptimizationTarget target(sWorkingCopy,&model,na,nacc,_useMusclePhysiology);
     target.setStatesStore(_statesStore);
     target.setStatesSplineSet(_statesSplineSet);
     target.setActivationExponent(_activationExponent);
     target.setDX(_numericalDerivativeStepSize);
 
+    // Parameter bounds
+    SimTK::Vector lowerBounds(na), upperBounds(na);
+    for(int i=0,j=0;i<fs.getSize();i++) {
+        ScalarActuator* act = dynamic_cast<ScalarActuator*>(&fs.get(i));
+        if (act) {
+            lowerBounds(j) = act->getMinControl();
+            upperBounds(j) = act->getMaxControl();
+            j++;
+        }
+    }
+    
+    target.setParameterLimits(lowerBounds, upperBounds);
+
+    // Static optimization
+    model.getMultibodySystem().realize(sWorkingCopy,SimTK::Stage::Velocity);
+    target.prepareToOptimize(sWorkingCopy, &parameters[0]);
+
+    //LARGE_INTEGER start;
+    //LARGE_INTEGER stop;
+    //LARGE_INTEGER frequency;
+
+    //QueryPerformanceFrequency(&frequency);
+    //QueryPerformanceCounter(&start);
+
+    target.setCurrentState( &sWorkingCopy );
+    if(_useQPSolver && _activationExponent == 2) {
+        if(target.solveQuadraticProgram(parameters) >= 0) {
+            finishFrame(model, sWorkingCopy, target, parameters);
+            return;
+        }
+        log_debug("StaticOptimization: the QP solver did not converge at "
+                  "time = {}; using the interior point optimizer.",
+                sWorkingCopy.getTime());
+    }
+
     // Pick optimizer algorithm
     SimTK::OptimizerAlgorithm algorithm = SimTK::InteriorPoint;
     //SimTK::OptimizerAlgorithm algorithm = SimTK::CFSQP;
 
     // Optimizer
-    SimTK::Optimizer *optimizer = new SimTK::Optimizer(target, algorithm);
+    std::unique_ptr<SimTK::Optimizer> optimizer(
+            new SimTK::Optimizer(target, algorithm));
 
     // Optimizer options
     //cout<<"\nSetting optimizer print level to "<<_printLevel<<".\n";
@@ -363,52 +444,25 @@ record(const SimTK::State& s)
         optimizer->setAdvancedRealOption("nlp_scaling_max_gradient",1);
     }
 
-    // Parameter bounds
-    SimTK::Vector lowerBounds(na), upperBounds(na);
-    for(int i=0,j=0;i<fs.getSize();i++) {
-        ScalarActuator* act = dynamic_cast<ScalarActuator*>(&fs.get(i));
-        if (act) {
-            lowerBounds(j) = act->getMinControl();
-            upperBounds(j) = act->getMaxControl();
-            j++;
-        }
-    }
-    
-    target.setParameterLimits(lowerBounds, upperBounds);
-
-    _parameters = 0; // Set initial guess to zeros
-
-    // Static optimization
-    _modelWorkingCopy->getMultibodySystem().realize(sWorkingCopy,SimTK::Stage::Velocity);
-    target.prepareToOptimize(sWorkingCopy, &_parameters[0]);
-
-    //LARGE_INTEGER start;
-    //LARGE_INTEGER stop;
-    //LARGE_INTEGER frequency;
-
-    //QueryPerformanceFrequency(&frequency);
-    //QueryPerformanceCounter(&start);
-
     try {
-        target.setCurrentState( &sWorkingCopy );
-        optimizer->optimize(_parameters);
+        optimizer->optimize(parameters);
     }
     catch (const SimTK::Exception::Base& ex) {
         log_warn(ex.getMessage());
         log_warn("OPTIMIZATION FAILED...");
         log_warn("StaticOptimization.record: The optimizer could not find a "
                  "solution at time = {}.",
-                s.getTime());
+                sWorkingCopy.getTime());
 
         double tolBounds = 1e-1;
         bool weakModel = false;
         string msgWeak = "The model appears too weak for static optimization.\nTry increasing the strength and/or range of the following force(s):\n";
         for(int a=0;a<na;a++) {
-            Actuator* act = dynamic_cast<Actuator*>(&_forceSet->get(a));
+            Actuator* act = dynamic_cast<Actuator*>(&model.getForceSet().get(a));
             if( act ) {
-                Muscle*  mus = dynamic_cast<Muscle*>(&_forceSet->get(a));
+                Muscle*  mus = dynamic_cast<Muscle*>(&model.getForceSet().get(a));
                 if(mus==NULL) {
-                    if(_parameters(a) < (lowerBounds(a)+tolBounds)) {
+                    if(parameters(a) < (lowerBounds(a)+tolBounds)) {
                         msgWeak += "   ";
                         msgWeak += act->getName();
                         msgWeak += " approaching lower bound of ";
@@ -417,7 +471,7 @@ record(const SimTK::State& s)
                         msgWeak += oLower.str();
                         msgWeak += "\n";
                         weakModel = true;
-                    } else if(_parameters(a) > (upperBounds(a)-tolBounds)) {
+                    } else if(parameters(a) > (upperBounds(a)-tolBounds)) {
                         msgWeak += "   ";
                         msgWeak += act->getName();
                         msgWeak += " approaching upper bound of ";
@@ -428,7 +482,7 @@ record(const SimTK::State& s)
                         weakModel = true;
                     } 
                 } else {
-                    if(_parameters(a) > (upperBounds(a)-tolBounds)) {
+                    if(parameters(a) > (upperBounds(a)-tolBounds)) {
                         msgWeak += "   ";
                         msgWeak += mus->getName();
                         msgWeak += " approaching upper bound of ";
@@ -448,9 +502,9 @@ record(const SimTK::State& s)
             bool incompleteModel = false;
             string msgIncomplete = "The model appears unsuitable for static optimization.\nTry appending the model with additional force(s) or locking joint(s) to reduce the following acceleration constraint violation(s):\n";
             SimTK::Vector constraints;
-            target.constraintFunc(_parameters,true,constraints);
+            target.constraintFunc(parameters,true,constraints);
 
-            auto coordinates = _modelWorkingCopy->getCoordinatesInMultibodyTreeOrder();
+            auto coordinates = model.getCoordinatesInMultibodyTreeOrder();
 
             for(int acc=0;acc<nacc;acc++) {
                 if(fabs(constraints(acc)) > tolConstraints) {
@@ -465,7 +519,7 @@ record(const SimTK::State& s)
                     incompleteModel = true;
                 }
             }
-            _forceReporter->step(sWorkingCopy, 1);
+            forceReporter.step(sWorkingCopy, 1);
             if(incompleteModel) log_warn(msgIncomplete);
         }
     }
@@ -474,28 +528,32 @@ record(const SimTK::State& s)
     //double duration = (double)(stop.QuadPart-start.QuadPart)/(double)frequency.QuadPart;
     //cout << "optimizer time = " << (duration*1.0e3) << " milliseconds" << endl;
 
+    finishFrame(model, sWorkingCopy, target, parameters);
+}
+//_____________________________________________________________________________
+/**
+ * Report the solution of a frame and apply its actuation to the state.
+ */
+void StaticOptimization::
+finishFrame(Model& model, SimTK::State& sWorkingCopy,
+        StaticOptimizationTarget& target, SimTK::Vector& parameters) const
+{
     if (Logger::shouldLog(Logger::Level::Info)) {
-        target.printPerformance(sWorkingCopy, &_parameters[0]);
+        target.printPerformance(sWorkingCopy, &parameters[0]);
     }
 
     //update defaults for use in the next step
 
-    const Set<Actuator>& actuators = _modelWorkingCopy->getActuators();
+    const Set<Actuator>& actuators = model.getActuators();
     for(int k=0; k < actuators.getSize(); ++k){
         ActivationFiberLengthMuscle *mus = dynamic_cast<ActivationFiberLengthMuscle*>(&actuators[k]);
         if(mus){
-            mus->setDefaultActivation(_parameters[k]);
+            mus->setDefaultActivation(parameters[k]);
         }
     }
 
-    _activationStorage->append(sWorkingCopy.getTime(),na,&_parameters[0]);
-
-    SimTK::Vector forces(na);
-    target.getActuation(const_cast<SimTK::State&>(sWorkingCopy), _parameters,forces);
-
-    _forceReporter->step(sWorkingCopy, 1);
-
-    return 0;
+    SimTK::Vector forces(actuators.getSize());
+    target.getActuation(sWorkingCopy, parameters, forces);
 }
 //_____________________________________________________________________________
 /**
@@ -512,6 +570,12 @@ int StaticOptimization::begin(const SimTK::State& s )
 {
     if(!proceed()) return(0);
 
+    OPENSIM_THROW_IF_FRMOBJ(_parallel < 0, Exception,
+        "Expected parallel to be non-negative, but got {}.", _parallel);
+    _pendingTimes.clear();
+    _pendingQs.clear();
+    _pendingUs.clear();
+
     // Make a working copy of the model
     delete _modelWorkingCopy;
     _modelWorkingCopy = _model->clone();
@@ -646,7 +710,13 @@ int StaticOptimization::step(const SimTK::State& s, int stepNumber )
 {
     if(!proceed(stepNumber)) return(0);
 
-    record(s);
+    if(_parallel > 0) {
+        _pendingTimes.push_back(s.getTime());
+        _pendingQs.push_back(s.getQ());
+        _pendingUs.push_back(s.getU());
+    } else {
+        record(s);
+    }
 
     return(0);
 }
@@ -663,10 +733,98 @@ int StaticOptimization::end( const SimTK::State& s )
 {
     if(!proceed()) return(0);
 
-    record(s);
+    if(_parallel > 0) {
+        _pendingTimes.push_back(s.getTime());
+        _pendingQs.push_back(s.getQ());
+        _pendingUs.push_back(s.getU());
+        recordPendingFrames();
+    } else {
+        record(s);
+    }
 
     return(0);
 }
+//_____________________________________________________________________________
+/**
+ * Solve the frames recorded by step() and end() concurrently.
+ *
+ * The first frame was solved by begin() on the working model, so that anything
+ * the model sets up on first use is not set up concurrently.
+ */
+void StaticOptimization::recordPendingFrames()
+{
+    const int nf = (int)_pendingTimes.size();
+    if(!_modelWorkingCopy || nf == 0) return;
+
+    int numThreads = _parallel;
+    if(numThreads == 1) {
+        numThreads = static_cast<int>(std::thread::hardware_concurrency());
+    }
+    const int numBlocks = std::max(1, std::min(numThreads, nf));
+
+    // Copy and initialize the models on this thread; copying a model can
+    // read files (e.g., the data of ExternalLoads).
+    struct Block {
+        int begin;
+        int end;
+        std::unique_ptr<Model> model;
+        std::unique_ptr<ForceReporter> forceReporter;
+        std::vector<SimTK::Vector> parameters;
+    };
+    std::vector<Block> blocks(numBlocks);
+    for(int b = 0; b < numBlocks; ++b) {
+        Block& block = blocks[b];
+        block.begin = (int)((long long)b * nf / numBlocks);
+        block.end = (int)((long long)(b + 1) * nf / numBlocks);
+        block.model.reset(_modelWorkingCopy->clone());
+        block.model->updAnalysisSet().clearAndDestroy();
+        SimTK::State& state = block.model->initSystem();
+        const Set<Actuator>& actuators = block.model->getActuators();
+        for(int i = 0; i < actuators.getSize(); ++i) {
+            ScalarActuator* act = dynamic_cast<ScalarActuator*>(&actuators[i]);
+            if(act) act->overrideActuation(state, true);
+        }
+        block.forceReporter.reset(new ForceReporter(block.model.get()));
+        block.forceReporter->begin(state);
+        block.forceReporter->updForceStorage().reset();
+        block.parameters.resize(block.end - block.begin);
+    }
+
+    parallelFor(numBlocks, [&](int b) {
+        Block& block = blocks[b];
+        SimTK::State& state = block.model->updWorkingState();
+        SimTK::Vector parameters(_parameters.size(), 0.0);
+        for(int i = block.begin; i < block.end; ++i) {
+            state.setTime(_pendingTimes[i]);
+            block.model->initStateWithoutRecreatingSystem(state);
+            state.setQ(_pendingQs[i]);
+            state.setU(_pendingUs[i]);
+            // Start from the solution of the previous frame.
+            solveFrame(*block.model, state, parameters,
+                    *block.forceReporter);
+            block.parameters[i - block.begin] = parameters;
+            block.forceReporter->step(state, 1);
+        }
+    }, numBlocks);
+
+    // Record the results in order.
+    Storage& forceStorage = _forceReporter->updForceStorage();
+    for(const auto& block : blocks) {
+        for(int i = block.begin; i < block.end; ++i) {
+            const SimTK::Vector& parameters = block.parameters[i - block.begin];
+            _activationStorage->append(_pendingTimes[i], parameters.size(),
+                    &parameters[0]);
+        }
+        const Storage& blockForces = block.forceReporter->getForceStorage();
+        for(int i = 0; i < blockForces.getSize(); ++i) {
+            forceStorage.append(*blockForces.getStateVector(i));
+        }
+    }
+    _parameters = blocks.back().parameters.back();
+    _pendingTimes.clear();
+    _pendingQs.clear();
+    _pendingUs.clear();
+}
 
 
 //=============================================================================
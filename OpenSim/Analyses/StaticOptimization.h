@@ -29,6 +29,7 @@
 //=============================================================================
 #include "osimAnalysesDLL.h"
 #include <memory>
+#include <vector>
 #include <OpenSim/Simulation/Model/Analysis.h>
 #include <OpenSim/Common/GCVSplineSet.h>
 #include "ForceReporter.h"
@@ -41,6 +42,7 @@ namespace OpenSim {
 
 class Model;
 class ForceSet;
+class StaticOptimizationTarget;
 
 /**
  * This class implements static optimization to compute Muscle Forces and 
@@ -76,6 +78,17 @@ protected:
     PropertyInt _maximumIterationsProp;
     int &_maximumIterations;
 
+    /** Solve each frame with a dense quadratic programming solver if the
+        activation exponent is 2, using the optimizer only if it fails. */
+    PropertyBool _useQPSolverProp;
+    bool &_useQPSolver;
+
+    /** Solve the time frames concurrently, once all of them have been
+        recorded: 0 (default) solves each frame as it is recorded, 1 uses all
+        hardware threads, greater than 1 uses this number of threads. */
+    PropertyInt _parallelProp;
+    int &_parallel;
+
     Storage *_activationStorage;
     Storage *_forceStorage;
     GCVSplineSet _statesSplineSet;
@@ -93,6 +106,12 @@ protected:
 
     Model *_modelWorkingCopy;
 
+    // Frames recorded by step() and end() but not yet solved, if solving in
+    // parallel.
+    std::vector<double> _pendingTimes;
+    std::vector<SimTK::Vector> _pendingQs;
+    std::vector<SimTK::Vector> _pendingUs;
+
 //=============================================================================
 // METHODS
 //=============================================================================
@@ -114,6 +133,19 @@ private:
     void constructColumnLabels();
     void allocateStorage();
     void deleteStorage();
+    /** Solve for the activations of the frame given by `s` (a state of
+        `model`, a copy of the working model), starting from `parameters`,
+        which hold the solution on return. The actuation of the solution is
+        applied to `s`, and recorded by `forceReporter` if the optimizer
+        fails. */
+    void solveFrame(Model& model, SimTK::State& s, SimTK::Vector& parameters,
+            ForceReporter& forceReporter) const;
+    void finishFrame(Model& model, SimTK::State& s,
+            StaticOptimizationTarget& target,
+            SimTK::Vector& parameters) const;
+    /** Solve the pending frames in blocks of consecutive frames, each on its
+        own copy of the working model, and record them in order. */
+    void recordPendingFrames();
 
 public:
     //--------------------------------------------------------------------------
@@ -135,6 +167,19 @@ public:
     double getConvergenceCriterion() { return _convergenceCriterion; }
     void setMaxIterations( const int maxIt) { _maximumIterations = maxIt; }
     int getMaxIterations() {return _maximumIterations; }
+    /** If true (default) and the activation exponent is 2, each frame is
+        solved as a dense quadratic program (see
+        StaticOptimizationTarget::solveQuadraticProgram()); the interior point
+        optimizer is used only for frames where that fails. */
+    void setUseQPSolver(bool useIt) { _useQPSolver = useIt; }
+    bool getUseQPSolver() const { return _useQPSolver; }
+    /** 0: solve each time frame as it is recorded; 1: solve the frames
+        concurrently on all hardware threads at end(); greater than 1: use
+        this number of threads. Each thread solves a block of consecutive
+        frames with its own copy of the model, starting the optimizer at each
+        frame from the solution of the previous frame of the block. */
+    void setParallel(int parallel) { _parallel = parallel; }
+    int getParallel() const { return _parallel; }
     //--------------------------------------------------------------------------
     // ANALYSIS
     //--------------------------------------------------------------------------
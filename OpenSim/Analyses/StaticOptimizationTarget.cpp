@@ -30,8 +30,14 @@
 // INCLUDES
 //=============================================================================
 #include <OpenSim/Simulation/Model/Model.h>
+#include <OpenSim/Simulation/Model/PathActuator.h>
+#include <OpenSim/Actuators/CoordinateActuator.h>
 #include "StaticOptimizationTarget.h"
 
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
 using namespace OpenSim;
 using namespace std;
 using SimTK::Vector;
@@ -127,17 +133,176 @@ prepareToOptimize(SimTK::State& s, double *x)
     pVector = 0;
     computeConstraintVector(s, pVector,_constraintVector);
 
-    for(int p=0; p<np; p++) {
-        pVector[p] = 1;
-        computeConstraintVector(s, pVector, cVector);
-        for(int c=0; c<nc; c++) _constraintMatrix(c,p) = (cVector[c] - _constraintVector[c]);
-        pVector[p] = 0;
+    // The accelerations are affine in the actuator forces, so column p is
+    // the change in accelerations caused by actuator p alone. For path and
+    // coordinate actuators, apply the forces of a unit actuation and solve
+    // for the accelerations with the matter subsystem alone (including
+    // constraints), instead of realizing all the forces of the model again.
+    const SimTK::SimbodyMatterSubsystem& matter = _model->getMatterSubsystem();
+    Vector mobilityForces(s.getNU(), 0.0);
+    SimTK::Vector_<SimTK::SpatialVec> bodyForces(matter.getNumBodies(),
+            SimTK::SpatialVec(SimTK::Vec3(0), SimTK::Vec3(0)));
+    SimTK::Vector_<SimTK::SpatialVec> bodyAccelerations;
+    Vector udotZero, udot;
+    matter.calcAcceleration(s, mobilityForces, bodyForces, udotZero,
+            bodyAccelerations);
+
+    for(int i=0, p=0; i<fSet.getSize(); i++) {
+        ScalarActuator* act = dynamic_cast<ScalarActuator*>(&fSet.get(i));
+        if(!act) continue;
+        const PathActuator* pathAct = dynamic_cast<PathActuator*>(act);
+        const CoordinateActuator* coordAct =
+                dynamic_cast<CoordinateActuator*>(act);
+        const Coordinate* coord = coordAct ? coordAct->getCoordinate() : nullptr;
+        if(!act->appliesForce(s)) {
+            for(int c=0; c<nc; c++) _constraintMatrix(c,p) = 0;
+        } else if(pathAct || coord) {
+            if(pathAct) {
+                pathAct->getGeometryPath().addInEquivalentForces(
+                        s, 1.0, bodyForces, mobilityForces);
+            } else {
+                matter.addInMobilityForce(s, coord->getBodyIndex(),
+                        SimTK::MobilizerUIndex(coord->getMobilizerQIndex()),
+                        1.0, mobilityForces);
+            }
+            matter.calcAcceleration(s, mobilityForces, bodyForces, udot,
+                    bodyAccelerations);
+            for(int c=0; c<nc; c++) {
+                const int u = _accelerationIndices[c];
+                _constraintMatrix(c,p) =
+                        -_optimalForce[p] * (udot[u] - udotZero[u]);
+            }
+            mobilityForces = 0;
+            bodyForces = SimTK::SpatialVec(SimTK::Vec3(0), SimTK::Vec3(0));
+        } else {
+            pVector[p] = 1;
+            computeConstraintVector(s, pVector, cVector);
+            for(int c=0; c<nc; c++) _constraintMatrix(c,p) = (cVector[c] - _constraintVector[c]);
+            pVector[p] = 0;
+        }
+        p++;
     }
 #endif
 
     // return false to indicate that we still need to proceed with optimization
     return false;
 }
+//==============================================================================
+// QUADRATIC PROGRAM
+//==============================================================================
+namespace {
+// Overwrite the lower triangle of the symmetric positive definite matrix M
+// with its Cholesky factor L, and b with the solution of M x = b. Returns
+// false if M is not (numerically) positive definite.
+bool solveCholesky(Matrix& M, Vector& b)
+{
+    const int n = M.nrow();
+    for (int j = 0; j < n; ++j) {
+        double d = M(j, j);
+        for (int k = 0; k < j; ++k) d -= M(j, k) * M(j, k);
+        if (!(d > 0)) return false;
+        M(j, j) = std::sqrt(d);
+        for (int i = j + 1; i < n; ++i) {
+            double sum = M(i, j);
+            for (int k = 0; k < j; ++k) sum -= M(i, k) * M(j, k);
+            M(i, j) = sum / M(j, j);
+        }
+    }
+    for (int i = 0; i < n; ++i) {
+        for (int k = 0; k < i; ++k) b[i] -= M(i, k) * b[k];
+        b[i] /= M(i, i);
+    }
+    for (int i = n - 1; i >= 0; --i) {
+        for (int k = i + 1; k < n; ++k) b[i] -= M(k, i) * b[k];
+        b[i] /= M(i, i);
+    }
+    return true;
+}
+}
+
+int StaticOptimizationTarget::
+solveQuadraticProgram(Vector& x, int maxIterations) const
+{
+    // minimize 1/2 |p|^2 subject to A p = b and lower <= p <= upper, where
+    // the constraints are A p - b = _constraintMatrix p + _constraintVector.
+    // For multipliers y of the equality constraints, the p that minimizes the
+    // Lagrangian is p(y) = clamp(A^T y) and the (concave) dual function is
+    //     g(y) = y^T b - y^T A p(y) + 1/2 |p(y)|^2,
+    // whose gradient is the constraint residual r(y) = b - A p(y). Newton
+    // steps use the generalized Hessian A_F A_F^T, where F are the
+    // parameters that are not at their limits.
+    const int np = getNumParameters();
+    const int nc = getNumConstraints();
+    double *lower = nullptr, *upper = nullptr;
+    getParameterLimits(&lower, &upper);
+    if (lower == nullptr || upper == nullptr) return -1;
+
+    const Matrix& A = _constraintMatrix;
+    Vector b = -_constraintVector;
+    const double tolerance = 1e-9 * (1 + b.normInf());
+
+    Vector y(nc, 0.0), p(np), Aty(np), r(nc), d(nc), yTrial(nc);
+    Matrix M(nc, nc);
+    std::vector<bool> isFree(np);
+
+    // Evaluate p(y), r(y) and g(y) for the multipliers y.
+    auto evaluate = [&](const Vector& y, double& g) {
+        Aty = ~A * y;
+        for (int j = 0; j < np; ++j) {
+            p[j] = std::min(std::max(Aty[j], lower[j]), upper[j]);
+            isFree[j] = Aty[j] > lower[j] && Aty[j] < upper[j];
+        }
+        r = b - A * p;
+        g = ~y * b - ~y * (b - r) + 0.5 * p.normSqr();
+    };
+
+    double g;
+    evaluate(y, g);
+    for (int iter = 0; iter <= maxIterations; ++iter) {
+        if (r.normInf() <= tolerance) {
+            x = p;
+            return iter;
+        }
+        if (iter == maxIterations) break;
+
+        // Generalized Hessian, regularized in case fewer parameters than
+        // constraints are free.
+        M = 0;
+        for (int j = 0; j < np; ++j) {
+            if (!isFree[j]) continue;
+            for (int c1 = 0; c1 < nc; ++c1) {
+                const double a = A(c1, j);
+                if (a == 0) continue;
+                for (int c2 = 0; c2 <= c1; ++c2) M(c1, c2) += a * A(c2, j);
+            }
+        }
+        double trace = 0;
+        for (int c = 0; c < nc; ++c) trace += M(c, c);
+        const double regularization = 1e-12 * (trace / nc) + 1e-14;
+        for (int c = 0; c < nc; ++c) M(c, c) += regularization;
+        d = r;
+        if (!solveCholesky(M, d)) break;
+
+        // Backtrack until the dual function increases sufficiently.
+        const double slope = ~r * d;
+        double step = 1;
+        double gTrial = g;
+        bool accepted = false;
+        for (int k = 0; k < 40; ++k, step *= 0.5) {
+            yTrial = y + step * d;
+            evaluate(yTrial, gTrial);
+            if (gTrial >= g + 1e-4 * step * slope) {
+                accepted = true;
+                break;
+            }
+        }
+        if (!accepted) break;
+        y = yTrial;
+        g = gTrial;
+    }
+    return -1;
+}
+
 //==============================================================================
 // SET AND GET
 //==============================================================================
@@ -467,8 +632,12 @@ objectiveFunc(const Vector &parameters, const bool new_parameters, Real &perform
 
     int na = _model->getActuators().getSize();
     double p = 0.0;
-    for(int i=0;i<na;i++) {
-            p +=  pow(fabs(parameters[i]),_activationExponent);
+    if(_activationExponent == 2) {
+        for(int i=0;i<na;i++) p += parameters[i] * parameters[i];
+    } else {
+        for(int i=0;i<na;i++) {
+                p +=  pow(fabs(parameters[i]),_activationExponent);
+        }
     }
     performance = p;
 
@@ -502,6 +671,10 @@ gradientFunc(const Vector &parameters, const bool new_parameters, Vector &gradie
     //QueryPerformanceCounter(&start);
 
     int na = _model->getActuators().getSize();
+    if(_activationExponent == 2) {
+        for(int i=0;i<na;i++) gradient[i] = 2.0 * parameters[i];
+        return(0);
+    }
     for(int i=0;i<na;i++) {
         if(parameters[i] < 0) {
             gradient[i] =  -1.0 * _activationExponent * pow(fabs(parameters[i]),_activationExponent-1.0);
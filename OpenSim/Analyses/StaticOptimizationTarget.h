@@ -113,6 +113,19 @@ public:
 
     bool prepareToOptimize(SimTK::State& s, double *x);
 
+    /** Solve the problem directly as a dense quadratic program, which it is
+    when the activation exponent is 2: minimize the sum of squared parameters
+    subject to the (linear) acceleration constraints and the parameter
+    limits. This uses a semismooth Newton method on the dual problem, whose
+    variables are the multipliers of the acceleration constraints; each
+    iteration solves a system the size of the number of constraints. Call
+    prepareToOptimize() and setParameterLimits() first.
+
+    @returns the number of iterations, or -1 if the method did not converge
+    (e.g., the constraints cannot be met within the limits), in which case x
+    is unchanged. */
+    int solveQuadraticProgram(SimTK::Vector& x, int maxIterations = 50) const;
+
     //--------------------------------------------------------------------------
     // REQUIRED OPTIMIZATION TARGET METHODS
     //--------------------------------------------------------------------------
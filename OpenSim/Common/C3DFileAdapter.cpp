@@ -1,5 +1,8 @@
 #include "C3DFileAdapter.h"
 
+#include <algorithm>
+#include <cmath>
+
 #ifdef WITH_EZC3D
 #include "ezc3d_all.h"
 #else
@@ -59,6 +62,79 @@ convertToSimtkMatrix(const Eigen::Matrix<_Scalar, _Rows, _Cols>&
     return simtkMat;
 }
 #endif
+
+// Indices of the requested labels within all the labels in the file, in the
+// requested order. All indices are returned if no labels are requested.
+std::vector<int>
+findIndicesOfLabels(const std::vector<std::string>& allLabels,
+                    const std::vector<std::string>& requested,
+                    const std::string& fileName) {
+    std::vector<int> indices{};
+    if(requested.empty()) {
+        for(int i = 0; i < (int)allLabels.size(); ++i)
+            indices.push_back(i);
+        return indices;
+    }
+    for(const auto& label : requested) {
+        const auto it = std::find(allLabels.begin(), allLabels.end(), label);
+        OPENSIM_THROW_IF(it == allLabels.end(), OpenSim::Exception,
+                "Marker '" + label + "' not found in file '" + fileName +
+                "'.");
+        indices.push_back(static_cast<int>(it - allLabels.begin()));
+    }
+    return indices;
+}
+
+// Zero-based indices of the requested force platforms, which are numbered
+// from 1. All platforms are returned if no platforms are requested.
+std::vector<int>
+findForcePlatformIndices(int numPlatforms,
+                         const std::vector<int>& requested,
+                         const std::string& fileName) {
+    std::vector<int> indices{};
+    if(requested.empty()) {
+        for(int i = 0; i < numPlatforms; ++i)
+            indices.push_back(i);
+        return indices;
+    }
+    for(const auto& platform : requested) {
+        OPENSIM_THROW_IF(platform < 1 || platform > numPlatforms,
+                OpenSim::Exception,
+                "Force platform " + std::to_string(platform) +
+                " not found in file '" + fileName + "', which has " +
+                std::to_string(numPlatforms) + " force platform(s).");
+        indices.push_back(platform - 1);
+    }
+    return indices;
+}
+
+// First and last (inclusive) frames whose times, frame * timeStep, are within
+// [initialTime, finalTime]. The range is empty if last < first.
+void findFrameRange(int numFrames, double timeStep,
+                    double initialTime, double finalTime,
+                    int& first, int& last) {
+    // Tolerance, in frames, for times that fall on a frame.
+    const double tol = 1e-6;
+    first = 0;
+    last = numFrames - 1;
+    if(initialTime > 0)
+        first = static_cast<int>(std::min<double>(numFrames,
+                        std::ceil(initialTime / timeStep - tol)));
+    if(finalTime < (numFrames - 1) * timeStep)
+        last = static_cast<int>(std::max<double>(-1,
+                        std::floor(finalTime / timeStep + tol)));
+}
+
+// Keep the elements of a vector at the given indices, in the given order.
+template <typename T>
+std::vector<T> selectElements(const std::vector<T>& all,
+                              const std::vector<int>& indices) {
+    std::vector<T> selected{};
+    selected.reserve(indices.size());
+    for(const auto& index : indices)
+        selected.push_back(all[index]);
+    return selected;
+}
 } // anonymous namespace
 
 
@@ -125,39 +201,54 @@ C3DFileAdapter::extendRead(const std::string& fileName) const {
 
     if(numMarkers != 0) {
 
-        int marker_nrow = numFrames;
-        int marker_ncol = numMarkers;
-
-        std::vector<double> marker_times(marker_nrow);
-        SimTK::Matrix_<SimTK::Vec3> marker_matrix(marker_nrow, marker_ncol);
-
-        std::vector<std::string> marker_labels{};
-        for (auto label : c3d.parameters().group("POINT")
+        std::vector<std::string> all_marker_labels{};
+        for (const auto& label : c3d.parameters().group("POINT")
                 .parameter("LABELS").valuesAsString()) {
-            marker_labels.push_back(SimTK::Value<std::string>(label));
+            all_marker_labels.push_back(label);
         }
+        OPENSIM_THROW_IF((int)all_marker_labels.size() != numMarkers,
+                Exception,
+                "Expected " + std::to_string(numMarkers) + " marker labels "
+                "in file '" + fileName + "' but found " +
+                std::to_string(all_marker_labels.size()) + ".");
+
+        // Only the requested markers and frames are converted.
+        const auto marker_indices = findIndicesOfLabels(all_marker_labels,
+                _markersToRead, fileName);
+        const auto marker_labels = selectElements(all_marker_labels,
+                marker_indices);
 
         double time_step{1.0 / pointFrequency};
-        for(int f = 0; f < marker_nrow; ++f) {
-            SimTK::RowVector_<SimTK::Vec3> row{ numMarkers,
-                                                SimTK::Vec3(SimTK::NaN) };
-            int m{0};
+        int first_frame, last_frame;
+        findFrameRange(numFrames, time_step, _initialTime, _finalTime,
+                first_frame, last_frame);
+
+        int marker_nrow = std::max(0, last_frame - first_frame + 1);
+        int marker_ncol = static_cast<int>(marker_indices.size());
+
+        std::vector<double> marker_times(marker_nrow);
+        SimTK::Matrix_<SimTK::Vec3> marker_matrix(marker_nrow, marker_ncol,
+                                                  SimTK::Vec3(SimTK::NaN));
+
+        for(int r = 0; r < marker_nrow; ++r) {
+            const int f = first_frame + r;
+            const auto& points = c3d.data().frame(f).points().points();
             // C3D standard is to read empty values as zero, but sets a
             // "residual" value to -1 and it is how it knows to export these
             // values as blank, instead of 0,  when exporting to .trc
             // See: C3D documention 3D Point Residuals
             // Read in value if it is not zero or residual is not -1
-            for(auto pt : c3d.data().frame(f).points().points()) {
+            for(int m = 0; m < marker_ncol; ++m) {
+                const auto& pt = points[marker_indices[m]];
                 if (!pt.isEmpty() ) {//residual is not -1
-                    row[m] = SimTK::Vec3{ static_cast<double>(pt.x()),
-                                          static_cast<double>(pt.y()),
-                                          static_cast<double>(pt.z()) };
+                    marker_matrix(r, m) = 
+                            SimTK::Vec3{ static_cast<double>(pt.x()),
+                                         static_cast<double>(pt.y()),
+                                         static_cast<double>(pt.z()) };
                 }
-                ++m;
             }
 
-            marker_matrix.updRow(f) = row;
-            marker_times[f] = 0 + f * time_step; //TODO: 0 should be start_time
+            marker_times[r] = 0 + f * time_step; //TODO: 0 should be start_time
         }
 
         // Create the data
@@ -203,10 +294,14 @@ C3DFileAdapter::extendRead(const std::string& fileName) const {
     const auto& force_platforms_extractor = ezc3d::Modules::ForcePlatforms(c3d);
 
     ForceLocation forceLocation(getLocationForForceExpression());
-    auto numPlatform(static_cast<int>(
-                             force_platforms_extractor.forcePlatforms().size()));
+    const auto& pf_ref(force_platforms_extractor.forcePlatforms());
+    // Only the requested platforms are converted.
+    const auto platform_indices = findForcePlatformIndices(
+            static_cast<int>(pf_ref.size()), _forcePlatformsToRead, fileName);
+    auto numPlatform(static_cast<int>(platform_indices.size()));
 
-    for (const auto& platform : force_platforms_extractor.forcePlatforms()){
+    for (const auto& ip : platform_indices){
+        const auto& platform = pf_ref[ip];
 
         const auto& calMatrix = platform.calMatrix();
         const auto& corners   = platform.corners();
@@ -231,15 +326,12 @@ C3DFileAdapter::extendRead(const std::string& fileName) const {
         }
         std::vector<std::string> labels{};
         ValueArray<std::string> units{};
-        for(int fp = 1; fp <= numPlatform; ++fp) {
-            auto fp_str = std::to_string(fp);
+        for(const auto& ip : platform_indices) {
+            auto fp_str = std::to_string(ip + 1);
 
-            auto force_unit =
-                    force_platforms_extractor.forcePlatform(fp-1).forceUnit();
-            auto position_unit =
-                    force_platforms_extractor.forcePlatform(fp-1).positionUnit();
-            auto moment_unit =
-                    force_platforms_extractor.forcePlatform(fp-1).momentUnit();
+            auto force_unit = pf_ref[ip].forceUnit();
+            auto position_unit = pf_ref[ip].positionUnit();
+            auto moment_unit = pf_ref[ip].momentUnit();
 
             labels.push_back(SimTK::Value<std::string>("f" + fp_str));
             units.upd().push_back(SimTK::Value<std::string>(force_unit));
@@ -251,42 +343,48 @@ C3DFileAdapter::extendRead(const std::string& fileName) const {
             units.upd().push_back(SimTK::Value<std::string>(moment_unit));
         }
 
-        const int nf = static_cast<int>(force_platforms_extractor.forcePlatform(0).nbFrames());
+        const int nf = static_cast<int>(
+                pf_ref[platform_indices.front()].nbFrames());
         auto analogFrequency = static_cast<double>(c3d.header().frameRate()
                                                    * c3d.header().nbAnalogByFrame());
-        const auto& pf_ref(force_platforms_extractor.forcePlatforms());
-
-        std::vector<double> force_times(nf);
-        SimTK::Matrix_<SimTK::Vec3> force_matrix(nf, (int)labels.size());
 
         double time_step{1.0 / analogFrequency};
+        int first_frame, last_frame;
+        findFrameRange(nf, time_step, _initialTime, _finalTime,
+                first_frame, last_frame);
+        const int force_nrow = std::max(0, last_frame - first_frame + 1);
 
-        for(int f = 0; f < nf;  ++f) {
-            SimTK::RowVector_<SimTK::Vec3>
-                    row{numPlatform * 3};
+        std::vector<double> force_times(force_nrow);
+        SimTK::Matrix_<SimTK::Vec3> force_matrix(force_nrow, (int)labels.size());
+
+        for(int r = 0; r < force_nrow;  ++r) {
+            const int f = first_frame + r;
             int col{0};
-            for (size_t i = 0; i < (size_t)numPlatform; ++i){
-                row[col] = SimTK::Vec3{pf_ref[i].forces()[f](0),
-                                       pf_ref[i].forces()[f](1),
-                                       pf_ref[i].forces()[f](2)};
+            for (const auto& ip : platform_indices){
+                const auto& platform = pf_ref[ip];
+                force_matrix(r, col) = SimTK::Vec3{platform.forces()[f](0),
+                                                   platform.forces()[f](1),
+                                                   platform.forces()[f](2)};
                 ++col;
                 if (forceLocation == ForceLocation::CenterOfPressure){
-                    row[col] = SimTK::Vec3{pf_ref[i].CoP()[f](0),
-                                           pf_ref[i].CoP()[f](1),
-                                           pf_ref[i].CoP()[f](2)};
+                    force_matrix(r, col) = SimTK::Vec3{platform.CoP()[f](0),
+                                                       platform.CoP()[f](1),
+                                                       platform.CoP()[f](2)};
                     ++col;
-                    row[col] = SimTK::Vec3{pf_ref[i].Tz()[f](0),
-                                           pf_ref[i].Tz()[f](1),
-                                           pf_ref[i].Tz()[f](2)};
+                    force_matrix(r, col) = SimTK::Vec3{platform.Tz()[f](0),
+                                                       platform.Tz()[f](1),
+                                                       platform.Tz()[f](2)};
                     ++col;
                 } else if (forceLocation == ForceLocation::OriginOfForcePlate){
-                    row[col] = SimTK::Vec3{pf_ref[i].meanCorners()(0),
-                                           pf_ref[i].meanCorners()(1),
-                                           pf_ref[i].meanCorners()(2)};
+                    force_matrix(r, col) = 
+                            SimTK::Vec3{platform.meanCorners()(0),
+                                        platform.meanCorners()(1),
+                                        platform.meanCorners()(2)};
                     ++col;
-                    row[col] = SimTK::Vec3{pf_ref[i].moments()[f](0),
-                                           pf_ref[i].moments()[f](1),
-                                           pf_ref[i].moments()[f](2)};
+                    force_matrix(r, col) = 
+                            SimTK::Vec3{platform.moments()[f](0),
+                                        platform.moments()[f](1),
+                                        platform.moments()[f](2)};
                     ++col;
                 } else {
                     OPENSIM_THROW(Exception,
@@ -294,8 +392,7 @@ C3DFileAdapter::extendRead(const std::string& fileName) const {
                                   "implemented for ezc3d files");
                 }
             }
-            force_matrix.updRow(f) = row;
-            force_times[f] = 0 + f * time_step; //TODO: 0 should be start_time
+            force_times[r] = 0 + f * time_step; //TODO: 0 should be start_time
         }
 
         auto&  force_table =
@@ -378,41 +475,53 @@ C3DFileAdapter::extendRead(const std::string& fileName) const {
 
     if(numMarkers != 0) {
 
-        int marker_nrow = numFrames;
-        int marker_ncol = numMarkers;
-
-        std::vector<double> marker_times(marker_nrow);
-        SimTK::Matrix_<SimTK::Vec3> marker_matrix(marker_nrow, marker_ncol);
-
-        std::vector<std::string> marker_labels{};
+        std::vector<btk::Point::Pointer> all_marker_pts{};
+        std::vector<std::string> all_marker_labels{};
         for (auto it = marker_pts->Begin(); it != marker_pts->End(); ++it) {
-            marker_labels.push_back(SimTK::Value<std::string>((*it)->GetLabel()));
+            all_marker_pts.push_back(*it);
+            all_marker_labels.push_back((*it)->GetLabel());
         }
 
+        // Only the requested markers and frames are converted.
+        const auto marker_indices = findIndicesOfLabels(all_marker_labels,
+                _markersToRead, fileName);
+        const auto selected_pts = selectElements(all_marker_pts,
+                marker_indices);
+        const auto marker_labels = selectElements(all_marker_labels,
+                marker_indices);
+
         double time_step{1.0 / pointFrequency};
-        for(int f = 0; f < marker_nrow; ++f) {
-            SimTK::RowVector_<SimTK::Vec3> row{ numMarkers,
-                                                SimTK::Vec3(SimTK::NaN) };
-            int m{0};
+        int first_frame, last_frame;
+        findFrameRange(numFrames, time_step, _initialTime, _finalTime,
+                first_frame, last_frame);
+
+        int marker_nrow = std::max(0, last_frame - first_frame + 1);
+        int marker_ncol = static_cast<int>(selected_pts.size());
+
+        std::vector<double> marker_times(marker_nrow);
+        SimTK::Matrix_<SimTK::Vec3> marker_matrix(marker_nrow, marker_ncol,
+                                                  SimTK::Vec3(SimTK::NaN));
+
+        for(int r = 0; r < marker_nrow; ++r) {
+            const int f = first_frame + r;
             // C3D standard is to read empty values as zero, but sets a
             // "residual" value to -1 and it is how it knows to export these
             // values as blank, instead of 0,  when exporting to .trc
             // See: C3D documention 3D Point Residuals
             // Read in value if it is not zero or residual is not -1
-            for(auto it = marker_pts->Begin();  it != marker_pts->End(); ++it) {
+            for(int m = 0; m < marker_ncol; ++m) {
                 // See: BTKCore/Code/IO/btkTRCFileIO.cpp#L359-L360
-                auto pt = *it;
+                const auto& pt = selected_pts[m];
                 if (!pt->GetValues().row(f).isZero() ||    //not precisely zero
                     (pt->GetResiduals().coeff(f) != -1) ) {//residual is not -1
-                    row[m] = SimTK::Vec3{ pt->GetValues().coeff(f, 0),
-                                          pt->GetValues().coeff(f, 1),
-                                          pt->GetValues().coeff(f, 2) };
+                    marker_matrix(r, m) =
+                            SimTK::Vec3{ pt->GetValues().coeff(f, 0),
+                                         pt->GetValues().coeff(f, 1),
+                                         pt->GetValues().coeff(f, 2) };
                 }
-                ++m;
             }
 
-            marker_matrix.updRow(f) = row;
-            marker_times[f] = 0 + f * time_step; //TODO: 0 should be start_time
+            marker_times[r] = 0 + f * time_step; //TODO: 0 should be start_time
         }
 
         // Create the data
@@ -458,13 +567,23 @@ C3DFileAdapter::extendRead(const std::string& fileName) const {
     auto   fp_moment_pts = btk::PointCollection::New();
     auto fp_position_pts = btk::PointCollection::New();
 
+    std::vector<btk::ForcePlatform::Pointer> all_platforms{};
     for(auto platform = force_platform_collection->Begin();
         platform != force_platform_collection->End();
         ++platform) {
-        const auto& calMatrix = (*platform)->GetCalMatrix();
-        const auto& corners   = (*platform)->GetCorners();
-        const auto& origins   = (*platform)->GetOrigin();
-        auto type = (*platform)->GetType();
+        all_platforms.push_back(*platform);
+    }
+    // Only the requested platforms are converted.
+    const auto platform_indices = findForcePlatformIndices(
+            static_cast<int>(all_platforms.size()), _forcePlatformsToRead,
+            fileName);
+
+    for(const auto& ip : platform_indices) {
+        const auto& platform = all_platforms[ip];
+        const auto& calMatrix = platform->GetCalMatrix();
+        const auto& corners   = platform->GetCorners();
+        const auto& origins   = platform->GetOrigin();
+        auto type = platform->GetType();
 
         fpCalMatrices.push_back(convertToSimtkMatrix(calMatrix));
         fpCorners.push_back(convertToSimtkMatrix(corners));
@@ -476,7 +595,7 @@ C3DFileAdapter::extendRead(const std::string& fileName) const {
             btk::GroundReactionWrenchFilter::New();
         ground_reaction_wrench_filter->setLocation(
             btk::GroundReactionWrenchFilter::Location(getLocationForForceExpression()));
-        ground_reaction_wrench_filter->SetInput(*platform);
+        ground_reaction_wrench_filter->SetInput(platform);
         auto wrench_collection = ground_reaction_wrench_filter->GetOutput();
         ground_reaction_wrench_filter->Update();
         
@@ -496,8 +615,8 @@ C3DFileAdapter::extendRead(const std::string& fileName) const {
     if(numPlatform != 0) {
         std::vector<std::string> labels{};
         ValueArray<std::string> units{};
-        for(int fp = 1; fp <= numPlatform; ++fp) {
-            auto fp_str = std::to_string(fp);
+        for(const auto& ip : platform_indices) {
+            auto fp_str = std::to_string(ip + 1);
 
             auto force_unit = acquisition->GetPointUnits().
                     at(_unit_index.at("force"));
@@ -519,12 +638,18 @@ C3DFileAdapter::extendRead(const std::string& fileName) const {
         const int nf = fp_force_pts->GetFrontItem()->GetFrameNumber();
         auto analogFrequency = acquisition->GetAnalogFrequency();
 
-        std::vector<double> force_times(nf);
-        SimTK::Matrix_<SimTK::Vec3> force_matrix(nf, (int)labels.size());
-
         double time_step{1.0 / analogFrequency};
+        int first_frame, last_frame;
+        findFrameRange(nf, time_step, _initialTime, _finalTime,
+                first_frame, last_frame);
+        const int force_nrow = std::max(0, last_frame - first_frame + 1);
+
+        std::vector<double> force_times(force_nrow);
+        SimTK::Matrix_<SimTK::Vec3> force_matrix(force_nrow,
+                                                 (int)labels.size());
 
-        for(int f = 0; f < nf;  ++f) {
+        for(int r = 0; r < force_nrow;  ++r) {
+            const int f = first_frame + r;
             SimTK::RowVector_<SimTK::Vec3> 
                 row{numPlatform * 3};
             int col{0};
@@ -548,8 +673,8 @@ C3DFileAdapter::extendRead(const std::string& fileName) const {
                                        (*mit)->GetValues().coeff(f, 2)};
                 ++col;
             }
-            force_matrix.updRow(f) = row;
-            force_times[f] = 0 + f * time_step; //TODO: 0 should be start_time
+            force_matrix.updRow(r) = row;
+            force_times[r] = 0 + f * time_step; //TODO: 0 should be start_time
         }
 
         auto&  force_table = 
@@ -117,6 +117,49 @@ public:
         return _location;
     }
 
+    /** Read only the markers with the given labels, in the given order, so
+        that the other markers are never converted into the markers table.
+        By default (empty list), all markers are read. read() throws if a
+        label is not found in the file. */
+    void setMarkersToRead(const std::vector<std::string>& labels) {
+        _markersToRead = labels;
+    }
+    /** Retrieve the labels of the markers to read (empty for all). */
+    const std::vector<std::string>& getMarkersToRead() const {
+        return _markersToRead;
+    }
+
+    /** Read only the given force platforms. Platforms are numbered from 1,
+        as in the column labels of the forces table (e.g., f1, p1, m1), and
+        the column labels keep the platform numbers from the file. The
+        CalibrationMatrices, Corners, Origins and Types metadata list only
+        the platforms read, in the given order. By default (empty list), all
+        force platforms are read. read() throws if a platform is not found
+        in the file. */
+    void setForcePlatformsToRead(const std::vector<int>& platforms) {
+        _forcePlatformsToRead = platforms;
+    }
+    /** Retrieve the numbers of the force platforms to read (empty for all). */
+    const std::vector<int>& getForcePlatformsToRead() const {
+        return _forcePlatformsToRead;
+    }
+
+    /** Read only the frames (of both the markers and forces tables) whose
+        times are within [initialTime, finalTime]. Times are measured from
+        the first frame of the file. By default, all frames are read. */
+    void setTimeRange(double initialTime, double finalTime) {
+        OPENSIM_THROW_IF(initialTime > finalTime, Exception,
+                "Expected initialTime <= finalTime, but got initialTime = " +
+                std::to_string(initialTime) + " and finalTime = " +
+                std::to_string(finalTime) + ".");
+        _initialTime = initialTime;
+        _finalTime = finalTime;
+    }
+    /** Retrieve the start of the time range to read. */
+    double getInitialTime() const { return _initialTime; }
+    /** Retrieve the end of the time range to read. */
+    double getFinalTime() const { return _finalTime; }
+
 #ifndef SWIG
     static
     void write(const Tables& markerTable, const std::string& fileName);
@@ -149,6 +192,11 @@ private:
 
     ForceLocation _location{ ForceLocation::OriginOfForcePlate };
 
+    std::vector<std::string> _markersToRead;
+    std::vector<int> _forcePlatformsToRead;
+    double _initialTime{ -SimTK::Infinity };
+    double _finalTime{ SimTK::Infinity };
+
 };
 
 } // namespace OpenSim
@@ -24,11 +24,17 @@
  * -------------------------------------------------------------------------- */
 
 #include "osimCommonDLL.h"
+#include <algorithm>
+#include <atomic>
+#include <exception>
 #include <functional>
 #include <iostream>
 #include <memory>
 #include <mutex>
 #include <stack>
+#include <system_error>
+#include <thread>
+#include <vector>
 #include <condition_variable>
 
 #include <SimTKcommon/internal/BigMatrix.h>
@@ -165,6 +171,56 @@ private:
     std::condition_variable m_inventoryMonitor;
 };
 
+#ifndef SWIG
+/// Call `function(index)` for each index in [0, size), distributing the
+/// indices over up to `numThreads` threads; the calling thread is one of
+/// them. Indices are handed out one at a time, in increasing order, so
+/// calls of unequal cost are balanced across the threads. If `numThreads`
+/// is less than 1, the number of hardware threads is used.
+/// If a call throws, no further indices are started, and the first exception
+/// is rethrown on the calling thread once all threads have finished.
+/// `function` must be safe to call concurrently for different indices.
+/// @ingroup commonutil
+template <typename F>
+void parallelFor(int size, const F& function, int numThreads = 0) {
+    if (size <= 0) return;
+    if (numThreads < 1) {
+        numThreads = static_cast<int>(std::thread::hardware_concurrency());
+    }
+    numThreads = std::max(1, std::min(numThreads, size));
+
+    std::atomic<int> next(0);
+    std::atomic<bool> failed(false);
+    std::exception_ptr exception;
+    std::mutex exceptionMutex;
+    auto work = [&]() {
+        for (int index = next++; index < size && !failed; index = next++) {
+            try {
+                function(index);
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(exceptionMutex);
+                if (!exception) exception = std::current_exception();
+                failed = true;
+            }
+        }
+    };
+
+    std::vector<std::thread> threads;
+    threads.reserve(numThreads - 1);
+    for (int ithread = 1; ithread < numThreads; ++ithread) {
+        try {
+            threads.emplace_back(work);
+        } catch (const std::system_error&) {
+            // Could not start another thread; continue with those we have.
+            break;
+        }
+    }
+    work();
+    for (auto& thread : threads) thread.join();
+    if (exception) std::rethrow_exception(exception);
+}
+#endif
+
 } // namespace OpenSim
 
 #endif // OPENSIM_COMMONUTILITIES_H_
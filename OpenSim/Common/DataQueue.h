@@ -22,9 +22,13 @@
  * See the License for the specific language governing permissions and        *
  * limitations under the License.                                             *
  * -------------------------------------------------------------------------- */
-#include <queue>
+#include <atomic>
 #include <condition_variable>
+#include <queue>
+#include <thread>
+#include <vector>
 #include <SimTKcommon.h>
+#include <OpenSim/Common/Exception.h>
 #include <OpenSim/Common/osimCommonDLL.h>
 
 namespace OpenSim {
@@ -58,7 +62,8 @@ public:
 
 private:
     double _timeStamp;
-    SimTK::RowVectorView_<U> _data;
+    // The entry owns a copy of the data.
+    SimTK::RowVector_<U> _data;
 };
 /**
  * DataQueue is a wrapper around the std::queue customized to handle data 
@@ -93,35 +98,46 @@ public:
         return (*this);
     };
 
+    /** Create a copy of this queue, of the same concrete type, holding the
+        same entries. */
+    virtual DataQueue_* clone() const { return new DataQueue_(*this); }
+
     //--------------------------------------------------------------------------
     // DataQueue Interface
     //--------------------------------------------------------------------------
     // push data and associated timestamp to the end of the queue
-    void push_back(const double time, const SimTK::RowVectorView_<T>& data) { 
-        SimTK::RowVector_<T>* deepCopy = new SimTK::RowVector_<T>(data);
+    virtual void push_back(
+            const double time, const SimTK::RowVectorView_<T>& data) { 
+        // Copy the data before locking.
+        DataQueueEntry_<T> entry(time, data);
         std::unique_lock<std::mutex> mlock(m_mutex);
-        m_data_queue.push(DataQueueEntry_<T>(time, *deepCopy));
+        m_data_queue.push(std::move(entry));
         mlock.unlock();     // unlock before notificiation to minimize mutex con
         m_cond.notify_one(); 
     }
     // pop the front of the queue and return data and associated timestamp
-    void pop_front(double& time, SimTK::RowVector_<T>& data) { 
+    virtual void pop_front(double& time, SimTK::RowVector_<T>& data) { 
         std::unique_lock<std::mutex> mlock(m_mutex);
         while (m_data_queue.empty()) { m_cond.wait(mlock); }
-        DataQueueEntry_<SimTK::Rotation> frontEntry = m_data_queue.front();
+        DataQueueEntry_<T> frontEntry = std::move(m_data_queue.front());
         m_data_queue.pop();
         mlock.unlock(); 
         time = frontEntry.getTimeStamp();
         data = frontEntry.getData();
     }
     // check if the queue is empty
-    bool isEmpty() { 
+    virtual bool isEmpty() { 
         bool status = false;
         std::unique_lock<std::mutex> mlock(m_mutex);
         status = m_data_queue.empty();
         mlock.unlock(); 
         return status;
     }
+    // the number of entries in the queue
+    virtual int getSize() {
+        std::unique_lock<std::mutex> mlock(m_mutex);
+        return (int)m_data_queue.size();
+    }
 private:
     // As of now we use std::queue but other data structures could be used as well
     std::queue<DataQueueEntry_<T>> m_data_queue;
@@ -131,6 +147,113 @@ private:
     //=============================================================================
 };  // END of class templatized DataQueue_<T>
 //=============================================================================
+
+/**
+ * A bounded, lock-free DataQueue_ for exactly one producer thread (which calls
+ * push_back()) and one consumer thread (which calls pop_front()), e.g., a
+ * thread reading a live stream of sensor data and the thread running the
+ * InverseKinematicsSolver. The entries are kept in a ring buffer of
+ * `capacity` slots that is allocated up front; pushing copies the data into
+ * the next free slot and popping copies it out, so that, once the slots hold
+ * rows of the streamed size, neither thread allocates memory or waits on a
+ * lock. Instead, push_back() waits (yielding the thread) while the buffer is
+ * full and pop_front() waits while it is empty; use tryPushBack() and
+ * tryPopFront() to not wait.
+ *
+ * Copying the queue is not thread-safe: do not copy a queue that is in use.
+ */
+template<class T> class RingBufferDataQueue_ : public DataQueue_<T> {
+public:
+    /** Create a queue with room for `capacity` entries. If `rowSize` is
+        positive, the slots are allocated for rows of that size. */
+    explicit RingBufferDataQueue_(int capacity = 256, int rowSize = 0)
+            : m_slots(capacity) {
+        OPENSIM_THROW_IF(capacity <= 0, Exception,
+                "Expected a positive capacity, but got {}.", capacity);
+        if (rowSize > 0) {
+            for (auto& slot : m_slots) slot.data.resize(rowSize);
+        }
+    }
+    RingBufferDataQueue_(const RingBufferDataQueue_& other)
+            : DataQueue_<T>(), m_slots(other.m_slots),
+              m_head(other.m_head.load()), m_tail(other.m_tail.load()) {}
+    RingBufferDataQueue_& operator=(const RingBufferDataQueue_& other) {
+        m_slots = other.m_slots;
+        m_head.store(other.m_head.load());
+        m_tail.store(other.m_tail.load());
+        return *this;
+    }
+
+    RingBufferDataQueue_* clone() const override {
+        return new RingBufferDataQueue_(*this);
+    }
+
+    /** The maximum number of entries in the queue.                       */
+    int getCapacity() const { return (int)m_slots.size(); }
+
+    /** Push data and its timestamp to the end of the queue, waiting while
+        the queue is full. Call from the producer thread only.            */
+    void push_back(
+            const double time, const SimTK::RowVectorView_<T>& data) override {
+        while (!tryPushBack(time, data)) std::this_thread::yield();
+    }
+    /** Pop the front of the queue, waiting while the queue is empty. Call
+        from the consumer thread only.                                    */
+    void pop_front(double& time, SimTK::RowVector_<T>& data) override {
+        while (!tryPopFront(time, data)) std::this_thread::yield();
+    }
+    bool isEmpty() override {
+        return m_head.load(std::memory_order_acquire) ==
+               m_tail.load(std::memory_order_acquire);
+    }
+    /** The number of entries in the queue. When called from the consumer
+        thread, at least this many entries can be popped without waiting. */
+    int getSize() override {
+        const size_t head = m_head.load(std::memory_order_acquire);
+        return (int)(m_tail.load(std::memory_order_acquire) - head);
+    }
+
+    /** Push data and its timestamp to the end of the queue if it is not
+        full, and return whether it was pushed.                           */
+    bool tryPushBack(const double time, const SimTK::RowVectorView_<T>& data) {
+        const size_t tail = m_tail.load(std::memory_order_relaxed);
+        if (tail - m_head.load(std::memory_order_acquire) == m_slots.size()) {
+            return false;
+        }
+        Slot& slot = m_slots[tail % m_slots.size()];
+        slot.time = time;
+        // Copies in place if the slot already has a row of this size.
+        slot.data = data;
+        m_tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+    /** Pop the front of the queue if it is not empty, and return whether an
+        entry was popped.                                                  */
+    bool tryPopFront(double& time, SimTK::RowVector_<T>& data) {
+        const size_t head = m_head.load(std::memory_order_relaxed);
+        if (head == m_tail.load(std::memory_order_acquire)) return false;
+        const Slot& slot = m_slots[head % m_slots.size()];
+        time = slot.time;
+        data = slot.data;
+        m_head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+private:
+    struct Slot {
+        double time = SimTK::NaN;
+        SimTK::RowVector_<T> data;
+    };
+    std::vector<Slot> m_slots;
+    // Number of entries popped (written by the consumer) and pushed (written
+    // by the producer), padded onto separate cache lines so that the two
+    // threads do not contend for the same line.
+    std::atomic<size_t> m_head{0};
+    char m_padding[64];
+    std::atomic<size_t> m_tail{0};
+//=============================================================================
+};  // END of class templatized RingBufferDataQueue_<T>
+//=============================================================================
 }
 
 #endif // OPENSIM_DATA_QUEUE_H_
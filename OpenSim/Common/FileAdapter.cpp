@@ -2,8 +2,230 @@
 #include <OpenSim/Common/IO.h>
 #include "STOFileAdapter.h"
 
+#include <condition_variable>
+#include <deque>
+#include <fstream>
+#include <mutex>
+#include <thread>
+
+#ifdef WITH_ZLIB
+#include <zlib.h>
+#endif
+
 namespace OpenSim {
 
+namespace {
+
+const std::string gzipExtension{"gz"};
+
+#ifdef WITH_ZLIB
+/** Stream buffer that decompresses a gzip file on a producer thread. The
+producer fills a bounded queue of chunks while the consumer (the thread
+parsing the stream) takes chunks from the queue, so that decompression and
+parsing overlap.                                                              */
+class GzipInputBuffer : public std::streambuf {
+public:
+    explicit GzipInputBuffer(gzFile file) : _file{file} {
+        gzbuffer(_file, static_cast<unsigned>(_chunkSize));
+        _producer = std::thread{&GzipInputBuffer::decompress, this};
+    }
+
+    GzipInputBuffer(const GzipInputBuffer&)            = delete;
+    GzipInputBuffer& operator=(const GzipInputBuffer&) = delete;
+
+    ~GzipInputBuffer() override {
+        {
+            std::lock_guard<std::mutex> lock{_mutex};
+            _stop = true;
+        }
+        _cond.notify_all();
+        _producer.join();
+        // The producer closes the file once it has read all of it.
+        if(_file != nullptr)
+            gzclose(_file);
+    }
+
+protected:
+    int_type underflow() override {
+        if(gptr() < egptr())
+            return traits_type::to_int_type(*gptr());
+
+        std::unique_lock<std::mutex> lock{_mutex};
+        // The current chunk has been consumed. Hand it back to the producer
+        // so its memory can be reused.
+        if(!_current.empty())
+            _free.push_back(std::move(_current));
+        _current.clear();
+        _cond.notify_all();
+        _cond.wait(lock, [this] { return !_ready.empty() || _done; });
+        if(_ready.empty()) {
+            // istream rethrows this as the stream has badbit exceptions on.
+            OPENSIM_THROW_IF(!_error.empty(), IOError, _error);
+            return traits_type::eof();
+        }
+        _current = std::move(_ready.front());
+        _ready.pop_front();
+        lock.unlock();
+        _cond.notify_all();
+
+        setg(_current.data(), _current.data(), 
+             _current.data() + _current.size());
+        return traits_type::to_int_type(*gptr());
+    }
+
+private:
+    void decompress() {
+        while(true) {
+            std::vector<char> chunk{};
+            {
+                std::unique_lock<std::mutex> lock{_mutex};
+                _cond.wait(lock, [this] { 
+                    return _stop || _ready.size() < _maxReadyChunks; 
+                });
+                if(_stop)
+                    return;
+                if(!_free.empty()) {
+                    chunk = std::move(_free.back());
+                    _free.pop_back();
+                }
+            }
+
+            chunk.resize(_chunkSize);
+            const int numRead = gzread(_file, chunk.data(),
+                                       static_cast<unsigned>(_chunkSize));
+
+            std::lock_guard<std::mutex> lock{_mutex};
+            if(numRead <= 0) {
+                if(numRead < 0) {
+                    int errnum{};
+                    _error = "Error decompressing file: ";
+                    _error += gzerror(_file, &errnum);
+                }
+                // Close the file here so that a failure to close it is
+                // reported to the consumer, like a read error.
+                const int closed = gzclose(_file);
+                _file = nullptr;
+                if(_error.empty() && closed != Z_OK)
+                    _error = "Error closing compressed file (zlib error " +
+                             std::to_string(closed) + ").";
+                _done = true;
+                _cond.notify_all();
+                return;
+            }
+            chunk.resize(static_cast<size_t>(numRead));
+            _ready.push_back(std::move(chunk));
+            _cond.notify_all();
+        }
+    }
+
+    static constexpr size_t _chunkSize{1 << 18};
+    static constexpr size_t _maxReadyChunks{4};
+
+    gzFile _file;
+    std::thread _producer;
+    std::mutex _mutex;
+    std::condition_variable _cond;
+    std::deque<std::vector<char>> _ready;
+    std::vector<std::vector<char>> _free;
+    std::vector<char> _current;
+    std::string _error;
+    bool _done{false};
+    bool _stop{false};
+};
+
+/** Stream buffer that gzip-compresses everything written to it.             */
+class GzipOutputBuffer : public std::streambuf {
+public:
+    explicit GzipOutputBuffer(gzFile file) : 
+        _file{file}, _buffer(_bufferSize) {
+        setp(_buffer.data(), _buffer.data() + _buffer.size());
+    }
+
+    GzipOutputBuffer(const GzipOutputBuffer&)            = delete;
+    GzipOutputBuffer& operator=(const GzipOutputBuffer&) = delete;
+
+    ~GzipOutputBuffer() override {
+        close();
+    }
+
+    /** Write the remaining data and the end of the compressed stream, and
+    close the file. Returns false if any of it could not be written.         */
+    bool close() {
+        if(_file == nullptr)
+            return true;
+        const bool flushed = flushBuffer();
+        const int closed = gzclose(_file);
+        _file = nullptr;
+        return flushed && closed == Z_OK;
+    }
+
+protected:
+    int_type overflow(int_type ch) override {
+        if(!flushBuffer())
+            return traits_type::eof();
+        if(!traits_type::eq_int_type(ch, traits_type::eof())) {
+            *pptr() = traits_type::to_char_type(ch);
+            pbump(1);
+        }
+        return traits_type::not_eof(ch);
+    }
+
+    int sync() override {
+        return flushBuffer() ? 0 : -1;
+    }
+
+private:
+    bool flushBuffer() {
+        if(_file == nullptr)
+            return false;
+        const auto numBytes = static_cast<unsigned>(pptr() - pbase());
+        if(numBytes > 0 && 
+           gzwrite(_file, pbase(), numBytes) != static_cast<int>(numBytes))
+            return false;
+        setp(_buffer.data(), _buffer.data() + _buffer.size());
+        return true;
+    }
+
+    static constexpr size_t _bufferSize{1 << 18};
+
+    gzFile _file;
+    std::vector<char> _buffer;
+};
+
+/** Streams owning their gzip stream buffer.                                 */
+class GzipInputStream : public std::istream {
+public:
+    explicit GzipInputStream(gzFile file) : 
+        std::istream{nullptr}, _buffer{file} {
+        rdbuf(&_buffer);
+        // Decompression errors are reported as exceptions from underflow().
+        exceptions(std::ios_base::badbit);
+    }
+private:
+    GzipInputBuffer _buffer;
+};
+
+class GzipOutputStream : public std::ostream {
+public:
+    explicit GzipOutputStream(gzFile file) :
+        std::ostream{nullptr}, _buffer{file} {
+        rdbuf(&_buffer);
+    }
+    ~GzipOutputStream() override {
+        flush();
+    }
+    /** Finish the compressed file; sets failbit if it could not be written. */
+    void close() {
+        if(!_buffer.close())
+            setstate(std::ios::failbit);
+    }
+private:
+    GzipOutputBuffer _buffer;
+};
+#endif
+
+} // anonymous namespace
+
 std::shared_ptr<DataAdapter>
 createSTOFileAdapterForReading(const std::string&);
 
@@ -25,17 +247,88 @@ FileAdapter::writeFile(const InputTables& tables,
 
 std::string 
 FileAdapter::findExtension(const std::string& filename) {
-    std::size_t found = filename.find_last_of('.');
+    // Skip a trailing compression extension: "walk.sto.gz" -> "walk.sto".
+    const auto compression = findCompressionExtension(filename);
+    const auto stem = compression.empty() ? 
+        filename : 
+        filename.substr(0, filename.size() - compression.size() - 1);
+    std::size_t found = stem.find_last_of('.');
 
     OPENSIM_THROW_IF(found == std::string::npos,
                      FileExtensionNotFound,
                      filename);
 
-    auto ext = filename.substr(found + 1);
+    auto ext = stem.substr(found + 1);
     std::transform(ext.begin(), ext.end(), ext.begin(), ::tolower);
     return ext;
 }
 
+std::string
+FileAdapter::findCompressionExtension(const std::string& filename) {
+    std::size_t found = filename.find_last_of('.');
+    if(found == std::string::npos)
+        return {};
+
+    auto ext = filename.substr(found + 1);
+    std::transform(ext.begin(), ext.end(), ext.begin(), ::tolower);
+    if(ext == gzipExtension)
+        return ext;
+    return {};
+}
+
+std::unique_ptr<std::istream>
+FileAdapter::openInputStream(const std::string& fileName) {
+    if(findCompressionExtension(fileName).empty())
+        return std::unique_ptr<std::istream>{new std::ifstream{fileName}};
+
+#ifdef WITH_ZLIB
+    gzFile file = gzopen(fileName.c_str(), "rb");
+    if(file == nullptr) {
+        // Let the caller detect the failure through the stream state, as
+        // for uncompressed files.
+        std::unique_ptr<std::istream> failed{new std::ifstream{}};
+        failed->setstate(std::ios::failbit);
+        return failed;
+    }
+    return std::unique_ptr<std::istream>{new GzipInputStream{file}};
+#else
+    OPENSIM_THROW(IOError,
+                  "Cannot read compressed file '" + fileName + "': OpenSim "
+                  "was built without zlib support.");
+#endif
+}
+
+std::unique_ptr<std::ostream>
+FileAdapter::openOutputStream(const std::string& fileName) {
+    if(findCompressionExtension(fileName).empty())
+        return std::unique_ptr<std::ostream>{new std::ofstream{fileName}};
+
+#ifdef WITH_ZLIB
+    gzFile file = gzopen(fileName.c_str(), "wb");
+    if(file == nullptr) {
+        std::unique_ptr<std::ostream> failed{new std::ofstream{}};
+        failed->setstate(std::ios::failbit);
+        return failed;
+    }
+    return std::unique_ptr<std::ostream>{new GzipOutputStream{file}};
+#else
+    OPENSIM_THROW(IOError,
+                  "Cannot write compressed file '" + fileName + "': OpenSim "
+                  "was built without zlib support.");
+#endif
+}
+
+void
+FileAdapter::closeOutputStream(std::ostream& stream) {
+#ifdef WITH_ZLIB
+    if(auto* gzipStream = dynamic_cast<GzipOutputStream*>(&stream)) {
+        gzipStream->close();
+        return;
+    }
+#endif
+    stream.flush();
+}
+
 std::vector<std::string> 
 FileAdapter::tokenize(const std::string& str, 
                       const std::string& delims) {
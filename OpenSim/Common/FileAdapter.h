@@ -28,6 +28,9 @@
 */
 #include "DataAdapter.h"
 
+#include <istream>
+#include <memory>
+#include <ostream>
 #include <vector>
 
 namespace OpenSim {
@@ -198,10 +201,39 @@ public:
     static void writeFile(const InputTables& tables, 
                           const std::string& fileName);
 
-    /** Find the extension from a filename.                                   */
+    /** Find the extension from a filename. A trailing compression extension
+    (see findCompressionExtension()) is skipped, so the extension of
+    "walk.sto.gz" is "sto".                                                   */
     static
     std::string findExtension(const std::string& filename);
 
+    /** Find the compression extension from a filename. Returns "gz" for
+    files like "walk.sto.gz" and an empty string for uncompressed files.     */
+    static
+    std::string findCompressionExtension(const std::string& filename);
+
+    /** Open a file for reading. Compressed files (see
+    findCompressionExtension()) are decompressed on a separate thread while
+    the caller parses the returned stream, so no temporary file is created.
+    If the file cannot be opened, the returned stream is not good(). Throws
+    IOError if the file is compressed and OpenSim was built without zlib.     */
+    static std::unique_ptr<std::istream> 
+    openInputStream(const std::string& fileName);
+
+    /** Open a file for writing. Files with a compression extension (see
+    findCompressionExtension()) are compressed as they are written. If the
+    file cannot be opened, the returned stream is not good(). Throws IOError
+    if the file is compressed and OpenSim was built without zlib.             */
+    static std::unique_ptr<std::ostream>
+    openOutputStream(const std::string& fileName);
+
+    /** Finish writing a stream returned by openOutputStream(). For a
+    compressed file, this writes the end of the compressed data and closes the
+    file; otherwise the stream is flushed. Sets the failbit of the stream if
+    the data could not be written. Nothing may be written to the stream
+    afterward.                                                                */
+    static void closeOutputStream(std::ostream& stream);
+
     /** Get the next line from the stream and tokenize/split the line using
     the given delimiters.                                                     */
     static std::vector<std::string> getNextLine(std::istream& stream,
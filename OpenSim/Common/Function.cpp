@@ -29,6 +29,8 @@
 // INCLUDES
 #include "Function.h"
 
+#include <algorithm>
+
 
 using namespace OpenSim;
 using namespace std;
@@ -193,3 +195,57 @@ void Function::resetFunction()
         delete _function;
     _function = NULL;
 }
+
+double Function::calcValueAt(double x) const
+{
+    int interval = _lastInterval.load(std::memory_order_relaxed);
+    const double value = calcValueWithHint(x, interval);
+    _lastInterval.store(interval, std::memory_order_relaxed);
+    return value;
+}
+
+void Function::calcValues(const double* x, int n, double* values) const
+{
+    Cursor cursor(*this);
+    cursor.calcValues(x, n, values);
+}
+
+double Function::calcValueWithHint(double x, int& interval) const
+{
+    return calcValue(Vector(1, x));
+}
+
+int Function::findInterval(const double* x, int n, double value, int hint)
+{
+    if (hint < 0 || hint > n - 2) hint = 0;
+
+    // Usually the value is in the same interval as before, or the next one.
+    int k;
+    if (x[hint] <= value && value < x[hint + 1]) {
+        k = hint;
+    } else if (x[hint] <= value && hint + 2 < n && value < x[hint + 2]) {
+        k = hint + 1;
+    } else if (x[hint] > value && hint > 0 && x[hint - 1] <= value) {
+        k = hint - 1;
+    } else {
+        k = static_cast<int>(std::upper_bound(x, x + n, value) - x) - 1;
+        k = std::max(0, std::min(k, n - 2));
+    }
+    if (k == 0 || value != x[k]) return k;
+
+    // The value is the interior knot shared by intervals k-1 and k. Take
+    // the one that a bisection from the whole range lands on, as the
+    // spline and piecewise linear functions always have, so that their
+    // derivatives at a knot do not depend on the previous evaluation.
+    int i = 0;
+    int j = n;
+    while (true) {
+        k = (i + j) / 2;
+        if (value < x[k])
+            j = k;
+        else if (value > x[k + 1])
+            i = k;
+        else
+            return k;
+    }
+}
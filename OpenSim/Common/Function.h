@@ -32,6 +32,10 @@
 #include "Object.h"
 #include "SimTKmath.h"
 
+#ifndef SWIG
+#include <atomic>
+#endif
+
 
 //=============================================================================
 //=============================================================================
@@ -60,6 +64,12 @@ OpenSim_DECLARE_ABSTRACT_OBJECT(Function, Object);
 protected:
     // The SimTK::Function object implementing this function.
     mutable SimTK::Function* _function;
+#ifndef SWIG
+    // Interval in which the last call to calcValueAt() found its argument.
+    // It is atomic so that concurrent evaluations remain safe; any value is
+    // a valid (if poor) starting guess.
+    mutable std::atomic<int> _lastInterval{0};
+#endif
 
 //=============================================================================
 // METHODS
@@ -128,6 +138,58 @@ public:
      */
     virtual SimTK::Function* createSimTKFunction() const = 0;
 
+    //--------------------------------------------------------------------------
+    // EVALUATE FUNCTIONS OF ONE VARIABLE
+    //--------------------------------------------------------------------------
+    /**
+     * Calculate the value of this function of one variable at x. This gives
+     * the same value as calcValue(SimTK::Vector(1, x)) without constructing
+     * a Vector. Piecewise functions (e.g., SimmSpline, GCVSpline and
+     * PiecewiseLinearFunction) start searching for the interval that contains
+     * x from the interval of their previous evaluation, so evaluating at
+     * nearby, increasing (or decreasing) values of x is O(1) per call.
+     */
+    double calcValueAt(double x) const;
+    /**
+     * Calculate the values of this function of one variable at the n values
+     * in x. Evaluation is fastest if x is sorted.
+     *
+     * @param x Values of the independent variable (n of them).
+     * @param n Number of values.
+     * @param values Array of n doubles in which to store the results.
+     */
+    virtual void calcValues(const double* x, int n, double* values) const;
+
+    /**
+     * Evaluates a Function of one variable at a sequence of values. The
+     * cursor remembers the interval of the function that contained the
+     * previous value, which makes evaluating at monotonic values O(1) per
+     * call. Unlike calcValueAt(), the cursor's state is not shared with
+     * other callers. The Function must outlive the cursor, and the cursor
+     * must not be used concurrently from multiple threads.
+     *
+     * @code{.cpp}
+     * Function::Cursor cursor(function);
+     * for (double t : times) total += cursor.calcValue(t);
+     * @endcode
+     */
+    class OSIMCOMMON_API Cursor {
+    public:
+        explicit Cursor(const Function& function) : _function(&function) {}
+        /** Value of the function at x.                                     */
+        double calcValue(double x) {
+            return _function->calcValueWithHint(x, _interval);
+        }
+        /** Values of the function at the n values in x.                    */
+        void calcValues(const double* x, int n, double* values) {
+            for (int i = 0; i < n; ++i)
+                values[i] = _function->calcValueWithHint(x[i], _interval);
+        }
+    private:
+        const Function* _function;
+        int _interval{0};
+    };
+
 protected:
     /**
      * This should be called whenever this object has been modified.  It clears 
@@ -135,6 +197,25 @@ protected:
      */
     void resetFunction();
 
+    /**
+     * Calculate the value of this function of one variable at x. Piecewise
+     * functions override this to start searching for the interval that
+     * contains x at `interval`, and to set `interval` to the interval found.
+     * The default ignores `interval` and calls calcValue().
+     */
+    virtual double calcValueWithHint(double x, int& interval) const;
+
+    /**
+     * Find the index k of the interval [x[k], x[k+1]) that contains value,
+     * for strictly increasing x of size n >= 2. Values below x[0] give 0 and
+     * values at or above x[n-1] give n-2. The search starts at `hint` and
+     * its neighbors before falling back to a binary search. A value equal to
+     * an interior knot x[k] may give k-1 or k; which one depends only on
+     * x and n (it is the interval the original bisection of SimmSpline and
+     * PiecewiseLinearFunction chose), not on `hint`.
+     */
+    static int findInterval(const double* x, int n, double value, int hint);
+
 //=============================================================================
 };  // END class Function
 
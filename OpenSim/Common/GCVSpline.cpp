@@ -33,6 +33,8 @@
 #include "gcvspl.h"
 #include "XYFunctionInterface.h"
 
+#include <algorithm>
+
 
 
 using namespace OpenSim;
@@ -600,3 +602,21 @@ SimTK::Function* GCVSpline::createSimTKFunction() const {
     return spline;
 }
 
+void GCVSpline::fit() const {
+    if (_function == NULL)
+        _function = createSimTKFunction();
+}
+
+double GCVSpline::calcValueWithHint(double x, int& interval) const {
+    if (getSize() < getOrder())
+        return Function::calcValueWithHint(x, interval);
+    fit();
+    // splder() searches from, and updates, its 1-based knot interval.
+    int l = interval + 1;
+    double work[8];
+    const double value = splder(0, _halfOrder, getSize(), x,
+            const_cast<double*>(getXValues()),
+            const_cast<double*>(&_coefficients[0]), &l, work);
+    interval = std::max(0, l - 1);
+    return value;
+}
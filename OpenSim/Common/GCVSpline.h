@@ -229,10 +229,19 @@ public:
     virtual bool deletePoints(const Array<int>& indices);
     virtual int addPoint(double aX, double aY);
     SimTK::Function* createSimTKFunction() const override;
+    /**
+     * Fit the spline to its data now rather than on its first evaluation.
+     * This has no effect if the spline has already been fit since it was
+     * last modified. Afterwards, getCoefficients() holds the coefficients of
+     * the fitted spline. Fitting different splines concurrently is safe.
+     */
+    void fit() const;
 
     //--------------------------------------------------------------------------
     // EVALUATION
     //--------------------------------------------------------------------------
+protected:
+    double calcValueWithHint(double x, int& interval) const override;
 
 //=============================================================================
 };  // END class GCVSpline
@@ -22,8 +22,10 @@
  * -------------------------------------------------------------------------- */
 
 #include "GCVSplineSet.h"
+#include "CommonUtilities.h"
 #include "GCVSpline.h"
 #include "Storage.h"
+#include "gcvspl.h"
 
 
 using namespace OpenSim;
@@ -68,6 +70,7 @@ GCVSplineSet::GCVSplineSet(const TimeSeriesTable& table,
         adoptAndAppend(new GCVSpline(degree, column.size(), time.data(),
                                      &column[0], label, errorVariance));
     }
+    fitSplines();
 }
 
 void GCVSplineSet::setNull() {
@@ -118,8 +121,6 @@ void GCVSplineSet::construct(int aDegree,
         // CONSTRUCT SPLINE
         //printf("%s\t",name);
         spline = new GCVSpline(aDegree,nData,times,data,name,aErrorVariance);
-        SimTK::Function* fp = spline->createSimTKFunction();
-        delete fp;  
 
         // ADD SPLINE
         adoptAndAppend(spline);
@@ -129,6 +130,31 @@ void GCVSplineSet::construct(int aDegree,
     // CLEANUP
     if(times!=NULL) delete[] times;
     if(data!=NULL) delete[] data;
+
+    // FIT
+    fitSplines();
+}
+
+void GCVSplineSet::fitSplines() {
+    const int n = getSize();
+    std::vector<const GCVSpline*> splines;
+    splines.reserve(n);
+    int numPoints = 0;
+    for(int i=0;i<n;i++) {
+        const GCVSpline* spline = dynamic_cast<const GCVSpline*>(&get(i));
+        // Splines with too few points could not be constructed; leave them
+        // to report their error when they are evaluated.
+        if(spline==NULL || spline->getSize()<spline->getOrder()) continue;
+        splines.push_back(spline);
+        numPoints += spline->getSize();
+    }
+
+    // Each spline keeps its fit, so it is not refit on its first evaluation.
+    // Threads are not worth starting for small sets.
+    const int numThreads = numPoints > 10000 ? 0 : 1;
+    parallelFor((int)splines.size(), [&](int i) {
+        splines[i]->fit();
+    }, numThreads);
 }
 
 GCVSpline* GCVSplineSet::getGCVSpline(int aIndex) const {
@@ -187,14 +213,14 @@ Storage* GCVSplineSet::constructStorage(int aDerivOrder,double aDX) {
     store->setColumnLabels(labels);
 
     // SET STATES
-    Array<double> y(0.0,n);
+    SimTK::Vector y(n,0.0);
 
     // LOOP THROUGH THE DATA
     // constant increments
     if(aDX>0.0) {
         for(double x=getMinX(); x<=getMaxX(); x+=aDX) {
-            evaluate(y,aDerivOrder,x);
-            store->append(x,n,&y[0]);
+            y = evaluateAll(x,aDerivOrder);
+            store->append(x,y);
         }
 
     // original independent variable increments
@@ -207,14 +233,49 @@ Storage* GCVSplineSet::constructStorage(int aDerivOrder,double aDX) {
             if(xOrig[ix]<getMinX()) continue;
             if(xOrig[ix]>getMaxX()) break;
 
-            evaluate(y,aDerivOrder,xOrig[ix]);
-            store->append(xOrig[ix],n,&y[0]);
+            y = evaluateAll(xOrig[ix],aDerivOrder);
+            store->append(xOrig[ix],y);
         }
     }
 
     return(store);
 }
 
+SimTK::Vector GCVSplineSet::evaluateAll(double aX, int aDerivOrder) const {
+    OPENSIM_THROW_IF_FRMOBJ(aDerivOrder < 0, Exception,
+            "Expected a non-negative derivative order, but got {}.",
+            aDerivOrder);
+
+    const int n = getSize();
+    SimTK::Vector values(n);
+
+    // The interval found for one spline is the starting guess for the next;
+    // splines with the same knots accept it without searching again.
+    int interval = 0;
+    double work[8];
+    for(int i=0;i<n;i++) {
+        const GCVSpline* spline = dynamic_cast<const GCVSpline*>(&get(i));
+        if(spline==NULL || spline->getSize()<spline->getOrder()) {
+            values[i] = FunctionSet::evaluate(i,aDerivOrder,aX);
+            continue;
+        }
+        spline->fit();
+        values[i] = splder(aDerivOrder, spline->getHalfOrder(),
+                spline->getSize(), aX,
+                const_cast<double*>(spline->getXValues()),
+                const_cast<double*>(&spline->getCoefficients()[0]),
+                &interval, work);
+    }
+    return values;
+}
+
+void GCVSplineSet::evaluate(Array<double>& rValues, int aDerivOrder,
+        double aX) const {
+    const SimTK::Vector values = evaluateAll(aX, aDerivOrder);
+    rValues.setSize(values.size());
+    for(int i=0;i<values.size();i++) rValues[i] = values[i];
+}
+
 double GCVSplineSet::getMinX() const
 {
     double min = SimTK::Infinity;
@@ -77,6 +77,8 @@ public:
      * the error variance assumed for each column in the Storage.  If different
      * variances should be set for the various columns, you will need to
      * construct each GCVSpline individually.
+     *
+     * The columns are fit concurrently.
      * @see Storage
      * @see GCVSpline
      */
@@ -100,6 +102,8 @@ public:
      * the error variance assumed for each column in the TimeSeriesTable.  If 
      * different variances should be set for the various columns, you will need 
      * to construct each GCVSpline individually.
+     *
+     * The columns are fit concurrently.
      * @see TimeSeriesTable.
      * @see GCVSpline
      */
@@ -125,6 +129,11 @@ private:
      */
     void construct(int aDegree,const Storage *aStore,double aErrorVariance);
 
+    /**
+     * Fit all splines in the set, concurrently if the set is large enough.
+     */
+    void fitSplines();
+
 public:
     /**
      * Get the function at a specified index.
@@ -137,6 +146,31 @@ public:
     double getMinX() const;
     double getMaxX() const;
 
+    /**
+     * Evaluate all functions in the set (or one of their derivatives) at the
+     * same value of the independent variable.
+     *
+     * This is faster than evaluating the functions one at a time: the
+     * interval containing aX is searched for once and reused by every spline
+     * that shares the same independent variable (e.g., splines of the columns
+     * of one Storage or TimeSeriesTable). Functions that are not GCVSplines
+     * are evaluated as in FunctionSet::evaluate().
+     *
+     * @param aX Value of the independent variable.
+     * @param aDerivOrder Derivative order. 0 evaluates the functions, 1
+     * evaluates their first derivatives, and so on.
+     * @return Values of the functions, in the order of the set.
+     */
+    SimTK::Vector evaluateAll(double aX, int aDerivOrder = 0) const;
+
+    using FunctionSet::evaluate;
+    /**
+     * Evaluate all functions in the set (or one of their derivatives) at the
+     * same value of the independent variable, as in evaluateAll().
+     */
+    void evaluate(Array<double>& rValues, int aDerivOrder,
+            double aX = 0.0) const override;
+
     /**
      * Construct a storage object (see Storage) for this spline set or for 
      * some derivative of this spline set.
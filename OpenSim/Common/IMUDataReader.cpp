@@ -1,5 +1,8 @@
 #include "IMUDataReader.h"
 
+#include <cstdlib>
+#include <sstream>
+
 namespace OpenSim {
 
     const std::string IMUDataReader::Orientations{ "orientations" };         // name of table for orientation data
@@ -48,4 +51,46 @@ namespace OpenSim {
         return tables;
 
     }
+
+    void IMUDataReader::readLines(std::istream& stream, std::string& buffer,
+        std::vector<const char*>& lines) {
+        std::ostringstream contents;
+        contents << stream.rdbuf();
+        buffer = contents.str();
+        lines.clear();
+
+        char* data = &buffer[0];
+        const size_t size = buffer.size();
+        size_t start = 0;
+        while (start < size) {
+            size_t end = buffer.find('\n', start);
+            if (end == std::string::npos) end = size;
+            else data[end] = '\0';
+            // Get rid of the extra \r if parsing a file with CRLF line endings.
+            if (end > start && data[end - 1] == '\r') data[end - 1] = '\0';
+            if (data[start] == '\0') break;
+            lines.push_back(data + start);
+            start = end + 1;
+        }
+    }
+
+    void IMUDataReader::findFields(const char* line, char delim,
+        std::vector<const char*>& fields) {
+        fields.clear();
+        fields.push_back(line);
+        for (const char* c = line; *c != '\0'; ++c) {
+            if (*c == delim) fields.push_back(c + 1);
+        }
+        // A trailing delimiter does not start a field.
+        if (fields.size() > 1 && *fields.back() == '\0') fields.pop_back();
+    }
+
+    double IMUDataReader::parseField(const std::vector<const char*>& fields,
+        int index, char delim) {
+        if (index < 0 || index >= (int)fields.size()) return SimTK::NaN;
+        const char* field = fields[index];
+        while (*field == ' ') ++field;
+        if (*field == delim || *field == '\0') return SimTK::NaN;
+        return std::strtod(field, nullptr);
+    }
 }
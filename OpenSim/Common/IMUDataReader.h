@@ -78,6 +78,21 @@ protected:
         const SimTK::Matrix_<SimTK::Vec3>& linearAccelerationData, 
         const SimTK::Matrix_<SimTK::Vec3>& magneticHeadingData, 
         const SimTK::Matrix_<SimTK::Vec3>& angularVelocityData) const;
+
+    /** Read the rest of `stream` into `buffer` and split it into lines,
+     * stored in `lines` as null-terminated strings within `buffer` (line
+     * endings are removed). Reading stops at the first empty line, as with
+     * FileAdapter::getNextLine(). `buffer` must outlive `lines`. */
+    static void readLines(std::istream& stream, std::string& buffer,
+        std::vector<const char*>& lines);
+    /** Find the start of each `delim`-separated field of a null-terminated
+     * `line`. Empty fields are kept, as in FileAdapter::tokenize(). */
+    static void findFields(const char* line, char delim,
+        std::vector<const char*>& fields);
+    /** Parse the number at the start of a field, without creating a string.
+     * Returns NaN if the field is missing or empty. */
+    static double parseField(const std::vector<const char*>& fields,
+        int index, char delim);
 };
 
 } // OpenSim namespace
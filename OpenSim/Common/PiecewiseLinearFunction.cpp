@@ -428,9 +428,14 @@ void PiecewiseLinearFunction::calcCoefficients()
 }
 
 double PiecewiseLinearFunction::calcValue(const Vector& x) const
+{
+    return calcValueAt(x[0]);
+}
+
+double PiecewiseLinearFunction::calcValueWithHint(double aX,
+        int& interval) const
 {
     int n = _x.getSize();
-    double aX = x[0];
 
     if (aX < _x[0])
         return _y[0] + (aX - _x[0]) * _b[0];
@@ -446,19 +451,9 @@ double PiecewiseLinearFunction::calcValue(const Vector& x) const
     else if (EQUAL_WITHIN_ERROR(aX,_x[n-1]))
         return _y[n-1];
 
-    // Do a binary search to find which two points the abscissa is between.
-    int k, i = 0;
-    int j = n;
-    while (1)
-    {
-        k = (i+j)/2;
-        if (aX < _x[k])
-            j = k;
-        else if (aX > _x[k+1])
-            i = k;
-        else
-            break;
-    }
+    // Find which two points the abscissa is between, starting from the
+    // interval of the previous evaluation.
+    const int k = interval = findInterval(&_x[0], n, aX, interval);
 
     return _y[k] + (aX - _x[k]) * _b[k];
 }
@@ -489,19 +484,10 @@ double PiecewiseLinearFunction::calcDerivative(const std::vector<int>& derivComp
         return _b[n-1];
     }
 
-    // Do a binary search to find which two points the abscissa is between.
-    int k, i = 0;
-    int j = n;
-    while (1)
-    {
-        k = (i+j)/2;
-        if (aX < _x[k])
-            j = k;
-        else if (aX > _x[k+1])
-            i = k;
-        else
-            break;
-    }
+    // Find which two points the abscissa is between, starting from the
+    // interval of the previous evaluation.
+    const int k = findInterval(&_x[0], n, aX,
+            _lastInterval.load(std::memory_order_relaxed));
 
     return _b[k];
 }
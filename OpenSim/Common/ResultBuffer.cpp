@@ -0,0 +1,79 @@
+/* -------------------------------------------------------------------------- *
+ *                        OpenSim:  ResultBuffer.cpp                          *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2021 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "ResultBuffer.h"
+#include "Exception.h"
+#include "Storage.h"
+
+#include <algorithm>
+
+using namespace OpenSim;
+
+ResultBuffer::ResultBuffer(int numColumns, int capacity) {
+    OPENSIM_THROW_IF(numColumns < 0, Exception,
+            "Expected the number of columns to be non-negative, but got {}.",
+            numColumns);
+    _numColumns = numColumns;
+    reserve(std::max(capacity, 1));
+}
+
+void ResultBuffer::reserve(int capacity) {
+    if (capacity <= _capacity) return;
+    // Each column starts at a multiple of the capacity, so the columns are
+    // moved to their place in the larger array.
+    std::vector<double> data((size_t)_numColumns * capacity);
+    for (int j = 0; j < _numColumns; ++j) {
+        std::copy(getColumn(j), getColumn(j) + _numRows,
+                data.begin() + (size_t)j * capacity);
+    }
+    _data.swap(data);
+    _times.resize(capacity);
+    _capacity = capacity;
+}
+
+int ResultBuffer::appendRow(double time, double value) {
+    int row = _numRows;
+    if (row > 0 && _times[row - 1] == time) {
+        --row;
+    } else {
+        if (row == _capacity) reserve(std::max(2 * _capacity, 1));
+        ++_numRows;
+    }
+    _times[row] = time;
+    for (int j = 0; j < _numColumns; ++j) setValue(row, j, value);
+    return row;
+}
+
+int ResultBuffer::appendRow(double time, const double* values) {
+    const int row = appendRow(time, 0.0);
+    for (int j = 0; j < _numColumns; ++j) setValue(row, j, values[j]);
+    return row;
+}
+
+void ResultBuffer::flushTo(Storage& storage) {
+    std::vector<double> values(std::max(_numColumns, 1));
+    for (int i = 0; i < _numRows; ++i) {
+        for (int j = 0; j < _numColumns; ++j) values[j] = getValue(i, j);
+        storage.append(_times[i], _numColumns, values.data());
+    }
+    clear();
+}
@@ -0,0 +1,97 @@
+#ifndef OPENSIM_RESULTBUFFER_H_
+#define OPENSIM_RESULTBUFFER_H_
+/* -------------------------------------------------------------------------- *
+ *                         OpenSim:  ResultBuffer.h                           *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2021 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "osimCommonDLL.h"
+
+#include <SimTKcommon.h>
+
+#include <vector>
+
+namespace OpenSim {
+
+class Storage;
+
+/** Rows of results (a time and a fixed number of values) recorded by an
+analysis, kept in column-major arrays that are allocated up front and grow
+geometrically, instead of in a Storage, which allocates a StateVector for
+every row. Once the results are needed, flushTo() appends the rows to a
+Storage (and empties the buffer).
+
+@code{.cpp}
+ResultBuffer buffer(numMuscles);
+// At each step:
+const int row = buffer.appendRow(s.getTime());  // values are NaN
+for (int i = 0; i < numMuscles; ++i) buffer.setValue(row, i, ...);
+// At the end:
+buffer.flushTo(storage);
+@endcode */
+class OSIMCOMMON_API ResultBuffer {
+public:
+    ResultBuffer() = default;
+    /** Buffer rows of `numColumns` values (not counting the time), with
+    space for `capacity` rows allocated up front.                           */
+    explicit ResultBuffer(int numColumns, int capacity = 128);
+
+    int getNumColumns() const { return _numColumns; }
+    int getNumRows() const { return _numRows; }
+    int getCapacity() const { return _capacity; }
+    /** Make space for at least `capacity` rows.                             */
+    void reserve(int capacity);
+    /** Remove all rows, keeping the allocated space.                        */
+    void clear() { _numRows = 0; }
+
+    /** Append a row at time `time` whose values are all `value`, and return
+    its index. As with Storage::append(), if the time of the last row is
+    `time`, that row is overwritten instead.                                 */
+    int appendRow(double time, double value = SimTK::NaN);
+    /** Append a row at time `time` with getNumColumns() values.             */
+    int appendRow(double time, const double* values);
+
+    double getTime(int row) const { return _times[row]; }
+    double getValue(int row, int column) const {
+        return _data[(size_t)column * _capacity + row];
+    }
+    void setValue(int row, int column, double value) {
+        _data[(size_t)column * _capacity + row] = value;
+    }
+    /** The getNumRows() values of a column, which are contiguous.           */
+    const double* getColumn(int column) const {
+        return _data.data() + (size_t)column * _capacity;
+    }
+
+    /** Append the rows to `storage`, in order, and remove them from this
+    buffer.                                                                   */
+    void flushTo(Storage& storage);
+
+private:
+    int _numColumns = 0;
+    int _numRows = 0;
+    int _capacity = 0;
+    std::vector<double> _times;
+    std::vector<double> _data;
+};
+
+} // namespace OpenSim
+
+#endif // OPENSIM_RESULTBUFFER_H_
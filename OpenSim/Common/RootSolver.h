@@ -89,6 +89,11 @@ private:
 public:
     Array<double> solve(const SimTK::State& s, const Array<double> &ax,const Array<double> &bx,
         const Array<double> &tol);
+    /** Solve for the roots, given the values of the function at the bounds
+    ax and bx (e.g., because the caller has already evaluated the function
+    there), so that the function is not evaluated at the bounds again. */
+    Array<double> solve(const SimTK::State& s, const Array<double> &ax,const Array<double> &bx,
+        const Array<double> &fax,const Array<double> &fbx,const Array<double> &tol);
 
 //=============================================================================
 };  // END class RootSolver
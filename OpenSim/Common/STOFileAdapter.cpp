@@ -25,7 +25,8 @@ namespace OpenSim {
 
 std::shared_ptr<DataAdapter> 
 createSTOFileAdapterForReading(const std::string& fileName) {
-    std::ifstream file{fileName};
+    auto file_ptr = FileAdapter::openInputStream(fileName);
+    auto& file = *file_ptr;
 
     std::regex keyvalue{R"((.*)=(.*))"};
     std::string line{};
@@ -28,8 +28,12 @@
 
 // INCLUDES
 #include <math.h>
+#include <algorithm>
+#include <atomic>
 #include "Signal.h"
 #include "Array.h"
+#include "CommonUtilities.h"
+#include "Logger.h"
 #include "SimTKcommon/Constants.h"
 #include "SimTKcommon/Orientation.h"
 #include "SimTKcommon/Scalar.h"
@@ -479,6 +483,170 @@ Pad(int aPad,Array<double> &rSignal)
 }
 
 
+//-----------------------------------------------------------------------------
+// MULTICOLUMN FILTERS
+//-----------------------------------------------------------------------------
+namespace {
+// Number of columns filtered together. Within a block, samples are stored
+// row by row, so the innermost loops run across the columns of the block.
+const int BlockSize = 8;
+
+// Filter the columns of a matrix in blocks of BlockSize columns, in parallel.
+// filterBlock(firstColumn, numColumns) filters one block.
+template <typename F>
+void filterColumnBlocks(const SimTK::MatrixBase<double>& signals,
+        const F& filterBlock) {
+    const int nc = signals.ncol();
+    const int numBlocks = (nc + BlockSize - 1) / BlockSize;
+    // Threads are not worth starting for small matrices.
+    const int numThreads = (double)signals.nrow() * nc > 1e5 ? 0 : 1;
+    parallelFor(numBlocks, [&](int block) {
+        const int c0 = block * BlockSize;
+        filterBlock(c0, std::min(BlockSize, nc - c0));
+    }, numThreads);
+}
+
+// Apply the recursion of Signal::LowpassIIR() to the w columns of x (N rows,
+// stored row by row), writing to y.
+void applyIIR(const double a[4], const double b[4], int N, int w,
+        const double* x, double* y) {
+    int i,c;
+    // FILL THE 1ST THREE TERMS
+    for (i=0;i<4*w;i++) y[i] = x[i];
+    // IMPLEMENT THE FORMULA
+    for (i=3;i<N;i++) {
+        const double* x0 = x + i*w;
+        double* y0 = y + i*w;
+        for (c=0;c<w;c++) {
+            y0[c] = a[0]*x0[c] + a[1]*x0[c-w] + a[2]*x0[c-2*w] + a[3]*x0[c-3*w]
+                    - b[1]*y0[c-w] - b[2]*y0[c-2*w] - b[3]*y0[c-3*w];
+        }
+    }
+}
+}
+
+int Signal::
+LowpassIIR(double T,double fc,SimTK::MatrixBase<double>& rSignals)
+{
+    const int N = rSignals.nrow();
+    if(T==0) return(-1);
+    if(N<4) return(-1);
+
+    // CHECK THAT THE CUTOFF FREQUENCY IS LESS THAN HALF THE SAMPLE FREQUENCY
+    double fs = 1 / T;
+    if (fc >= 0.5 * fs) {
+        fc = 0.49 * fs;
+        log_warn("Cutoff frequency should be less than half sample frequency. "
+                 "Changing the cutoff frequency to 0.49*(Sample Frequency)..."
+                 "cutoff = {}", fc);
+    }
+
+    // COEFFICIENTS, AS IN THE SINGLE-SIGNAL FILTER
+    double wc = 2*SimTK_PI*fc;
+    double wa = tan(wc*T/2.0);
+    double wa2 = wa*wa;
+    double wa3 = wa*wa*wa;
+    double denom = (wa+1) * (wa*wa + wa + 1.0);
+    double a[4], b[4];
+    a[0] = wa3 / denom;
+    a[1] = 3*wa3 / denom;
+    a[2] = 3*wa3 / denom;
+    a[3] = wa3 / denom;
+    b[0] = 1;
+    b[1] = (3*wa3 + 2*wa2 - 2*wa - 3) / denom;
+    b[2] = (3*wa3 - 2*wa2 - 2*wa + 3) / denom;
+    b[3] = (wa - 1) * (wa2 - wa + 1) / denom;
+
+    filterColumnBlocks(rSignals, [&](int c0, int w) {
+        std::vector<double> x((size_t)N*w), y((size_t)N*w);
+        for (int i=0;i<N;i++)
+            for (int c=0;c<w;c++) x[i*w+c] = rSignals(i,c0+c);
+        // FILTER FORWARD, THEN FILTER THE REVERSED RESULT
+        applyIIR(a,b,N,w,x.data(),y.data());
+        for (int i=0,j=N-1;i<N;i++,j--)
+            for (int c=0;c<w;c++) x[i*w+c] = y[j*w+c];
+        applyIIR(a,b,N,w,x.data(),y.data());
+        // REVERSE BACK INTO THE MATRIX
+        for (int i=0,j=N-1;i<N;i++,j--)
+            for (int c=0;c<w;c++) rSignals(i,c0+c) = y[j*w+c];
+    });
+    return(0);
+}
+
+int Signal::
+LowpassFIR(int M,double T,double f,SimTK::MatrixBase<double>& rSignals)
+{
+    const int N = rSignals.nrow();
+
+    // CHECK THAT M IS NOT TOO LARGE RELATIVE TO N
+    if((M+M)>N) {
+        log_error("rdSingal.lowpassFIR: The number of data points ({}) "
+                  "should be at least twice the order of the filter ({}).",
+                N, M);
+        return(-1);
+    }
+
+    // COEFFICIENTS, AS IN THE SINGLE-SIGNAL FILTER
+    double w = 2.0*SimTK_PI*f;
+    std::vector<double> coefs(2*M+1);
+    double sum_coef = 0.0;
+    for(int k=-M;k<=M;k++) {
+        double x = (double)k*w*T;
+        coefs[k+M] = (sinc(x)*T*w/SimTK_PI)*hamming(k,M);
+        sum_coef = sum_coef + coefs[k+M];
+    }
+
+    filterColumnBlocks(rSignals, [&](int c0, int nw) {
+        // ONE PADDED BUFFER FOR ALL COLUMNS OF THE BLOCK (SEE Pad())
+        const int size = N + 2*M;
+        std::vector<double> s((size_t)size*nw);
+        for (int c=0;c<nw;c++) {
+            const double first = rSignals(0,c0+c);
+            const double last = rSignals(N-1,c0+c);
+            for (int i=0;i<M;i++)
+                s[i*nw+c] = 2.0*first - rSignals(M-i,c0+c);
+            for (int i=0;i<N;i++)
+                s[(M+i)*nw+c] = rSignals(i,c0+c);
+            for (int i=0;i<M;i++)
+                s[(M+N+i)*nw+c] = 2.0*last - rSignals(N-2-i,c0+c);
+        }
+
+        // FILTER THE DATA
+        double sigf[BlockSize];
+        for (int n=0;n<N;n++) {
+            for (int c=0;c<nw;c++) sigf[c] = 0.0;
+            for (int k=-M;k<=M;k++) {
+                const double coef = coefs[k+M];
+                const double* s0 = &s[(size_t)(M+n-k)*nw];
+                for (int c=0;c<nw;c++) sigf[c] = sigf[c] + coef*s0[c];
+            }
+            for (int c=0;c<nw;c++)
+                rSignals(n,c0+c) = sigf[c] / sum_coef; // normalize for unity gain at DC
+        }
+    });
+    return(0);
+}
+
+int Signal::
+SmoothSpline(int degree,double T,double fc,const double *times,
+        SimTK::MatrixBase<double>& rSignals)
+{
+    const int N = rSignals.nrow();
+    const int nc = rSignals.ncol();
+    // Each column is fit separately, so the columns are simply distributed
+    // across threads.
+    std::atomic<bool> failed(false);
+    parallelFor(nc, [&](int c) {
+        std::vector<double> sig(N), sigf(N);
+        for (int i=0;i<N;i++) sig[i] = rSignals(i,c);
+        std::vector<double> tc(times, times + N);
+        if (SmoothSpline(degree,T,fc,N,tc.data(),sig.data(),sigf.data()) != 0)
+            failed = true;
+        for (int i=0;i<N;i++) rSignals(i,c) = sigf[i];
+    });
+    return failed ? -1 : 0;
+}
+
 //-----------------------------------------------------------------------------
 // POINT REDUCTION
 //-----------------------------------------------------------------------------
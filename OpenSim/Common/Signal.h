@@ -30,6 +30,8 @@
 #include "osimCommonDLL.h"
 #include <vector>
 
+#include <SimTKcommon/internal/BigMatrix.h>
+
 namespace OpenSim {
 
 template <class T> class Array;
@@ -72,6 +74,31 @@ public:
         double aLowFrequency,double aHighFrequency,
         int aN,double *aSignal,double *aFilteredSignal);
 
+#ifndef SWIG
+    //--------------------------------------------------------------------------
+    // MULTICOLUMN FILTERS
+    //--------------------------------------------------------------------------
+    /// Filter every column of a matrix in place; each column is a signal and
+    /// each row a sample. The result for each column is identical to that of
+    /// the single-signal filter of the same name. Columns are filtered in
+    /// blocks, stored so that the filter recursion runs across all columns
+    /// of a block at once (allowing the compiler to vectorize it), and the
+    /// blocks are distributed across threads.
+    /// @return 0 on success, and -1 on failure.
+    /// @{
+    static int
+        LowpassIIR(double aDeltaT,double aCutOffFrequency,
+        SimTK::MatrixBase<double>& rSignals);
+    static int
+        LowpassFIR(int aOrder,double aDeltaT,double aCutoffFrequency,
+        SimTK::MatrixBase<double>& rSignals);
+    /// `aTimes` holds the time of each row.
+    static int
+        SmoothSpline(int aDegree,double aDeltaT,double aCutOffFrequency,
+        const double *aTimes,SimTK::MatrixBase<double>& rSignals);
+    /// @}
+#endif
+
     //--------------------------------------------------------------------------
     // PADDING
     //--------------------------------------------------------------------------
@@ -126,6 +126,9 @@ public:
 
     void updateFromXMLNode(SimTK::Xml::Element& aNode, int versionNumber=-1) override;
 
+protected:
+    double calcValueWithHint(double x, int& interval) const override;
+
 private:
     void calcCoefficients();
 //=============================================================================
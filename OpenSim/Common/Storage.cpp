@@ -39,69 +39,15 @@
 #include "SimTKcommon.h"
 #include "SimmMacros.h"
 #include "StateVector.h"
+#include "StorageInterpolator.h"
 #include "TableUtilities.h"
 #include "TimeSeriesTable.h"
+#include <cstdio>
 #include <iostream>
 
 using namespace OpenSim;
 using namespace std;
 
-void convertTableToStorage(const AbstractDataTable* table, Storage& sto)
-{
-    sto.purge();
-    TimeSeriesTable out;
-
-    if (auto td = dynamic_cast<const TimeSeriesTable*>(table))
-        // Table is already flattened, so clone for further processing
-        out = TimeSeriesTable{ *td };
-    else if (auto tst = dynamic_cast<const TimeSeriesTable_<SimTK::Vec2>*>(table))
-        out = tst->flatten();
-    else if (auto tst = dynamic_cast<const TimeSeriesTable_<SimTK::Vec3>*>(table))
-        out = tst->flatten({ "_x", "_y", "_z" });
-    else if (auto tst = dynamic_cast<const TimeSeriesTable_<SimTK::Vec4>*>(table))
-        out = tst->flatten();
-    else if (auto tst = dynamic_cast<const TimeSeriesTable_<SimTK::Vec5>*>(table))
-        out = tst->flatten();
-    else if (auto tst = dynamic_cast<const TimeSeriesTable_<SimTK::Vec6>*>(table))
-        out = tst->flatten();
-    else if (auto tst = dynamic_cast<const TimeSeriesTable_<SimTK::Vec7>*>(table))
-        out = tst->flatten();
-    else if (auto tst = dynamic_cast<const TimeSeriesTable_<SimTK::Vec8>*>(table))
-        out = tst->flatten();
-    else if (auto tst = dynamic_cast<const TimeSeriesTable_<SimTK::Vec9>*>(table))
-        out = tst->flatten();
-    else if (auto tst = dynamic_cast<const TimeSeriesTable_<SimTK::Vec<10>>*>(table))
-        out = tst->flatten();
-    else if (auto tst = dynamic_cast<const TimeSeriesTable_<SimTK::Vec<11>>*>(table))
-        out = tst->flatten();
-    else if (auto tst = dynamic_cast<const TimeSeriesTable_<SimTK::Vec<12>>*>(table))
-        out = tst->flatten();
-    else if (auto tst = dynamic_cast<const TimeSeriesTable_<SimTK::UnitVec3>*>(table))
-        out = tst->flatten({ "_x", "_y", "_z" });
-    else if (auto tst = dynamic_cast<const TimeSeriesTable_<SimTK::Quaternion>*>(table))
-        out = tst->flatten();
-    else if (auto tst = dynamic_cast<const TimeSeriesTable_<SimTK::SpatialVec>*>(table))
-        out = tst->flatten({ "_rx", "_ry", "_rz", "_tx", "_ty", "_tz" });
-    else {
-        OPENSIM_THROW( STODataTypeNotSupported, typeid(table).name());
-    }
-
-    OpenSim::Array<std::string> labels("", (int)out.getNumColumns() + 1);
-    labels[0] = "time";
-    for (int i = 0; i < (int)out.getNumColumns(); ++i) {
-        labels[i + 1] = out.getColumnLabel(i);
-    }
-    sto.setColumnLabels(labels);
-
-    const auto& times = out.getIndependentColumn();
-    for (unsigned i_time = 0; i_time < out.getNumRows(); ++i_time) {
-        const SimTK::Vector rowVector =
-            out.getRowAtIndex(i_time).transpose().getAsVector();
-        sto.append(times[i_time], rowVector);
-    }
-}
-
-
 //============================================================================
 // DEFINES
 //============================================================================
@@ -179,8 +125,9 @@ Storage::Storage(const string &fileName, bool readHeadersOnly) :
     setNull();
 
     // OPEN FILE
-    std::unique_ptr<ifstream> fp{IO::OpenInputFile(fileName)};
-    OPENSIM_THROW_IF(fp == nullptr, Exception,
+    // Compressed files (e.g., .sto.gz) are decompressed while being read.
+    std::unique_ptr<std::istream> fp{FileAdapter::openInputStream(fileName)};
+    OPENSIM_THROW_IF(!fp->good(), Exception,
             "Storage: Failed to open file '" + fileName +
             "'. Verify that the file exists at the specified location." );
 
@@ -216,7 +163,7 @@ Storage::Storage(const string &fileName, bool readHeadersOnly) :
                         "Only the first table '{}' will be loaded as Storage.",
                         tables.begin()->first);
             }
-            convertTableToStorage(tables.begin()->second.get(), *this);
+            setDataFromTable(tables.begin()->second.get());
             return;
         }
         catch (const std::exception& x) {
@@ -308,6 +255,24 @@ Storage::Storage(const string &fileName, bool readHeadersOnly) :
     }
 }
 //_____________________________________________________________________________
+/**
+ * Construct a Storage from a TimeSeriesTable.
+ */
+Storage::Storage(const TimeSeriesTable& table, const std::string& aName) :
+    StorageInterface(aName),
+    _storage(StateVector())
+{
+    // SET NULL STATES
+    setNull();
+
+    _fileVersion = Storage::LatestVersion;
+    setName(aName);
+    if (table.hasTableMetaDataKey("inDegrees"))
+        setInDegrees(TableUtilities::isInDegrees(table));
+
+    setDataFromTable(&table);
+}
+//_____________________________________________________________________________
 /**
  * Copy constructor.
  */
@@ -1139,6 +1104,25 @@ getDataAtTime(double aT,int aN,SimTK::Vector& v) const
         v[i] = rData[i];
     return r;
 }
+SimTK::Matrix Storage::
+getDataAtTimes(const std::vector<double>& times,
+        const std::vector<std::string>& columnNames) const
+{
+    std::vector<int> columns;
+    columns.reserve(columnNames.size());
+    for (const auto& name : columnNames) {
+        const int index = getStateIndex(name);
+        OPENSIM_THROW_IF(index < 0, Exception,
+                "Storage: column '" + name + "' not found.");
+        columns.push_back(index);
+    }
+    // Copy only the requested columns; column i of the interpolator is
+    // columns[i].
+    std::vector<int> interpolatorColumns(columns.size());
+    for (int i = 0; i < (int)columns.size(); ++i) interpolatorColumns[i] = i;
+    return StorageInterpolator(*this, columns)
+            .getDataAtTimes(times, interpolatorColumns);
+}
 //_____________________________________________________________________________
 /**
  * Get the data corresponding to a specified state.  This call is equivalent
@@ -1330,7 +1314,40 @@ Storage::getColumnIndicesForIdentifier(const std::string& identifier) const
 }
 
 TimeSeriesTable Storage::exportToTable() const {
-    TimeSeriesTable table{};
+    const int nrow = _storage.getSize();
+    // Exclude the first column label. It is 'time'. Time is a separate column
+    // in TimeSeriesTable and column label is optional.
+    const bool hasLabels = _columnLabels.size() > 1;
+    const int ncol = hasLabels ? _columnLabels.getSize() - 1 :
+                     (nrow > 0 ? getStateVector(0)->getSize() : 0);
+
+    // Fill the table's matrix in one pass. Appending one row at a time would
+    // reallocate the matrix for every row.
+    std::vector<double> times(nrow);
+    SimTK::Matrix matrix(nrow, ncol);
+    for(int i = 0; i < nrow; ++i) {
+        const StateVector& vec = *getStateVector(i);
+        const auto& row = vec.getData();
+        OPENSIM_THROW_IF(row.getSize() != ncol, IncorrectNumColumns,
+                ncol, row.getSize());
+        times[i] = vec.getTime();
+        for(int j = 0; j < ncol; ++j)
+            matrix(i, j) = row[j];
+    }
+
+    std::vector<std::string> labels;
+    if(hasLabels)
+        labels.assign(_columnLabels.get() + 1,
+                      _columnLabels.get() + _columnLabels.getSize());
+    else
+        // Placeholder labels let the table take the matrix as a whole; they
+        // are removed below since this storage has no column labels.
+        for(int j = 0; j < ncol; ++j)
+            labels.push_back(std::to_string(j));
+
+    TimeSeriesTable table{times, matrix, labels};
+    if(!hasLabels)
+        table.removeDependentsMetaDataForKey("labels");
 
     table.addTableMetaData("header", getName());
     table.addTableMetaData("inDegrees", std::string{_inDegrees ? "yes" : "no"});
@@ -1339,22 +1356,76 @@ TimeSeriesTable Storage::exportToTable() const {
     if(!getDescription().empty())
         table.addTableMetaData("description", getDescription());
 
-    // Exclude the first column label. It is 'time'. Time is a separate column
-    // in TimeSeriesTable and column label is optional.
-    if (_columnLabels.size() > 1) {
-        table.setColumnLabels(_columnLabels.get() + 1,
-                _columnLabels.get() + _columnLabels.getSize());
+    return table;
+}
+
+//_____________________________________________________________________________
+/**
+ * Replace the contents of this storage with the data of a table. Tables of
+ * non-scalar elements (e.g., Vec3) are flattened into scalar columns.
+ */
+void Storage::setDataFromTable(const AbstractDataTable* table)
+{
+    purge();
+
+    // Scalar tables are read directly; only other element types require an
+    // intermediate (flattened) copy.
+    TimeSeriesTable flattened;
+    const TimeSeriesTable* out = dynamic_cast<const TimeSeriesTable*>(table);
+    if (out) {
+        // Nothing to convert.
+    } else if (auto tst = dynamic_cast<const TimeSeriesTable_<SimTK::Vec2>*>(table))
+        flattened = tst->flatten();
+    else if (auto tst = dynamic_cast<const TimeSeriesTable_<SimTK::Vec3>*>(table))
+        flattened = tst->flatten({ "_x", "_y", "_z" });
+    else if (auto tst = dynamic_cast<const TimeSeriesTable_<SimTK::Vec4>*>(table))
+        flattened = tst->flatten();
+    else if (auto tst = dynamic_cast<const TimeSeriesTable_<SimTK::Vec5>*>(table))
+        flattened = tst->flatten();
+    else if (auto tst = dynamic_cast<const TimeSeriesTable_<SimTK::Vec6>*>(table))
+        flattened = tst->flatten();
+    else if (auto tst = dynamic_cast<const TimeSeriesTable_<SimTK::Vec7>*>(table))
+        flattened = tst->flatten();
+    else if (auto tst = dynamic_cast<const TimeSeriesTable_<SimTK::Vec8>*>(table))
+        flattened = tst->flatten();
+    else if (auto tst = dynamic_cast<const TimeSeriesTable_<SimTK::Vec9>*>(table))
+        flattened = tst->flatten();
+    else if (auto tst = dynamic_cast<const TimeSeriesTable_<SimTK::Vec<10>>*>(table))
+        flattened = tst->flatten();
+    else if (auto tst = dynamic_cast<const TimeSeriesTable_<SimTK::Vec<11>>*>(table))
+        flattened = tst->flatten();
+    else if (auto tst = dynamic_cast<const TimeSeriesTable_<SimTK::Vec<12>>*>(table))
+        flattened = tst->flatten();
+    else if (auto tst = dynamic_cast<const TimeSeriesTable_<SimTK::UnitVec3>*>(table))
+        flattened = tst->flatten({ "_x", "_y", "_z" });
+    else if (auto tst = dynamic_cast<const TimeSeriesTable_<SimTK::Quaternion>*>(table))
+        flattened = tst->flatten();
+    else if (auto tst = dynamic_cast<const TimeSeriesTable_<SimTK::SpatialVec>*>(table))
+        flattened = tst->flatten({ "_rx", "_ry", "_rz", "_tx", "_ty", "_tz" });
+    else {
+        OPENSIM_THROW( STODataTypeNotSupported, typeid(table).name());
     }
+    if (!out) out = &flattened;
 
-    for(int i = 0; i < _storage.getSize(); ++i) {
-        const auto& row = getStateVector(i)->getData();
-        const auto time = getStateVector(i)->getTime();
-        // Exclude the first column. It is 'time'. Time is a separate column in
-        // TimeSeriesTable.
-        table.appendRow(time, row.get(), row.get() + row.getSize());
+    const int ncol = (int)out->getNumColumns();
+    const int nrow = (int)out->getNumRows();
+    OpenSim::Array<std::string> labels("", ncol + 1);
+    labels[0] = "time";
+    for (int i = 0; i < ncol; ++i) {
+        labels[i + 1] = out->getColumnLabel(i);
     }
+    setColumnLabels(labels);
 
-    return table;
+    _storage.ensureCapacity(nrow);
+    const auto& times = out->getIndependentColumn();
+    const SimTK::Matrix& matrix = out->getMatrix();
+    SimTK::Vector rowVector(ncol);
+    for (int i_time = 0; i_time < nrow; ++i_time) {
+        for (int j = 0; j < ncol; ++j)
+            rowVector[j] = matrix(i_time, j);
+        _storage.setSize(_storage.getSize() + 1);
+        _storage.updLast().setStates(times[i_time], rowVector);
+    }
 }
 
 
@@ -1471,6 +1542,23 @@ append(const Array<StateVector> &aStorage)
     return(_storage.getSize());
 }
 //_____________________________________________________________________________
+/**
+ * Append copies of all state vectors of another Storage object (e.g., the
+ * results of an analysis performed on later times).
+ *
+ * @param aStorage Storage whose state vectors are appended.
+ * @param aCheckForDuplicateTime If true, a state vector with the same time
+ * as the last state vector replaces it.
+ * @return Size of the storage after the append.
+ */
+int Storage::
+append(const Storage &aStorage,bool aCheckForDuplicateTime)
+{
+    for(int i=0; i<aStorage.getSize(); i++)
+        append(aStorage._storage[i],aCheckForDuplicateTime);
+    return(_storage.getSize());
+}
+//_____________________________________________________________________________
 /**
  * Append an array of data that occurred at a specified time.
  *
@@ -1486,15 +1574,19 @@ append(double aT,int aN,const double *aY,bool aCheckForDuplicateTime)
     if(aN<0) return(_storage.getSize());
 
     // APPEND
-    StateVector vec(aT, SimTK::Vector_<double>(aN, aY));
-    append(vec,aCheckForDuplicateTime);
+    // Fill the new (or duplicate-time) row in place rather than copying a
+    // temporary StateVector into the array.
     // TODO: use some tolerance when checking for duplicate time?
-    /*
-    if(aCheckForDuplicateTime && _storage.getSize() && _storage.getLast().getTime()==vec.getTime())
-        _storage.getLast() = vec;
-    else
-        _storage.append(vec);
-    */
+    if(!(aCheckForDuplicateTime && _storage.getSize() &&
+            _storage.getLast().getTime()==aT))
+        _storage.setSize(_storage.getSize()+1);
+    StateVector& vec = _storage.updLast();
+    vec.setStates(aT, SimTK::Vector_<double>(aN, aY));
+
+    if (_fp!=0){
+        vec.print(_fp);
+        fflush(_fp);
+    }
     return(_storage.getSize());
 }
 //_____________________________________________________________________________
@@ -2352,6 +2444,68 @@ pad(int aPadSize)
     delete[] vecs;
 }
 
+namespace {
+// Storage prints through a FILE*. For a compressed file name, it prints to an
+// anonymous temporary file whose contents are then compressed into the file.
+FILE* openFileForPrinting(const std::string& fileName, const std::string& mode)
+{
+    if(FileAdapter::findCompressionExtension(fileName).empty())
+        return IO::OpenFile(fileName, mode);
+    if(mode != "w") {
+        log_error("Storage.print: cannot append to compressed file {}.",
+                fileName);
+        return NULL;
+    }
+    return std::tmpfile();
+}
+
+// Close a file opened by openFileForPrinting(), compressing its contents
+// into the named file if needed. Returns false if the file could not be
+// written.
+bool closeFileForPrinting(FILE* fp, const std::string& fileName)
+{
+    bool success = true;
+    if(!FileAdapter::findCompressionExtension(fileName).empty()) {
+        std::unique_ptr<std::ostream> out{
+                FileAdapter::openOutputStream(fileName)};
+        std::rewind(fp);
+        char buffer[1 << 16];
+        std::size_t n;
+        while(out->good() &&
+                (n = std::fread(buffer, 1, sizeof(buffer), fp)) > 0) {
+            out->write(buffer, n);
+        }
+        FileAdapter::closeOutputStream(*out);
+        success = out->good();
+        if(!success) {
+            log_error("Storage.print: failed to write compressed file {}.",
+                    fileName);
+        }
+    }
+    fclose(fp);
+    return success;
+}
+
+// Copy the first nc columns of the data of a Storage into a matrix with a row
+// for each state vector, so that all columns can be filtered at once.
+SimTK::Matrix getDataMatrix(const Storage& storage, int nc) {
+    const int size = storage.getSize();
+    SimTK::Matrix data(size, nc);
+    for (int i = 0; i < size; ++i) {
+        const Array<double>& row = storage.getStateVector(i)->getData();
+        for (int j = 0; j < nc; ++j) data(i, j) = row[j];
+    }
+    return data;
+}
+// Copy a matrix created by getDataMatrix() back into the Storage.
+void setDataMatrix(Storage& storage, const SimTK::Matrix& data) {
+    for (int i = 0; i < data.nrow(); ++i) {
+        Array<double>& row = storage.getStateVector(i)->getData();
+        for (int j = 0; j < data.ncol(); ++j) row[j] = data(i, j);
+    }
+}
+}
+
 void Storage::
 smoothSpline(int aOrder,double aCutoffFrequency)
 {
@@ -2375,21 +2529,18 @@ smoothSpline(int aOrder,double aCutoffFrequency)
         return;
     }
 
-    // LOOP OVER COLUMNS
+    // FILTER ALL COLUMNS AT ONCE
     double *times=NULL;
-    int nc = getSmallestNumberOfStates();
-    double *signal=NULL;
-    Array<double> filt(0.0,size);
     getTimeColumn(times,0);
-    for(int i=0;i<nc;i++) {
-        getDataColumn(i,signal);
-        Signal::SmoothSpline(aOrder,dtmin,aCutoffFrequency,size,times,signal,&filt[0]);
-        setDataColumn(i,filt);
-    }
+    SimTK::Matrix data = getDataMatrix(*this, getSmallestNumberOfStates());
+    if(Signal::SmoothSpline(aOrder,dtmin,aCutoffFrequency,times,data)!=0)
+        log_error("Storage.SmoothSpline: failed to filter; the data is "
+                  "left unfiltered.");
+    else
+        setDataMatrix(*this, data);
 
     // CLEANUP
     delete[] times;
-    delete[] signal;
 }
 
 void Storage::
@@ -2415,18 +2566,13 @@ lowpassIIR(double aCutoffFrequency)
         return;
     }
 
-    // LOOP OVER COLUMNS
-    int nc = getSmallestNumberOfStates();
-    double *signal=NULL;
-    Array<double> filt(0.0,size);
-    for(int i=0;i<nc;i++) {
-        getDataColumn(i,signal);
-        Signal::LowpassIIR(dtmin,aCutoffFrequency,size,signal,&filt[0]);
-        setDataColumn(i,filt);
-    }
-
-    // CLEANUP
-    delete[] signal;
+    // FILTER ALL COLUMNS AT ONCE
+    SimTK::Matrix data = getDataMatrix(*this, getSmallestNumberOfStates());
+    if(Signal::LowpassIIR(dtmin,aCutoffFrequency,data)!=0)
+        log_error("Storage.lowpassIIR: failed to filter; the data is left "
+                  "unfiltered.");
+    else
+        setDataMatrix(*this, data);
 }
 
 void Storage::
@@ -2452,18 +2598,13 @@ lowpassFIR(int aOrder,double aCutoffFrequency)
         return;
     }
 
-    // LOOP OVER COLUMNS
-    int nc = getSmallestNumberOfStates();
-    double *signal=NULL;
-    Array<double> filt(0.0,size);
-    for(int i=0;i<nc;i++) {
-        getDataColumn(i,signal);
-        Signal::LowpassFIR(aOrder,dtmin,aCutoffFrequency,size,signal,&filt[0]);
-        setDataColumn(i,filt);
-    }
-
-    // CLEANUP
-    delete[] signal;
+    // FILTER ALL COLUMNS AT ONCE
+    SimTK::Matrix data = getDataMatrix(*this, getSmallestNumberOfStates());
+    if(Signal::LowpassFIR(aOrder,dtmin,aCutoffFrequency,data)!=0)
+        log_error("Storage.lowpassFIR: failed to filter; the data is left "
+                  "unfiltered.");
+    else
+        setDataMatrix(*this, data);
 }
 
 
@@ -2708,7 +2849,7 @@ bool Storage::
 print(const string &aFileName,const string &aMode, const string& aComment) const
 {
     // OPEN THE FILE
-    FILE *fp = IO::OpenFile(aFileName,aMode);
+    FILE *fp = openFileForPrinting(aFileName,aMode);
     if(fp==NULL) return(false);
 
     // WRITE THE HEADER
@@ -2760,7 +2901,7 @@ print(const string &aFileName,const string &aMode, const string& aComment) const
     }
 
     // CLOSE
-    fclose(fp);
+    if(!closeFileForPrinting(fp,aFileName)) return(false);
 
     return(nTotal!=0);
 }
@@ -2786,7 +2927,7 @@ print(const string &aFileName,double aDT,const string &aMode) const
 
     if (_fp!= NULL) fclose(_fp);
     // OPEN THE FILE
-    FILE *fp = IO::OpenFile(aFileName,aMode);
+    FILE *fp = openFileForPrinting(aFileName,aMode);
     if(fp==NULL) return(-1);
 
     // HOW MANY TIME STEPS?
@@ -2851,8 +2992,8 @@ print(const string &aFileName,double aDT,const string &aMode) const
     }
 
     // CLEANUP
-    fclose(fp);
     if(y!=NULL) { delete[] y;  y=NULL; }
+    if(!closeFileForPrinting(fp,aFileName)) return(-1);
 
     return(nTotal);
 }
@@ -3112,7 +3253,7 @@ bool Storage::isSimmReservedToken(const std::string& aToken)
  *
  * @returns true on success (meaningful values of rNumRows, rNumColumns)
  */
-bool Storage::parseHeaders(std::ifstream& aStream, int& rNumRows, int& rNumColumns)
+bool Storage::parseHeaders(std::istream& aStream, int& rNumRows, int& rNumColumns)
 {
     bool done=false;
     bool firstLine=true;
@@ -128,6 +128,11 @@ public:
     Please use FileAdapter (STOFileAdpater, C3DFileAdapter, ...) and TimeSeriesTable
     instead, whenever possible. */
     Storage(const std::string &aFileName, bool readHeadersOnly=false) SWIG_DECLARE_EXCEPTION;
+    /** Copy the data and column labels of a TimeSeriesTable into a Storage.
+    The table is read in a single pass; prefer this to appending the rows of
+    the table one at a time. The "inDegrees" metadata, if any, is kept. */
+    explicit Storage(const TimeSeriesTable& table,
+            const std::string& aName="UNKNOWN");
     Storage(const Storage &aStorage,bool aCopyData=true);
     Storage(const Storage &aStorage,int aStateIndex,int aN,
         const char *aDelimiter="\t");
@@ -155,7 +160,8 @@ private:
     void setNull();
     void copyData(const Storage &aStorage);
     void parseColumnLabels(const char *aLabels);
-    bool parseHeaders(std::ifstream& aStream, int& rNumRows, int& rNumColumns);
+    void setDataFromTable(const AbstractDataTable* table);
+    bool parseHeaders(std::istream& aStream, int& rNumRows, int& rNumColumns);
     bool isSimmReservedToken(const std::string& aToken);
     void postProcessSIMMMotion();
     void exchangeTimeColumnWith(int aColumnIndex);
@@ -198,6 +204,14 @@ public:
     int getDataAtTime(double aTime,int aN,double *rData) const;
     int getDataAtTime(double aTime,int aN,Array<double> &rData) const override;
     int getDataAtTime(double aTime,int aN,SimTK::Vector& v) const;
+    /** Linearly interpolate the named columns at each of the given times, as
+    getDataAtTime() does. The result has a row for each time and a column for
+    each name. Column names are resolved with getStateIndex(). Each call
+    copies the requested columns; for repeated queries, construct a
+    StorageInterpolator once and use its Cursor.
+    @throws Exception if a column name is not found. */
+    SimTK::Matrix getDataAtTimes(const std::vector<double>& times,
+            const std::vector<std::string>& columnNames) const;
     int getDataColumn(int aStateIndex,double *&rData) const;
     int getDataColumn(int aStateIndex,Array<double> &rData) const;
     // Set entries in a column of the storage to a fixed value, 
@@ -264,6 +278,9 @@ public:
     //--------------------------------------------------------------------------
     int append(const StateVector &aVec, bool aCheckForDuplicateTime=true) override;
     int append(const Array<StateVector> &aArray) override;
+    /** Append copies of the rows of another storage, which is expected to
+    have the same columns as this storage. */
+    int append(const Storage &aStorage, bool aCheckForDuplicateTime=true);
     int append(double aT,int aN,const double *aY, bool aCheckForDuplicateTime=true) override;
     int append(double aT,const SimTK::Vector& aY, bool aCheckForDuplicateTime=true) override;
     virtual int append(double aT,const Array<double>& aY, bool aCheckForDuplicateTime=true);
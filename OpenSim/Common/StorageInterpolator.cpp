@@ -0,0 +1,174 @@
+/* -------------------------------------------------------------------------- *
+ *                     OpenSim:  StorageInterpolator.cpp                      *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2021 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "StorageInterpolator.h"
+
+#include "Exception.h"
+#include "Storage.h"
+
+#include <algorithm>
+
+using namespace OpenSim;
+
+//=============================================================================
+// STORAGE INTERPOLATOR
+//=============================================================================
+StorageInterpolator::StorageInterpolator(const Storage& storage) {
+    const int numRows = storage.getSize();
+    std::vector<int> columns(
+            numRows > 0 ? storage.getSmallestNumberOfStates() : 0);
+    for (int icol = 0; icol < (int)columns.size(); ++icol) {
+        columns[icol] = icol;
+    }
+    copyColumns(storage, columns);
+}
+
+StorageInterpolator::StorageInterpolator(const Storage& storage,
+        const std::vector<int>& columns) {
+    const int numStates =
+            storage.getSize() > 0 ? storage.getSmallestNumberOfStates() : 0;
+    for (const auto& column : columns) {
+        OPENSIM_THROW_IF(column < 0 || column >= numStates, IndexOutOfRange,
+                column, 0, numStates - 1);
+    }
+    copyColumns(storage, columns);
+}
+
+void StorageInterpolator::copyColumns(const Storage& storage,
+        const std::vector<int>& columns) {
+    _numRows = storage.getSize();
+    _numColumns = static_cast<int>(columns.size());
+
+    _times.resize(_numRows);
+    _data.resize(static_cast<size_t>(_numRows) * _numColumns);
+    for (int irow = 0; irow < _numRows; ++irow) {
+        const StateVector& row = *storage.getStateVector(irow);
+        _times[irow] = row.getTime();
+        const Array<double>& values = row.getData();
+        for (int icol = 0; icol < _numColumns; ++icol) {
+            _data[static_cast<size_t>(icol) * _numRows + irow] =
+                    values[columns[icol]];
+        }
+    }
+}
+
+const double* StorageInterpolator::getColumn(int column) const {
+    OPENSIM_THROW_IF(column < 0 || column >= _numColumns, IndexOutOfRange,
+            column, 0, _numColumns - 1);
+    return _data.data() + static_cast<size_t>(column) * _numRows;
+}
+
+int StorageInterpolator::findIndex(double time, int hint) const {
+    if (_numRows <= 0) return -1;
+    if (hint < 0 || hint >= _numRows) hint = 0;
+
+    // Walk a few rows from the hint; this is all that is needed when the
+    // query times are monotonic and spaced like the data.
+    static const int maxSteps = 4;
+    int i = hint;
+    for (int step = 0; step < maxSteps; ++step) {
+        if (time < _times[i]) {
+            if (i == 0) return 0;
+            --i;
+        } else if (i + 1 < _numRows && !(time < _times[i + 1])) {
+            ++i;
+        } else {
+            return i;
+        }
+    }
+
+    // Otherwise, fall back to a binary search.
+    const auto upper = std::upper_bound(_times.begin(), _times.end(), time);
+    return std::max(0, static_cast<int>(upper - _times.begin()) - 1);
+}
+
+double StorageInterpolator::getValueAtTime(double time, int column) const {
+    Cursor cursor(*this);
+    cursor.seek(time);
+    return cursor.getValue(column);
+}
+
+SimTK::Matrix StorageInterpolator::getDataAtTimes(
+        const std::vector<double>& times,
+        const std::vector<int>& columns) const {
+    const int numTimes = static_cast<int>(times.size());
+    const int numRequested = static_cast<int>(columns.size());
+    for (const auto& column : columns) {
+        OPENSIM_THROW_IF(column < 0 || column >= _numColumns,
+                IndexOutOfRange, column, 0, _numColumns - 1);
+    }
+
+    SimTK::Matrix result(numTimes, numRequested);
+    Cursor cursor(*this);
+    for (int itime = 0; itime < numTimes; ++itime) {
+        cursor.seek(times[itime]);
+        for (int icol = 0; icol < numRequested; ++icol) {
+            result(itime, icol) = cursor.getValue(columns[icol]);
+        }
+    }
+    return result;
+}
+
+//=============================================================================
+// CURSOR
+//=============================================================================
+StorageInterpolator::Cursor::Cursor(const StorageInterpolator& interpolator) :
+        _interpolator(&interpolator) {}
+
+void StorageInterpolator::Cursor::seek(double time) {
+    _time = time;
+    const int numRows = _interpolator->_numRows;
+    if (numRows <= 0) return;
+
+    _index = _interpolator->findIndex(time, _index);
+
+    // Use the last two rows beyond the end of the data, as
+    // Storage::getDataAtTime() does.
+    _row1 = _index;
+    _row2 = _index + 1;
+    if (_row2 == numRows) {
+        _row1 = std::max(_row1 - 1, 0);
+        _row2 = numRows - 1;
+    }
+
+    const double t1 = _interpolator->_times[_row1];
+    const double t2 = _interpolator->_times[_row2];
+    const double den = t2 - t1;
+    _fraction = den < SimTK::Eps ? 0.0 : (time - t1) / den;
+}
+
+double StorageInterpolator::Cursor::getValue(int column) const {
+    SimTK_INDEXCHECK(column, _interpolator->_numColumns,
+            "StorageInterpolator::Cursor::getValue()");
+    const double* y = _interpolator->_data.data() +
+                      static_cast<size_t>(column) * _interpolator->_numRows;
+    const double y1 = y[_row1];
+    if (_fraction == 0.0) return y1;
+    return y1 + _fraction * (y[_row2] - y1);
+}
+
+void StorageInterpolator::Cursor::getValues(int n, double* values) const {
+    n = std::min(n, _interpolator->_numColumns);
+    for (int icol = 0; icol < n; ++icol) {
+        values[icol] = getValue(icol);
+    }
+}
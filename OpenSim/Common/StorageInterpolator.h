@@ -0,0 +1,130 @@
+#ifndef OPENSIM_STORAGE_INTERPOLATOR_H_
+#define OPENSIM_STORAGE_INTERPOLATOR_H_
+/* -------------------------------------------------------------------------- *
+ *                      OpenSim:  StorageInterpolator.h                       *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2021 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "osimCommonDLL.h"
+#include "SimTKcommon.h"
+
+#include <vector>
+
+namespace OpenSim {
+
+class Storage;
+
+/** A column-major copy of the data in a Storage, for fast and repeated
+linear interpolation in time. Values are computed exactly as in
+Storage::getDataAtTime(): linear interpolation between the rows that bracket
+the requested time, and linear extrapolation from the first (last) two rows
+before (after) the time range of the data.
+
+Columns are indexed by state index, as in Storage::getStateIndex(); the time
+column is not a column of the interpolator. If the rows of the Storage have
+different lengths, only the columns present in every row are kept.
+
+The data is copied when the interpolator is constructed; later changes to
+the Storage are not reflected.
+
+@code{.cpp}
+StorageInterpolator interp(storage);
+StorageInterpolator::Cursor cursor(interp);
+for (double t : times) {
+    cursor.seek(t);
+    double value = cursor.getValue(column);
+}
+@endcode */
+class OSIMCOMMON_API StorageInterpolator {
+public:
+    /** A cursor remembers the rows that bracketed the previous query time,
+    so the bracket for the next time is found in O(1) amortized when query
+    times are monotonic (increasing or decreasing). Random access falls back
+    to a binary search. The StorageInterpolator must outlive the cursor.    */
+    class OSIMCOMMON_API Cursor {
+    public:
+        explicit Cursor(const StorageInterpolator& interpolator);
+
+        /** Move the cursor to the given time.                               */
+        void seek(double time);
+        /** The time passed to the last call to seek().                      */
+        double getTime() const { return _time; }
+        /** Index of the last row whose time is less than or equal to the
+        current time (0 if the time precedes the data), as returned by
+        Storage::findIndex().                                                 */
+        int getIndex() const { return _index; }
+        /** Interpolated value of a column at the current time.              */
+        double getValue(int column) const;
+        /** Interpolated values of the first `n` columns at the current time.
+        `values` must hold at least `n` doubles.                              */
+        void getValues(int n, double* values) const;
+
+    private:
+        const StorageInterpolator* _interpolator;
+        double _time{SimTK::NaN};
+        int _index{0};
+        int _row1{0};
+        int _row2{0};
+        double _fraction{0};
+    };
+
+    /** Copy the data of `storage` into column-major form.                   */
+    explicit StorageInterpolator(const Storage& storage);
+    /** Copy only the given columns (state indices) of `storage`; column `i`
+    of the interpolator is column `columns[i]` of the Storage.
+    @throws IndexOutOfRange if a column is not in every row of the Storage. */
+    StorageInterpolator(const Storage& storage,
+                        const std::vector<int>& columns);
+
+    int getNumRows() const { return _numRows; }
+    int getNumColumns() const { return _numColumns; }
+    const std::vector<double>& getTimes() const { return _times; }
+
+    /** Contiguous values (one per row) of a column.                         */
+    const double* getColumn(int column) const;
+
+    /** Index of the last row whose time is less than or equal to `time`
+    (0 if `time` precedes the data), or -1 if there are no rows. The search
+    starts at row `hint`.                                                     */
+    int findIndex(double time, int hint = 0) const;
+
+    /** Interpolated value of a column at a single time. Use a Cursor when
+    evaluating at a sequence of times.                                        */
+    double getValueAtTime(double time, int column) const;
+
+    /** Interpolate the given columns at each of the given times. The result
+    has a row for each time and a column for each requested column. The times
+    need not be sorted, but sorted times are fastest.                         */
+    SimTK::Matrix getDataAtTimes(const std::vector<double>& times,
+                                 const std::vector<int>& columns) const;
+
+private:
+    void copyColumns(const Storage& storage, const std::vector<int>& columns);
+
+    int _numRows{0};
+    int _numColumns{0};
+    std::vector<double> _times;
+    /** Values stored column by column, _numRows values per column.         */
+    std::vector<double> _data;
+};
+
+} // namespace OpenSim
+
+#endif // OPENSIM_STORAGE_INTERPOLATOR_H_
@@ -41,7 +41,8 @@ TRCFileAdapter::extendRead(const std::string& fileName) const {
     OPENSIM_THROW_IF(fileName.empty(),
                      EmptyFileName);
 
-    std::ifstream in_stream{fileName};
+    auto in_stream_ptr = openInputStream(fileName);
+    auto& in_stream = *in_stream_ptr;
     OPENSIM_THROW_IF(!in_stream.good(),
                      FileDoesNotExist,
                      fileName);
@@ -252,7 +253,8 @@ TRCFileAdapter::extendWrite(const InputTables& absTables,
     OPENSIM_THROW_IF(fileName.empty(),
                      EmptyFileName);
 
-    std::ofstream out_stream{fileName};
+    auto out_stream_ptr = openOutputStream(fileName);
+    auto& out_stream = *out_stream_ptr;
 
     // First line of the stream is the header.
     try {
@@ -373,6 +375,12 @@ TRCFileAdapter::extendWrite(const InputTables& absTables,
         }
         out_stream << "\n";
     }
+
+    // Finishing a compressed file writes its remaining data, which can fail.
+    const bool written = out_stream.good();
+    closeOutputStream(out_stream);
+    OPENSIM_THROW_IF(written && !out_stream, IOError,
+                     "Failed to finish writing file '" + fileName + "'.");
 }
 
 }
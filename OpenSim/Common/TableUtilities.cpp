@@ -147,14 +147,11 @@ void TableUtilities::filterLowpass(
         table = resampleWithInterval(table, dtMin);
     }
 
-    SimTK::Vector filtered(numRows);
-    for (int icol = 0; icol < (int)table.getNumColumns(); ++icol) {
-        SimTK::VectorView column = table.getDependentColumnAtIndex(icol);
-        Signal::LowpassIIR(dtMin, cutoffFreq, numRows,
-                column.getContiguousScalarData(),
-                filtered.updContiguousScalarData());
-        table.updDependentColumnAtIndex(icol) = filtered;
-    }
+    // Filter all columns at once.
+    OPENSIM_THROW_IF(
+            Signal::LowpassIIR(dtMin, cutoffFreq, table.updMatrix()) != 0,
+            Exception, "Failed to filter the table with {} rows.",
+            table.getNumRows());
 }
 
 void TableUtilities::pad(
@@ -0,0 +1,220 @@
+/* -------------------------------------------------------------------------- *
+ *                   OpenSim:  IMUDataReaderBenchmark.cpp                     *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2021 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+// Benchmark for reading large synthetic IMU recordings with XsensDataReader
+// and APDMDataReader. The number of rows can be passed as the first argument
+// (e.g., IMUDataReaderBenchmark 360000 for an hour at 100 Hz); the default
+// only checks that the readers run. This program is not registered as a
+// test; build the IMUDataReaderBenchmark target to run it.
+
+#include "OpenSim/Common/APDMDataReader.h"
+#include "OpenSim/Common/CommonUtilities.h"
+#include "OpenSim/Common/Stopwatch.h"
+#include "OpenSim/Common/XsensDataReader.h"
+#include <OpenSim/Auxiliary/auxiliaryTestFunctions.h>
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <memory>
+
+using namespace OpenSim;
+
+namespace {
+const int numSensors = 17;
+const double dataRate = 100.0;
+
+// Synthetic, exactly representable in the files (6 decimal places).
+double value(int row, int sensor, int component) {
+    return std::round(1e6 * std::sin(0.01 * row + sensor + 0.5 * component))
+            / 1e6;
+}
+// Orientation of a sensor: a rotation about z.
+SimTK::Rotation rotation(int row, int sensor) {
+    return SimTK::Rotation(0.001 * row + 0.1 * sensor, SimTK::ZAxis);
+}
+
+std::string sensorName(int sensor) {
+    return "00B4" + std::to_string(1000 + sensor);
+}
+
+void writeXsensFiles(const std::string& prefix, int numRows) {
+    for (int sensor = 0; sensor < numSensors; ++sensor) {
+        std::ofstream out(prefix + sensorName(sensor) + ".txt");
+        out << "// Start Time: Unknown\n"
+            << "// Update Rate: " << dataRate << "Hz\n"
+            << "// Filter Profile: human (46.1)\n"
+            << "PacketCounter\tSampleTimeFine\tAcc_X\tAcc_Y\tAcc_Z\t"
+               "Gyr_X\tGyr_Y\tGyr_Z\tMag_X\tMag_Y\tMag_Z\t"
+               "Mat[1][1]\tMat[2][1]\tMat[3][1]\tMat[1][2]\tMat[2][2]\t"
+               "Mat[3][2]\tMat[1][3]\tMat[2][3]\tMat[3][3]\n";
+        char number[32];
+        for (int row = 0; row < numRows; ++row) {
+            out << row << "\t";
+            for (int component = 0; component < 9; ++component) {
+                std::snprintf(number, sizeof(number), "\t%.6f",
+                        value(row, sensor, component));
+                out << number;
+            }
+            const SimTK::Rotation R = rotation(row, sensor);
+            for (int mcol = 0; mcol < 3; ++mcol) {
+                for (int mrow = 0; mrow < 3; ++mrow) {
+                    std::snprintf(number, sizeof(number), "\t%.9f",
+                            R[mrow][mcol]);
+                    out << number;
+                }
+            }
+            out << "\n";
+        }
+    }
+}
+
+void writeAPDMFile(const std::string& fileName, int numRows) {
+    const std::vector<std::string> labels{"/Acceleration/X",
+            "/Acceleration/Y", "/Acceleration/Z", "/Angular Velocity/X",
+            "/Angular Velocity/Y", "/Angular Velocity/Z",
+            "/Magnetic Field/X", "/Magnetic Field/Y", "/Magnetic Field/Z",
+            "/Orientation/Scalar", "/Orientation/X", "/Orientation/Y",
+            "/Orientation/Z"};
+    std::ofstream out(fileName);
+    out << "Test Name:,Benchmark\n"
+        << "Sample Rate:," << dataRate << ",Hz\n"
+        << "Time";
+    for (int sensor = 0; sensor < numSensors; ++sensor)
+        for (const auto& label : labels)
+            out << "," << sensorName(sensor) << label;
+    out << "\ns";
+    for (int sensor = 0; sensor < numSensors; ++sensor)
+        for (int i = 0; i < (int)labels.size(); ++i)
+            out << ",";
+    out << "\n";
+    char number[32];
+    for (int row = 0; row < numRows; ++row) {
+        out << row / dataRate;
+        for (int sensor = 0; sensor < numSensors; ++sensor) {
+            for (int component = 0; component < 9; ++component) {
+                std::snprintf(number, sizeof(number), ",%.6f",
+                        value(row, sensor, component));
+                out << number;
+            }
+            const SimTK::Quaternion q =
+                    rotation(row, sensor).convertRotationToQuaternion();
+            for (int i = 0; i < 4; ++i) {
+                std::snprintf(number, sizeof(number), ",%.9f", q[i]);
+                out << number;
+            }
+        }
+        out << "\n";
+    }
+}
+
+template <typename Reader>
+void checkTables(const Reader& reader, const DataAdapter::OutputTables& tables,
+        int numRows) {
+    const auto& accelerations = reader.getLinearAccelerationsTable(tables);
+    const auto& angularVelocities = reader.getAngularVelocityTable(tables);
+    const auto& magneticHeadings = reader.getMagneticHeadingTable(tables);
+    const auto& orientations = reader.getOrientationsTable(tables);
+    ASSERT((int)accelerations.getNumRows() == numRows);
+    ASSERT((int)orientations.getNumRows() == numRows);
+    ASSERT((int)orientations.getNumColumns() == numSensors);
+
+    const std::vector<int> rows{0, numRows / 2, numRows - 1};
+    for (int row : rows) {
+        for (int sensor = 0; sensor < numSensors; ++sensor) {
+            for (int component = 0; component < 3; ++component) {
+                ASSERT_EQUAL(value(row, sensor, component),
+                        accelerations.getMatrix()(row, sensor)[component],
+                        1e-12);
+                ASSERT_EQUAL(value(row, sensor, component + 3),
+                        angularVelocities.getMatrix()(row, sensor)[component],
+                        1e-12);
+                ASSERT_EQUAL(value(row, sensor, component + 6),
+                        magneticHeadings.getMatrix()(row, sensor)[component],
+                        1e-12);
+            }
+            const SimTK::Rotation expected = rotation(row, sensor);
+            SimTK::Rotation actual;
+            actual.setRotationFromQuaternion(
+                    orientations.getMatrix()(row, sensor));
+            ASSERT(expected.isSameRotationToWithinAngle(actual, 1e-6));
+        }
+    }
+}
+} // anonymous namespace
+
+int main(int argc, char* argv[]) {
+    try {
+        const int numRows = argc > 1 ? std::atoi(argv[1]) : 200;
+        std::cout << "Reading " << numSensors << " sensors with " << numRows
+                  << " rows each." << std::endl;
+
+        // Xsens: one file per sensor.
+        const std::string prefix = "benchmark_xsens_";
+        std::vector<std::unique_ptr<FileRemover>> xsensRemovers;
+        for (int sensor = 0; sensor < numSensors; ++sensor) {
+            xsensRemovers.emplace_back(new FileRemover(
+                    prefix + sensorName(sensor) + ".txt"));
+        }
+        writeXsensFiles(prefix, numRows);
+        XsensDataReaderSettings xsensSettings;
+        for (int sensor = 0; sensor < numSensors; ++sensor) {
+            xsensSettings.append_ExperimentalSensors(ExperimentalSensor(
+                    sensorName(sensor), "imu" + std::to_string(sensor)));
+        }
+        xsensSettings.updProperty_trial_prefix() = prefix;
+        XsensDataReader xsensReader(xsensSettings);
+        Stopwatch watch;
+        auto xsensTables = xsensReader.read("./");
+        std::cout << "XsensDataReader read the files in "
+                  << watch.getElapsedTimeFormatted() << std::endl;
+        checkTables(
+                xsensReader, xsensTables, numRows);
+
+        // APDM: all sensors in one file.
+        const std::string apdmFile = "benchmark_apdm.csv";
+        FileRemover apdmRemover(apdmFile);
+        writeAPDMFile(apdmFile, numRows);
+        APDMDataReaderSettings apdmSettings;
+        for (int sensor = 0; sensor < numSensors; ++sensor) {
+            apdmSettings.append_ExperimentalSensors(ExperimentalSensor(
+                    sensorName(sensor), "imu" + std::to_string(sensor)));
+        }
+        APDMDataReader apdmReader(apdmSettings);
+        watch.reset();
+        auto apdmTables = apdmReader.read(apdmFile);
+        std::cout << "APDMDataReader read the file in "
+                  << watch.getElapsedTimeFormatted() << std::endl;
+        checkTables(
+                apdmReader, apdmTables, numRows);
+    }
+    catch (const std::exception& ex) {
+        std::cout << "IMUDataReaderBenchmark FAILED: " << ex.what()
+                  << std::endl;
+        return 1;
+    }
+
+    std::cout << "\n All IMUDataReaderBenchmark cases passed."
+              << std::endl;
+    return 0;
+}
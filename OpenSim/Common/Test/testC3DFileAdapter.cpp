@@ -194,9 +194,86 @@ void test(const std::string filename) {
     cout << "\tcop_" << forces_file << " is equivalent to its standard."<< endl;
 }
 
+void testSelectiveRead(const std::string filename) {
+    using namespace OpenSim;
+    using namespace std;
+
+    C3DFileAdapter fullAdapter{};
+    auto fullTables = fullAdapter.read(filename);
+    const auto fullMarkers = fullAdapter.getMarkersTable(fullTables);
+    const auto fullForces = fullAdapter.getForcesTable(fullTables);
+
+    const auto& allLabels = fullMarkers->getColumnLabels();
+    ASSERT(allLabels.size() >= 2, __FILE__, __LINE__,
+        "Expected at least two markers in " + filename);
+    const std::vector<std::string> markers{allLabels[1], allLabels[0]};
+
+    const auto& fullTimes = fullMarkers->getIndependentColumn();
+    const double initialTime = fullTimes[fullTimes.size() / 4];
+    const double finalTime = fullTimes[fullTimes.size() / 2];
+
+    C3DFileAdapter adapter{};
+    adapter.setMarkersToRead(markers);
+    adapter.setForcePlatformsToRead({2});
+    adapter.setTimeRange(initialTime, finalTime);
+    auto tables = adapter.read(filename);
+    const auto markerTable = adapter.getMarkersTable(tables);
+    const auto forceTable = adapter.getForcesTable(tables);
+
+    // Markers: only the requested columns, in the requested order, and only
+    // the rows within the time range.
+    ASSERT(markerTable->getColumnLabels() == markers, __FILE__, __LINE__,
+        "Marker labels do not match the requested markers.");
+    const auto& times = markerTable->getIndependentColumn();
+    ASSERT(!times.empty(), __FILE__, __LINE__, "No marker rows were read.");
+    ASSERT_EQUAL(initialTime, times.front(), SimTK::SignificantReal);
+    ASSERT_EQUAL(finalTime, times.back(), SimTK::SignificantReal);
+    const auto firstRow = fullMarkers->getRowIndexAfterTime(initialTime);
+    for (size_t r = 0; r < markerTable->getNumRows(); ++r) {
+        for (size_t c = 0; c < markers.size(); ++c) {
+            const auto& expected = fullMarkers->getDependentColumn(
+                    markers[c])[int(firstRow + r)];
+            // Missing (NaN) markers compare as equal.
+            ASSERT_EQUAL(expected, markerTable->getMatrix()(int(r), int(c)),
+                         SimTK::Eps);
+        }
+    }
+
+    // Forces: only the columns of platform 2, within the time range.
+    const std::vector<std::string> forceLabels{"f2", "p2", "m2"};
+    ASSERT(forceTable->getColumnLabels() == forceLabels, __FILE__, __LINE__,
+        "Force labels do not match the requested force platform.");
+    const auto& forceTimes = forceTable->getIndependentColumn();
+    ASSERT(forceTimes.front() >= initialTime - SimTK::SignificantReal &&
+           forceTimes.back() <= finalTime + SimTK::SignificantReal,
+           __FILE__, __LINE__, "Force rows are outside the time range.");
+    const auto firstForceRow =
+            fullForces->getRowIndexAfterTime(forceTimes.front());
+    for (size_t r = 0; r < forceTable->getNumRows(); r += 100) {
+        ASSERT_EQUAL(fullForces->getDependentColumn("f2")
+                        [int(firstForceRow + r)],
+                     forceTable->getMatrix()(int(r), 0),
+                     SimTK::Eps);
+    }
+    const auto& types = forceTable->getTableMetaData()
+            .getValueForKey("Types").getValue<std::vector<unsigned>>();
+    ASSERT(types.size() == 1, __FILE__, __LINE__,
+        "Expected the metadata of a single force platform.");
+
+    // Errors: unknown marker, unknown force platform, and invalid range.
+    C3DFileAdapter badMarker{};
+    badMarker.setMarkersToRead({"not_a_marker"});
+    ASSERT_THROW(OpenSim::Exception, badMarker.read(filename));
+    C3DFileAdapter badPlatform{};
+    badPlatform.setForcePlatformsToRead({100});
+    ASSERT_THROW(OpenSim::Exception, badPlatform.read(filename));
+    ASSERT_THROW(OpenSim::Exception, adapter.setTimeRange(1.0, 0.5));
+}
+
 int main() {
     SimTK_START_TEST("testC3DFileAdapter");
         SimTK_SUBTEST1(test, "walking2.c3d");
         SimTK_SUBTEST1(test, "walking5.c3d");
+        SimTK_SUBTEST1(testSelectiveRead, "walking2.c3d");
     SimTK_END_TEST();
 }
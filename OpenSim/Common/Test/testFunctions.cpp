@@ -24,13 +24,17 @@
 #include "ComponentsForTesting.h"
 
 #include <OpenSim/Common/CommonUtilities.h>
+#include <OpenSim/Common/GCVSpline.h>
 #include <OpenSim/Common/MultivariatePolynomialFunction.h>
+#include <OpenSim/Common/PiecewiseLinearFunction.h>
 #include <OpenSim/Common/Reporter.h>
 #include <OpenSim/Common/SignalGenerator.h>
+#include <OpenSim/Common/SimmSpline.h>
 #include <OpenSim/Common/Sine.h>
 
 #define CATCH_CONFIG_MAIN
 #include <OpenSim/Auxiliary/catch.hpp>
+#include <functional>
 #include <OpenSim/Common/PolynomialFunction.h>
 
 using namespace OpenSim;
@@ -92,6 +96,119 @@ TEST_CASE("Interpolate using PiecewiseLinearFunction") {
     SimTK_TEST(SimTK::isNaN(newY[3]));
 }
 
+TEST_CASE("Evaluate piecewise functions sequentially and in batches") {
+    const int numPoints = 40;
+    std::vector<double> x(numPoints), y(numPoints);
+    for (int i = 0; i < numPoints; ++i) {
+        x[i] = 0.05 * i + 0.001 * (i % 3);
+        y[i] = std::sin(3 * x[i]) + 0.1 * x[i];
+    }
+    // Increasing, decreasing and unordered values, including knots and
+    // values outside the range of x.
+    std::vector<double> queries;
+    for (int i = -10; i <= 2100; ++i) queries.push_back(0.001 * i);
+    for (int i = 2100; i >= -10; i -= 7) queries.push_back(0.001 * i);
+    for (int i = 0; i < 500; ++i) queries.push_back(0.001 * ((i * 7919) % 2100));
+    for (const auto& xi : x) queries.push_back(xi);
+    const int numQueries = (int)queries.size();
+
+    auto check = [&](const Function& f, std::function<double(double)> expected,
+                         double tol) {
+        std::vector<double> values(numQueries);
+        f.calcValues(queries.data(), numQueries, values.data());
+        Function::Cursor cursor(f);
+        for (int i = 0; i < numQueries; ++i) {
+            const double exp = expected(queries[i]);
+            CAPTURE(queries[i]);
+            CHECK(f.calcValueAt(queries[i]) == Approx(exp).margin(tol));
+            CHECK(cursor.calcValue(queries[i]) == Approx(exp).margin(tol));
+            CHECK(values[i] == Approx(exp).margin(tol));
+            CHECK(f.calcValue(SimTK::Vector(1, queries[i])) ==
+                    Approx(exp).margin(tol));
+        }
+    };
+
+    SECTION("PiecewiseLinearFunction") {
+        PiecewiseLinearFunction f(numPoints, x.data(), y.data());
+        check(f, [&](double t) {
+            int k = 0;
+            while (k < numPoints - 2 && t >= x[k + 1]) ++k;
+            return y[k] + (t - x[k]) * (y[k + 1] - y[k]) / (x[k + 1] - x[k]);
+        }, 1e-12);
+    }
+    SECTION("SimmSpline") {
+        SimmSpline f(numPoints, x.data(), y.data());
+        // The spline passes through the points, and its value must not
+        // depend on the order in which it is evaluated.
+        for (int i = 0; i < numPoints; ++i)
+            CHECK(f.calcValueAt(x[i]) == Approx(y[i]).margin(1e-12));
+        SimmSpline reference(f);
+        check(f, [&](double t) {
+            Function::Cursor fresh(reference);
+            return fresh.calcValue(t);
+        }, 1e-12);
+    }
+    SECTION("GCVSpline") {
+        GCVSpline f(5, numPoints, x.data(), y.data());
+        GCVSpline reference(f);
+        // Compare to the evaluation through SimTK::Spline, within the
+        // range of the data.
+        std::vector<double> inRange;
+        for (const auto& t : queries)
+            if (t >= x.front() && t <= x.back()) inRange.push_back(t);
+        std::vector<double> values(inRange.size());
+        f.calcValues(inRange.data(), (int)inRange.size(), values.data());
+        for (int i = 0; i < (int)inRange.size(); ++i) {
+            CAPTURE(inRange[i]);
+            CHECK(values[i] == Approx(reference.calcValue(
+                    SimTK::Vector(1, inRange[i]))).margin(1e-10));
+        }
+    }
+}
+
+TEST_CASE("Derivatives at knots do not depend on the previous evaluation") {
+    const int numPoints = 9;
+    std::vector<double> x(numPoints), y(numPoints);
+    for (int i = 0; i < numPoints; ++i) {
+        x[i] = 0.3 * i + 0.01 * i * i;
+        y[i] = (i % 2) ? 1.0 : -0.5 * i;
+    }
+    // The interval that a bisection from the whole range lands on.
+    auto bisect = [&](double value) {
+        int i = 0, j = numPoints, k;
+        while (true) {
+            k = (i + j) / 2;
+            if (value < x[k]) j = k;
+            else if (value > x[k + 1]) i = k;
+            else return k;
+        }
+    };
+    PiecewiseLinearFunction f(numPoints, x.data(), y.data());
+    SimmSpline spline(numPoints, x.data(), y.data());
+    const std::vector<int> first{0};
+    const std::vector<int> second{0, 0};
+    for (int k = 1; k < numPoints - 1; ++k) {
+        const int expected = bisect(x[k]);
+        CAPTURE(k);
+        CHECK((expected == k - 1 || expected == k));
+        // The second derivative of the spline is evaluated with the cubic of
+        // one interval or the other, which differ by roundoff.
+        const double splineSecond = SimmSpline(spline).calcDerivative(
+                second, SimTK::Vector(1, x[k]));
+        // Leave the hint in the interval before and after the knot.
+        for (double previous : {0.5 * (x[k - 1] + x[k]),
+                     0.5 * (x[k] + x[k + 1])}) {
+            f.calcValueAt(previous);
+            CHECK(f.calcDerivative(first, SimTK::Vector(1, x[k])) ==
+                    (y[expected + 1] - y[expected]) /
+                            (x[expected + 1] - x[expected]));
+            spline.calcValueAt(previous);
+            CHECK(spline.calcDerivative(second, SimTK::Vector(1, x[k])) ==
+                    splineSecond);
+        }
+    }
+}
+
 TEST_CASE("MultivariatePolynomialFunction") {
     SECTION("Input errors") {
         {
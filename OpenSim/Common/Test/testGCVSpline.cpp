@@ -24,6 +24,9 @@
 #include <OpenSim/Common/GCVSplineSet.h>
 #include <OpenSim/Auxiliary/auxiliaryTestFunctions.h>
 
+#include <algorithm>
+#include <cmath>
+
 using namespace OpenSim;
 using namespace std;
 
@@ -82,6 +85,37 @@ int main() {
                 SimTK::Eps, __FILE__, __LINE__,
                 "Duplicate GCVSpline failed to reproduce identical first derivative.");
         }
+
+        // A set of splines sharing the same times, fit concurrently, must
+        // evaluate all at once as the individual splines do.
+        const int numColumns = 12;
+        TimeSeriesTable table(std::vector<double>(x, x + size));
+        for (int j = 0; j < numColumns; ++j) {
+            std::vector<double> column(size);
+            for (int i = 0; i < size; ++i)
+                column[i] = sin(omega*x[i] + j) + 0.01 * (i % 3);
+            table.appendColumn("col" + std::to_string(j), column);
+        }
+        GCVSplineSet splineSet(table, {}, 5, -1.0);
+        for (int derivOrder = 0; derivOrder <= 3; ++derivOrder) {
+            std::vector<int> components(derivOrder, 0);
+            for (int i = 0; i < (2*size-1); ++i) {
+                t[0] = dt / 2 * i;
+                SimTK::Vector values = splineSet.evaluateAll(t[0], derivOrder);
+                ASSERT(values.size() == numColumns);
+                for (int j = 0; j < numColumns; ++j) {
+                    const Function& f = splineSet.get(j);
+                    double expected = derivOrder == 0 ? f.calcValue(t)
+                            : f.calcDerivative(components, t);
+                    ASSERT_EQUAL(expected, values[j],
+                        1e-9 * std::max(1.0, std::abs(expected)),
+                        __FILE__, __LINE__,
+                        "GCVSplineSet::evaluateAll() differs from the splines.");
+                }
+            }
+        }
+        cout << "GCVSplineSet successfully evaluated all splines at once."
+             << endl;
     }
     catch(const Exception& e) {
         e.print(cerr);
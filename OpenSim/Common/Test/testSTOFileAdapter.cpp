@@ -22,6 +22,7 @@
 
 #include "OpenSim/Common/Adapters.h"
 #include "OpenSim/Common/CommonUtilities.h"
+#include "OpenSim/Common/Storage.h"
 #include <cstdio>
 #include <fstream>
 #include <unordered_set>
@@ -353,3 +354,47 @@ TEST_CASE("Trimming whitespace in metadata values") {
 
 
 
+
+TEST_CASE("Reading and writing compressed STO files") {
+    CHECK(FileAdapter::findExtension("walk.sto.gz") == "sto");
+    CHECK(FileAdapter::findExtension("walk.MOT.GZ") == "mot");
+    CHECK(FileAdapter::findCompressionExtension("walk.sto.gz") == "gz");
+    CHECK(FileAdapter::findCompressionExtension("walk.sto").empty());
+    CHECK_THROWS_AS(FileAdapter::findExtension("walk.gz"),
+            FileExtensionNotFound);
+
+#ifdef WITH_ZLIB
+    const std::string filename{"std_subject01_walk1_ik.mot"};
+    const std::string compressed{"testSTOFileAdapter_compressed.mot.gz"};
+    const std::string tmpfile{"testSTOFileAdapter_uncompressed.mot"};
+    FileRemover compressedRemover(compressed);
+    FileRemover tmpfileRemover(tmpfile);
+
+    TimeSeriesTable table(filename);
+    STOFileAdapter::write(table, compressed);
+
+    // TimeSeriesTable and Storage read through the decompressing stream.
+    TimeSeriesTable tableFromCompressed(compressed);
+    STOFileAdapter::write(tableFromCompressed, tmpfile);
+    compareFiles(filename, tmpfile);
+
+    Storage storage(compressed);
+    CHECK(storage.getSize() == (int)table.getNumRows());
+    CHECK(storage.getColumnLabels().getSize() ==
+            (int)table.getNumColumns() + 1);
+
+    // Storage compresses what it prints to a compressed file name.
+    const std::string printed{"testSTOFileAdapter_printed.sto.gz"};
+    FileRemover printedRemover(printed);
+    CHECK(storage.print(printed));
+    Storage storageFromPrinted(printed);
+    CHECK(storageFromPrinted.getSize() == storage.getSize());
+    CHECK(storageFromPrinted.getLastTime() == Approx(storage.getLastTime()));
+
+    // A compressed file that cannot be opened gives a stream that is not
+    // good(), like an uncompressed one.
+    CHECK(!FileAdapter::openInputStream("walk_missing.sto.gz")->good());
+#else
+    CHECK_THROWS_AS(FileAdapter::openInputStream("walk.sto.gz"), IOError);
+#endif
+}
@@ -20,10 +20,15 @@
  * limitations under the License.                                             *
  * -------------------------------------------------------------------------- */
 
+#include <algorithm>
 #include <fstream>
+#include <functional>
+#include <OpenSim/Common/ResultBuffer.h>
 #include <OpenSim/Common/Storage.h>
 #include <OpenSim/Auxiliary/auxiliaryTestFunctions.h>
 #include <OpenSim/Common/STOFileAdapter.h>
+#include <OpenSim/Common/Signal.h>
+#include <OpenSim/Common/StorageInterpolator.h>
 
 using namespace OpenSim;
 using namespace std;
@@ -170,6 +175,181 @@ void testStorageGetStateIndexBackwardsCompatibility() {
     // TODO: Put XML document version in Storage header.
 }
 
+void testStorageTableConversion() {
+    TimeSeriesTable table;
+    table.setColumnLabels({"a", "b", "c"});
+    for (int i = 0; i < 100; ++i) {
+        const double t = 0.01 * i;
+        table.appendRow(t, {t, 2 * t, std::cos(t)});
+    }
+    table.addTableMetaData("inDegrees", std::string("yes"));
+
+    Storage sto(table);
+    ASSERT(sto.getSize() == (int)table.getNumRows());
+    ASSERT(sto.getColumnLabels().getSize() == 4);
+    ASSERT(sto.getColumnLabels()[0] == "time");
+    ASSERT(sto.getColumnLabels()[3] == "c");
+    ASSERT(sto.isInDegrees());
+
+    TimeSeriesTable roundTrip = sto.exportToTable();
+    ASSERT(roundTrip.getColumnLabels() == table.getColumnLabels());
+    ASSERT(roundTrip.getIndependentColumn() == table.getIndependentColumn());
+    SimTK_TEST_EQ(roundTrip.getMatrix(), table.getMatrix());
+
+    // Appending a row with a duplicate time replaces the last row.
+    double y[] = {1, 2, 3};
+    sto.append(sto.getLastTime(), 3, y);
+    ASSERT(sto.getSize() == (int)table.getNumRows());
+    ASSERT(sto.getLastStateVector()->getData()[2] == 3);
+}
+
+void testStorageInterpolator() {
+    // Non-uniform time stamps, with a repeated time.
+    const std::vector<double> times{0.0, 0.1, 0.25, 0.25, 0.5, 0.6, 1.0};
+    Storage sto;
+    Array<std::string> labels("time", 1);
+    labels.append("a"); labels.append("b"); labels.append("c");
+    sto.setColumnLabels(labels);
+    for (const auto& t : times) {
+        double y[] = {std::sin(t), 2.0 * t, t * t};
+        sto.append(t, 3, y);
+    }
+
+    StorageInterpolator interp(sto);
+    ASSERT(interp.getNumRows() == (int)times.size());
+    ASSERT(interp.getNumColumns() == 3);
+
+    // Query times inside, between, at, and outside the data, both forward
+    // and backward, must match Storage::getDataAtTime() and findIndex().
+    std::vector<double> queries;
+    for (int i = -5; i <= 25; ++i) queries.push_back(0.05 * i);
+    queries.push_back(0.25);
+    for (int i = 25; i >= -5; i -= 3) queries.push_back(0.05 * i);
+    queries.push_back(0.7);
+    queries.push_back(-0.3);
+
+    StorageInterpolator::Cursor cursor(interp);
+    Array<double> expected(0.0, 3);
+    double actual[3];
+    for (const auto& t : queries) {
+        cursor.seek(t);
+        sto.getDataAtTime(t, 3, expected);
+        cursor.getValues(3, actual);
+        ASSERT(cursor.getIndex() == sto.findIndex(t));
+        for (int i = 0; i < 3; ++i) {
+            ASSERT_EQUAL(expected[i], actual[i], 1e-15);
+            ASSERT_EQUAL(expected[i], interp.getValueAtTime(t, i), 1e-15);
+        }
+    }
+
+    // Batched evaluation.
+    SimTK::Matrix batch = sto.getDataAtTimes(queries, {"c", "a"});
+    ASSERT(batch.nrow() == (int)queries.size());
+    ASSERT(batch.ncol() == 2);
+    for (int i = 0; i < (int)queries.size(); ++i) {
+        sto.getDataAtTime(queries[i], 3, expected);
+        ASSERT_EQUAL(expected[2], batch(i, 0), 1e-15);
+        ASSERT_EQUAL(expected[0], batch(i, 1), 1e-15);
+    }
+    const std::vector<std::string> missing{"nonexistent"};
+    ASSERT_THROW(OpenSim::Exception, sto.getDataAtTimes(queries, missing));
+}
+
+void testStorageMulticolumnFilters() {
+    // Enough columns for a partial block and enough data to use threads.
+    const int numRows = 6000;
+    const int numColumns = 21;
+    // Times are exact in binary, so the storage is not resampled.
+    const double dt = 1.0 / 1024;
+    Storage original;
+    Array<std::string> labels("time", 1);
+    for (int j = 0; j < numColumns; ++j) labels.append("c" + std::to_string(j));
+    original.setColumnLabels(labels);
+    std::vector<double> y(numColumns);
+    for (int i = 0; i < numRows; ++i) {
+        for (int j = 0; j < numColumns; ++j) {
+            y[j] = std::sin(0.01 * i * (j + 1)) + 0.1 * std::cos(0.37 * i + j);
+        }
+        original.append(i * dt, numColumns, y.data());
+    }
+
+    // Each column must match the single-signal filter exactly.
+    auto compare = [&](const Storage& filtered,
+            const std::function<void(int, double*, double*)>& filterColumn) {
+        ASSERT(filtered.getSize() == numRows);
+        std::vector<double> signal(numRows), expected(numRows);
+        for (int j = 0; j < numColumns; ++j) {
+            double* column = signal.data();
+            original.getDataColumn(j, column);
+            filterColumn(numRows, signal.data(), expected.data());
+            for (int i = 0; i < numRows; ++i) {
+                ASSERT_EQUAL(expected[i],
+                        filtered.getStateVector(i)->getData()[j], 1e-15);
+            }
+        }
+    };
+
+    Storage iir(original);
+    iir.lowpassIIR(6.0);
+    compare(iir, [&](int n, double* sig, double* sigf) {
+        Signal::LowpassIIR(dt, 6.0, n, sig, sigf);
+    });
+
+    Storage fir(original);
+    fir.lowpassFIR(50, 6.0);
+    compare(fir, [&](int n, double* sig, double* sigf) {
+        Signal::LowpassFIR(50, dt, 6.0, n, sig, sigf);
+    });
+
+    Storage spline(original);
+    spline.smoothSpline(3, 6.0);
+    double* times = nullptr;
+    original.getTimeColumn(times);
+    compare(spline, [&](int n, double* sig, double* sigf) {
+        Signal::SmoothSpline(3, dt, 6.0, n, times, sig, sigf);
+    });
+    delete[] times;
+}
+
+void testResultBuffer() {
+    // Rows appended to a buffer (which grows from a capacity of 2) and then
+    // flushed give the same storage as appending the rows directly.
+    const int numColumns = 3;
+    ResultBuffer buffer(numColumns, 2);
+    Storage direct;
+    Storage buffered;
+    std::vector<double> y(numColumns);
+    for (int i = 0; i < 10; ++i) {
+        // The last row is appended twice, at the same time.
+        const double t = std::min(i, 8) * 0.1;
+        for (int j = 0; j < numColumns; ++j) y[j] = 10 * i + j;
+        direct.append(t, numColumns, y.data());
+        if (i % 2) {
+            buffer.appendRow(t, y.data());
+        } else {
+            const int row = buffer.appendRow(t);
+            ASSERT(SimTK::isNaN(buffer.getValue(row, 0)));
+            for (int j = 0; j < numColumns; ++j) buffer.setValue(row, j, y[j]);
+        }
+        if (i == 4) buffer.flushTo(buffered);
+    }
+    ASSERT(buffer.getNumRows() == 4);
+    ASSERT(buffer.getColumn(1)[3] == 91);
+    buffer.flushTo(buffered);
+    ASSERT(buffer.getNumRows() == 0);
+
+    ASSERT(buffered.getSize() == direct.getSize());
+    ASSERT(buffered.getSize() == 9);
+    for (int i = 0; i < direct.getSize(); ++i) {
+        ASSERT(buffered.getStateVector(i)->getTime() ==
+               direct.getStateVector(i)->getTime());
+        for (int j = 0; j < numColumns; ++j) {
+            ASSERT(buffered.getStateVector(i)->getData()[j] ==
+                   direct.getStateVector(i)->getData()[j]);
+        }
+    }
+}
+
 int main() {
     SimTK_START_TEST("testStorage");
 
@@ -194,6 +374,14 @@ int main() {
         SimTK_SUBTEST(testStorageLegacy);
 
         SimTK_SUBTEST(testStorageGetStateIndexBackwardsCompatibility);
+
+        SimTK_SUBTEST(testStorageTableConversion);
+
+        SimTK_SUBTEST(testStorageInterpolator);
+
+        SimTK_SUBTEST(testResultBuffer);
+
+        SimTK_SUBTEST(testStorageMulticolumnFilters);
     SimTK_END_TEST();
 }
 
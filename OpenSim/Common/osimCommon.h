@@ -45,6 +45,7 @@
 #include "PolynomialFunction.h"
 #include "RegisterTypes_osimCommon.h" // to expose RegisterTypes_osimCommon
 #include "Reporter.h"
+#include "ResultBuffer.h"
 #include "Scale.h"
 #include "ScaleSet.h"
 #include "SignalGenerator.h"
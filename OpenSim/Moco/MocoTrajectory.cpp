@@ -641,20 +641,19 @@ void MocoTrajectory::resample(SimTK::Vector time) {
                     table.getDependentColumnAtIndex(icol).getElt(0, 0));
 
     } else {
-        SimTK::Vector curTime(1);
         for (int itime = 0; itime < m_time.size(); ++itime) {
-            curTime[0] = m_time[itime];
+            const SimTK::Vector values = splines.evaluateAll(m_time[itime]);
             int icol;
             for (icol = 0; icol < numStates; ++icol)
-                m_states(itime, icol) = splines[icol].calcValue(curTime);
+                m_states(itime, icol) = values[icol];
             for (int icontr = 0; icontr < numControls; ++icontr, ++icol)
-                m_controls(itime, icontr) = splines[icol].calcValue(curTime);
+                m_controls(itime, icontr) = values[icol];
             for (int imult = 0; imult < numMultipliers; ++imult, ++icol)
-                m_multipliers(itime, imult) = splines[icol].calcValue(curTime);
+                m_multipliers(itime, imult) = values[icol];
             for (int ideriv = 0; ideriv < numDerivatives; ++ideriv, ++icol)
-                m_derivatives(itime, ideriv) = splines[icol].calcValue(curTime);
+                m_derivatives(itime, ideriv) = values[icol];
             for (int islack = 0; islack < numSlacks; ++islack, ++icol)
-                m_slacks(itime, islack) = splines[icol].calcValue(curTime);
+                m_slacks(itime, islack) = values[icol];
         }
     }
 }
@@ -78,6 +78,14 @@ void AssemblySolver::setAccuracy(double accuracy)
     _assembler.reset();
 }
 
+void AssemblySolver::setPredictorOrder(int order)
+{
+    OPENSIM_THROW_IF(order < 0 || order > 2, Exception,
+            "Expected the predictor order to be 0, 1 or 2, but got {}.",
+            order);
+    _predictorOrder = order;
+}
+
 /* Internal method to convert the CoordinateReferences into goals of the 
    assembly solver. Subclasses, override and call base to include other goals  
    such as point of interest matching (Marker tracking). This method is
@@ -99,12 +107,20 @@ void AssemblySolver::setupGoals(SimTK::State &s)
     const CoordinateSet& modelCoordSet = getModel().getCoordinateSet();
 
     // Restrict solution to set range of any of the coordinates that are clamped
+    _clampedQIndices.clear();
+    _clampedQRanges.clear();
     for(int i=0; i<modelCoordSet.getSize(); ++i){
         const Coordinate& coord = modelCoordSet[i];
         if(coord.getClamped(s)){
             _assembler->restrictQ(coord.getBodyIndex(), 
                 MobilizerQIndex(coord.getMobilizerQIndex()),
                 coord.getRangeMin(), coord.getRangeMax());
+            const MobilizedBody& mobod = getModel().getMatterSubsystem()
+                    .getMobilizedBody(coord.getBodyIndex());
+            _clampedQIndices.push_back(QIndex(
+                    mobod.getFirstQIndex(s) + coord.getMobilizerQIndex()));
+            _clampedQRanges.push_back(
+                    Vec2(coord.getRangeMin(), coord.getRangeMax()));
         }
     }
 
@@ -205,12 +221,22 @@ void AssemblySolver::assemble(SimTK::State &state)
 
     try{
         // Now do the assembly and return the updated state.
+        const double start = SimTK::realTime();
+        _assembler->resetStats();
         _assembler->assemble();
+        _numIterations = _assembler->getNumAssemblySteps();
+        _lastAccuracy = _assembler->getAccuracyInUse();
+        _solveTime = SimTK::realTime() - start;
         // Update the q's in the state passed in
         _assembler->updateFromInternalState(s);
         state.updQ() = s.getQ();
         state.updU() = s.getU();
 
+        // Later frames are predicted from this solution only.
+        _solutionTimes.clear();
+        _solutionQs.clear();
+        recordSolution(state);
+
         // Get model coordinates
         const CoordinateSet& modelCoordSet = getModel().getCoordinateSet();
         // Make sure the locks in original state are restored
@@ -266,11 +292,19 @@ void AssemblySolver::track(SimTK::State &s)
         _assembler->getInternalState().getNQ(), _assembler->getNumFreeQs());
 
     try{
+        const double start = SimTK::realTime();
+        if (_predictorOrder > 0) predictInitialGuess(s.getTime());
+
         // Now do the assembly and return the updated state.
+        _assembler->resetStats();
         _assembler->track(s.getTime());
+        _numIterations = _assembler->getNumAssemblySteps();
+        _lastAccuracy = _assembler->getAccuracyInUse();
 
         // update the state from the result of the assembler 
         _assembler->updateFromInternalState(s);
+        _solveTime = SimTK::realTime() - start;
+        recordSolution(s);
         
         // TODO: Useful to include through debug message/log in the future
         log_debug("Tracking: t= {} (acc={} tol={} normerr={}, maxerr={}, cost={})", 
@@ -286,6 +320,53 @@ void AssemblySolver::track(SimTK::State &s)
     }
 }
 
+void AssemblySolver::recordSolution(const SimTK::State& s)
+{
+    // Tracking the same time again replaces the solution at that time.
+    if (!_solutionTimes.empty() && _solutionTimes.back() == s.getTime()) {
+        _solutionTimes.pop_back();
+        _solutionQs.pop_back();
+    }
+    _solutionTimes.push_back(s.getTime());
+    _solutionQs.push_back(s.getQ());
+    while ((int)_solutionTimes.size() > _predictorOrder + 1) {
+        _solutionTimes.pop_front();
+        _solutionQs.pop_front();
+    }
+}
+
+void AssemblySolver::predictInitialGuess(double time)
+{
+    const int n = (int)_solutionTimes.size();
+    if (n < 2) return;
+    // Extrapolating quaternions would not preserve their norm.
+    const SimbodyMatterSubsystem& matter = getModel().getMatterSubsystem();
+    if (matter.getNumQuaternionsInUse(_assembler->getInternalState()) > 0)
+        return;
+
+    // Evaluate the polynomial through the recorded solutions (Lagrange form)
+    // at the new time.
+    Vector q(_solutionQs.back().size(), 0.0);
+    for (int j = 0; j < n; ++j) {
+        double weight = 1.0;
+        for (int m = 0; m < n; ++m) {
+            if (m == j) continue;
+            weight *= (time - _solutionTimes[m]) /
+                      (_solutionTimes[j] - _solutionTimes[m]);
+        }
+        q += weight * _solutionQs[j];
+    }
+    for (int i = 0; i < (int)_clampedQIndices.size(); ++i) {
+        double& value = q[_clampedQIndices[i]];
+        value = clamp(_clampedQRanges[i][0], value, _clampedQRanges[i][1]);
+    }
+
+    Vector freeQs(_assembler->getNumFreeQs());
+    for (Assembler::FreeQIndex fx(0); fx < freeQs.size(); ++fx)
+        freeQs[fx] = q[_assembler->getQIndexOfFreeQ(fx)];
+    _assembler->setInternalStateFromFreeQs(freeQs);
+}
+
 const SimTK::Assembler& AssemblySolver::getAssembler() const
 {
     OPENSIM_THROW_IF(!_assembler, Exception,
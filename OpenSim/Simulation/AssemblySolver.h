@@ -27,6 +27,8 @@
 #include "OpenSim/Simulation/CoordinateReference.h"
 #include "simbody/internal/Assembler.h"
 
+#include <deque>
+
 namespace SimTK { 
 class QValue;
 class State;
@@ -84,6 +86,8 @@ public:
         Note, setting the accuracy will invalidate the AssemblySolver and one
         must call assemble() before being able to track().*/
     void setAccuracy(double accuracy);
+    /** The accuracy set by setAccuracy() (default 1e-4). */
+    double getAccuracy() const { return _accuracy; }
 
     /** %Set the relative weighting for constraints. Use Infinity to identify the 
         strict enforcement of constraints, otherwise any positive weighting will
@@ -115,6 +119,31 @@ public:
         find a nearby solution due to a small change in the desired value.*/
     virtual void track(SimTK::State &s);
 
+    /** %Set how track() obtains the initial guess for the new configuration
+        from the solutions of the previous frames: 0 (default) starts from
+        the previous solution; 1 extrapolates linearly in time from the
+        previous two solutions (constant velocity); 2 extrapolates
+        quadratically from the previous three. Lower orders are used until
+        enough frames have been solved since assemble(). Predicted values of
+        clamped coordinates are kept within their range. A good prediction
+        reduces the number of iterations per frame when the configuration
+        changes quickly relative to the time between frames. Extrapolation
+        is not used for models with quaternions. */
+    void setPredictorOrder(int order);
+    int getPredictorOrder() const { return _predictorOrder; }
+
+    /** Number of iterations (assembly steps) taken by the last call to
+        assemble() or track(). */
+    int getNumIterations() const { return _numIterations; }
+    /** Wall-clock time, in seconds, taken by the last call to assemble() or
+        track(). */
+    double getSolveTime() const { return _solveTime; }
+    /** Accuracy used by the last call to assemble() or track(). This can
+        differ from getAccuracy() when a derived solver adapts the accuracy
+        between frames (see InverseKinematicsSolver::setAdaptiveAccuracy()). */
+    double getLastAccuracy() const { return _lastAccuracy; }
+
+
     /** Read access to the underlying SimTK::Assembler. */
     const SimTK::Assembler& getAssembler() const;
 
@@ -147,6 +176,28 @@ private:
     SimTK::ResetOnCopy< std::unique_ptr<SimTK::Assembler>> _assembler;
 
     SimTK::Array_<SimTK::QValue*> _coordinateAssemblyConditions;
+
+    // Order of the extrapolation of the initial guess for track().
+    int _predictorOrder{0};
+    // Times and generalized coordinates of the most recent solutions, oldest
+    // first, used to predict the initial guess for track().
+    std::deque<double> _solutionTimes;
+    std::deque<SimTK::Vector> _solutionQs;
+    // State indices and ranges of the generalized coordinates of clamped
+    // coordinates, which predictions must respect.
+    SimTK::Array_<SimTK::QIndex> _clampedQIndices;
+    SimTK::Array_<SimTK::Vec2> _clampedQRanges;
+
+    // Statistics of the last call to assemble() or track().
+    int _numIterations{0};
+    double _solveTime{0};
+    double _lastAccuracy{0};
+
+    // Record the solution in s for predicting later initial guesses.
+    void recordSolution(const SimTK::State& s);
+    // Set the initial guess of the assembler for the given time by
+    // extrapolating the recorded solutions.
+    void predictInitialGuess(double time);
 //=============================================================================
 };  // END of class AssemblySolver
 //=============================================================================
@@ -36,39 +36,77 @@ BufferedOrientationsReference::BufferedOrientationsReference()
     setAuthors("Ayman Habib");
 }
 
+BufferedOrientationsReference::BufferedOrientationsReference(
+        const BufferedOrientationsReference& other)
+        : OrientationsReference(other),
+          _orientationDataQueue(other._orientationDataQueue->clone()),
+          _finished(other._finished) {}
+
+BufferedOrientationsReference& BufferedOrientationsReference::operator=(
+        const BufferedOrientationsReference& other) {
+    if (this != &other) {
+        OrientationsReference::operator=(other);
+        _orientationDataQueue.reset(other._orientationDataQueue->clone());
+        _finished = other._finished;
+    }
+    return *this;
+}
+
+void BufferedOrientationsReference::setQueueCapacity(int capacity) {
+    OPENSIM_THROW_IF_FRMOBJ(capacity < 0, Exception,
+            "Expected the queue capacity to be non-negative, but got {}.",
+            capacity);
+    OPENSIM_THROW_IF_FRMOBJ(!_orientationDataQueue->isEmpty(), Exception,
+            "Cannot change the queue while it holds values.");
+    if (capacity == 0) {
+        _orientationDataQueue.reset(new DataQueue_<SimTK::Rotation>());
+    } else {
+        _orientationDataQueue.reset(new RingBufferDataQueue_<SimTK::Rotation>(
+                capacity, getNumRefs()));
+    }
+}
+
 /** get the values of the OrientationsReference */
 void BufferedOrientationsReference::getValuesAtTime(
         double time, SimTK::Array_<Rotation> &values) const
 {
     auto& times = _orientationData.getIndependentColumn();
-    SimTK::RowVector_<SimTK::Rotation> nextRow;
 
     if (time >= times.front() && time <= times.back()) {
-        nextRow = _orientationData.getRow(time);
-    } else {
-        _orientationDataQueue.pop_front(time, nextRow);
+        OrientationsReference::getValuesAtTime(time, values);
+        return;
     }
-    int n = nextRow.size();
+    _orientationDataQueue->pop_front(time, _nextRow);
+    int n = _nextRow.size();
     values.resize(n);
 
     for (int i = 0; i < n; ++i) { 
-        values[i] = nextRow[i];
+        values[i] = _nextRow[i];
     }
 }
 
 void BufferedOrientationsReference::getNextValuesAndTime(
         double& time, SimTK::Array_<SimTK::Rotation_<double>>& values) {
 
-    SimTK::RowVector_<SimTK::Rotation> nextRow;
-    _orientationDataQueue.pop_front(time, nextRow);
-    int n = nextRow.size();
+    _orientationDataQueue->pop_front(time, _nextRow);
+    int n = _nextRow.size();
     values.resize(n);
 
-    for (int i = 0; i < n; ++i) { values[i] = nextRow[i]; }
+    for (int i = 0; i < n; ++i) { values[i] = _nextRow[i]; }
+}
+
+int BufferedOrientationsReference::discardPendingValues(int numToKeep) {
+    int numDiscarded = 0;
+    double time;
+    for (int i = _orientationDataQueue->getSize(); i > numToKeep; --i) {
+        _orientationDataQueue->pop_front(time, _nextRow);
+        ++numDiscarded;
+    }
+    return numDiscarded;
 }
 
 void BufferedOrientationsReference::putValues(
         double time, const SimTK::RowVector_<SimTK::Rotation>& dataRow) {
-    _orientationDataQueue.push_back(time, dataRow);
+    _orientationDataQueue->push_back(time, dataRow);
 }
 } // end of namespace OpenSim
\ No newline at end of file
@@ -26,6 +26,8 @@
 #include "OrientationsReference.h"
 #include <OpenSim/Common/DataQueue.h>
 
+#include <memory>
+
 namespace OpenSim {
 
 
@@ -52,11 +54,10 @@ public:
     // CONSTRUCTION
     //--------------------------------------------------------------------------
     BufferedOrientationsReference();
-    BufferedOrientationsReference(
-            const BufferedOrientationsReference&) = default;
+    BufferedOrientationsReference(const BufferedOrientationsReference&);
     BufferedOrientationsReference(BufferedOrientationsReference&&) = default;
     BufferedOrientationsReference& operator=(
-            const BufferedOrientationsReference&) = default;
+            const BufferedOrientationsReference&);
 
     // Use OrientationsReference convenience costructor from TimeSeriesTable
     using OrientationsReference::OrientationsReference;
@@ -89,9 +90,32 @@ public:
     void setFinished(bool finished) { 
         _finished = finished;
     };
+
+    /** Hold the values passed to putValues() in a bounded, lock-free queue
+        with room for `capacity` rows (see RingBufferDataQueue_), instead of
+        the default unbounded queue guarded by a mutex. This reduces the
+        latency of streaming when one thread puts the values and another
+        solves for them; putValues() waits while the queue is full. If
+        `capacity` is 0, the default queue is used again. Call this before
+        any values are put. */
+    void setQueueCapacity(int capacity);
+
+    /** The number of rows that were put but have not been taken yet. */
+    int getNumPendingValues() const {
+        return _orientationDataQueue->getSize();
+    }
+    /** Discard the oldest rows that were put but have not been taken,
+        keeping (at most) the newest `numToKeep`, and return the number of
+        rows discarded. Call this from the thread that takes the values (e.g.,
+        that runs the InverseKinematicsSolver), to skip ahead when the values
+        are put faster than they are solved. */
+    int discardPendingValues(int numToKeep);
 private:
     // Use a specialized data structure for holding the orientation data
-    mutable DataQueue_<SimTK::Rotation> _orientationDataQueue;
+    std::unique_ptr<DataQueue_<SimTK::Rotation>> _orientationDataQueue{
+            new DataQueue_<SimTK::Rotation>()};
+    // The last row taken from the queue, kept to reuse its memory.
+    mutable SimTK::RowVector_<SimTK::Rotation> _nextRow;
     bool _finished{false};
     //=============================================================================
 };  // END of class BufferedOrientationsReference
@@ -164,11 +164,13 @@ void PrescribedController::extendConnectToModel(Model& model)
 // compute the control value for an actuator
 void PrescribedController::computeControls(const SimTK::State& s, SimTK::Vector& controls) const
 {
-    SimTK::Vector actControls(1, 0.0);
-    SimTK::Vector time(1, s.getTime());
+    // Reused by every call on this thread, so that computing the controls
+    // does not allocate.
+    static thread_local SimTK::Vector actControls(1, 0.0);
+    const double time = s.getTime();
 
     for(int i=0; i<getActuatorSet().getSize(); i++){
-        actControls[0] = get_ControlFunctions()[i].calcValue(time);
+        actControls[0] = get_ControlFunctions()[i].calcValueAt(time);
         getActuatorSet()[i].addInControls(actControls, controls);
     }  
 }
@@ -23,13 +23,58 @@
 
 #include "InverseDynamicsSolver.h"
 #include "Model/Model.h"
+#include <OpenSim/Common/CommonUtilities.h>
 #include <OpenSim/Common/FunctionSet.h>
+#include <OpenSim/Common/GCVSplineSet.h>
+
+#include <algorithm>
+#include <thread>
 
 using namespace std;
 using namespace SimTK;
 
 namespace OpenSim {
 
+namespace {
+// Evaluate every coordinate function (or one of their derivatives) at time.
+// Splines are evaluated together so the knot interval is searched once.
+SimTK::Vector evaluateFunctions(
+        const FunctionSet& Qs, int derivOrder, double time) {
+    if (const auto* splines = dynamic_cast<const GCVSplineSet*>(&Qs)) {
+        return splines->evaluateAll(time, derivOrder);
+    }
+    SimTK::Vector values(Qs.getSize());
+    for (int i = 0; i < Qs.getSize(); i++) {
+        values[i] = Qs.evaluate(i, derivOrder, time);
+    }
+    return values;
+}
+
+// Set the time, coordinates, speeds and accelerations of the state from the
+// coordinate functions.
+void setStateFromFunctions(SimTK::State& s, const FunctionSet& Qs,
+        const std::vector<int>& coordinatesToSpeedsIndexMap, double time) {
+    // direct references into the state so no allocation required
+    s.updTime() = time;
+    Vector& q = s.updQ();
+    Vector& u = s.updU();
+    Vector& udot = s.updUDot();
+
+    const SimTK::Vector values = evaluateFunctions(Qs, 0, time);
+    const SimTK::Vector speeds = evaluateFunctions(Qs, 1, time);
+    const SimTK::Vector accelerations = evaluateFunctions(Qs, 2, time);
+
+    for (int i = 0; i < s.getNQ(); i++) {
+        q[i] = values[i];
+    }
+
+    for (int i = 0; i < s.getNU(); i++) {
+        u[i] = speeds[coordinatesToSpeedsIndexMap[i]];
+        udot[i] = accelerations[coordinatesToSpeedsIndexMap[i]];
+    }
+}
+} // anonymous namespace
+
 //______________________________________________________________________________
 /**
  * An implementation of the InverseDynamicsSolver 
@@ -115,11 +160,9 @@ Vector InverseDynamicsSolver::solve(SimTK::State &s, const FunctionSet &Qs, doub
     Vector &u = s.updU();
     Vector &udot = s.updUDot();
 
-    for(int i=0; i<nq; i++){
-        q[i] = Qs.evaluate(i, 0, time);
-        u[i] = Qs.evaluate(i, 1, time);
-        udot[i] = Qs.evaluate(i, 2, time);
-    }
+    q = evaluateFunctions(Qs, 0, time);
+    u = evaluateFunctions(Qs, 1, time);
+    udot = evaluateFunctions(Qs, 2, time);
 
     // Perform general inverse dynamics
     return solve(s, udot);
@@ -139,23 +182,10 @@ Vector InverseDynamicsSolver::solve(SimTK::State& s, const FunctionSet& Qs,
     }
 
     // update the State so we get the correct gravity and Coriolis effects
-    // direct references into the state so no allocation required
-    s.updTime() = time;
-    Vector& q = s.updQ();
-    Vector& u = s.updU();
-    Vector& udot = s.updUDot();
-
-    for (int i = 0; i < nq; i++) {
-        q[i] = Qs.evaluate(i, 0, time);
-    }
-
-    for (int i = 0; i < nu; i++) {
-        u[i] = Qs.evaluate(coordinatesToSpeedsIndexMap[i], 1, time);
-        udot[i] = Qs.evaluate(coordinatesToSpeedsIndexMap[i], 2, time);
-    }
+    setStateFromFunctions(s, Qs, coordinatesToSpeedsIndexMap, time);
 
     // Perform general inverse dynamics
-    return solve(s, udot);
+    return solve(s, s.updUDot());
 }
 
 /** Same as above but for a given time series */
@@ -195,4 +225,84 @@ void InverseDynamicsSolver::solve(SimTK::State& s, const FunctionSet& Qs,
     }
 }
 
+void InverseDynamicsSolver::solveInParallel(SimTK::State& s,
+        const FunctionSet& Qs,
+        const std::vector<int>& coordinatesToSpeedsIndexMap,
+        const Array_<double>& times, Array_<Vector>& genForceTrajectory,
+        int numThreads, const FrameFunction& frameFunction) {
+    const Model& model = getModel();
+    int nCoords = model.getNumCoordinates();
+    int nt = times.size();
+
+    // Preallocate if not done already
+    genForceTrajectory.resize(nt, Vector(nCoords));
+    if (nt == 0) return;
+
+    AnalysisSet& analysisSet = const_cast<AnalysisSet&>(model.getAnalysisSet());
+
+    if (numThreads < 1) {
+        numThreads = static_cast<int>(std::thread::hardware_concurrency());
+    }
+    if (numThreads <= 1 || nt < 3) {
+        for (int i = 0; i < nt; i++) {
+            genForceTrajectory[i] =
+                    solve(s, Qs, coordinatesToSpeedsIndexMap, times[i]);
+            if (frameFunction) frameFunction(model, s, i);
+            analysisSet.step(s, i);
+        }
+        return;
+    }
+    // The first frame is solved here, which also evaluates every function
+    // (and derivative) once, so that functions that set themselves up on
+    // first use (e.g., splines) are not set up concurrently.
+    genForceTrajectory[0] = solve(s, Qs, coordinatesToSpeedsIndexMap, times[0]);
+    if (frameFunction) frameFunction(model, s, 0);
+    analysisSet.step(s, 0);
+
+    const int numBlocks = std::min(numThreads, nt - 1);
+
+    // Copy and initialize the models on this thread; copying a model can
+    // read files (e.g., the data of ExternalLoads).
+    struct Block {
+        int begin;
+        int end;
+        std::unique_ptr<Model> model;
+    };
+    std::vector<Block> blocks(numBlocks);
+    for (int b = 0; b < numBlocks; ++b) {
+        Block& block = blocks[b];
+        block.begin = 1 + (int)((long long)b * (nt - 1) / numBlocks);
+        block.end = 1 + (int)((long long)(b + 1) * (nt - 1) / numBlocks);
+        block.model.reset(model.clone());
+        // Only the solver's model reports; discard copies of analyses.
+        block.model->updAnalysisSet().clearAndDestroy();
+        SimTK::State& state = block.model->initSystem();
+        for (const auto& force : model.getComponentList<Force>()) {
+            block.model->getComponent<Force>(force.getAbsolutePath())
+                    .setAppliesForce(state, force.appliesForce(s));
+        }
+        state.updZ() = s.getZ();
+    }
+
+    parallelFor(numBlocks, [&](int b) {
+        Block& block = blocks[b];
+        SimTK::State& state = block.model->updWorkingState();
+        InverseDynamicsSolver solver(*block.model);
+        for (int i = block.begin; i < block.end; ++i) {
+            genForceTrajectory[i] = solver.solve(
+                    state, Qs, coordinatesToSpeedsIndexMap, times[i]);
+            if (frameFunction) frameFunction(*block.model, state, i);
+        }
+    }, numBlocks);
+
+    // Step the analyses in order, and leave s at the last frame. Realize the
+    // state as solve() does so analyses see the same state as in serial.
+    const bool stepAnalyses = analysisSet.getSize() > 0;
+    for (int i = stepAnalyses ? 1 : nt - 1; i < nt; i++) {
+        setStateFromFunctions(s, Qs, coordinatesToSpeedsIndexMap, times[i]);
+        model.getMultibodySystem().realize(s, SimTK::Stage::Dynamics);
+        analysisSet.step(s, i);
+    }
+}
+
 } // end of namespace OpenSim
\ No newline at end of file
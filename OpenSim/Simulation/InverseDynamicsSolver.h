@@ -26,6 +26,8 @@
 #include "Solver.h"
 #include "SimTKcommon/internal/State.h"
 
+#include <functional>
+
 namespace OpenSim {
 
 class FunctionSet;
@@ -121,6 +123,33 @@ public:
             const std::vector<int> coordinatesToSpeedsIndexMap,
             const SimTK::Array_<double>& times,
             SimTK::Array_<SimTK::Vector>& genForceTrajectory);
+
+    /** Called by solveInParallel() after each frame is solved, with the copy
+        of the model and the state that solved it and the index of the frame.
+        It is called concurrently for different frames. */
+    typedef std::function<void(const Model& model, const SimTK::State& s,
+            int frame)> FrameFunction;
+
+    /** Same as above, but the time points are partitioned into contiguous
+        blocks that are solved concurrently, each on its own thread with its
+        own copy of the model. The copies are made on the calling thread, and
+        take which forces are applied and the values of auxiliary state
+        variables (z) from `s`. genForceTrajectory is filled in place. The
+        model's analyses are stepped afterward, in order of time, with `s`
+        set to the coordinates, speeds and accelerations of each frame; on
+        return, `s` holds the last frame.
+        @param numThreads  the number of threads, and copies of the model. If
+                           0, the number of hardware threads is used; if 1,
+                           the frames are solved in sequence with the model
+                           of the solver, and no copy is made.
+        @param frameFunction  if provided, called after each frame is
+                              solved, while the state holds the frame. */
+    void solveInParallel(SimTK::State& s, const FunctionSet& Qs,
+            const std::vector<int>& coordinatesToSpeedsIndexMap,
+            const SimTK::Array_<double>& times,
+            SimTK::Array_<SimTK::Vector>& genForceTrajectory,
+            int numThreads = 0,
+            const FrameFunction& frameFunction = nullptr);
 #endif
 //=============================================================================
 };  // END of class InverseDynamicsSolver
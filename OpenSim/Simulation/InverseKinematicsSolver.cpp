@@ -28,6 +28,8 @@
 #include "simbody/internal/AssemblyCondition_Markers.h"
 #include "simbody/internal/AssemblyCondition_OrientationSensors.h"
 
+#include <algorithm>
+
 using namespace std;
 using namespace SimTK;
 
@@ -289,6 +291,40 @@ void InverseKinematicsSolver::
                     findCurrentMarkerErrorSquared(SimTK::Markers::MarkerIx(i));
 }
 
+void InverseKinematicsSolver::setAdaptiveAccuracy(double relaxedAccuracy,
+        double markerErrorThreshold)
+{
+    OPENSIM_THROW_IF(markerErrorThreshold < 0, Exception,
+            "Expected the marker error threshold to be non-negative, but got "
+            "{}.", markerErrorThreshold);
+    OPENSIM_THROW_IF(markerErrorThreshold > 0 &&
+                             !(relaxedAccuracy > 0 && relaxedAccuracy < 1),
+            Exception,
+            "Expected the relaxed accuracy to be in (0, 1), but got {}.",
+            relaxedAccuracy);
+    _relaxedAccuracy = relaxedAccuracy;
+    _markerErrorThreshold = markerErrorThreshold;
+}
+
+void InverseKinematicsSolver::track(SimTK::State &s)
+{
+    AssemblySolver::track(s);
+
+    if (_markerErrorThreshold <= 0 || getNumMarkersInUse() == 0) return;
+    SimTK::Array_<double> squaredErrors;
+    computeCurrentSquaredMarkerErrors(squaredErrors);
+    const double maxSquaredError =
+            *std::max_element(squaredErrors.begin(), squaredErrors.end());
+
+    SimTK::Assembler& assembler = updAssembler();
+    const double accuracy = assembler.getAccuracyInUse();
+    const double tightest = std::min(getAccuracy(), _relaxedAccuracy);
+    if (maxSquaredError < _markerErrorThreshold * _markerErrorThreshold)
+        assembler.setAccuracy(std::min(10 * accuracy, _relaxedAccuracy));
+    else
+        assembler.setAccuracy(std::max(accuracy / 10, tightest));
+}
+
 /* Marker errors are reported in order different from tasks file or model, find name corresponding to passed in index  */
 std::string InverseKinematicsSolver::getMarkerNameForIndex(int markerIndex) const
 {
@@ -481,12 +517,11 @@ void InverseKinematicsSolver::updateGoals(SimTK::State &s)
         double nextTime = NaN;
         if (_orientationsReference &&
                 _orientationsReference->getNumRefs() > 0) {
-            SimTK::Array_<SimTK::Rotation> orientationValues;
             _orientationsReference->getNextValuesAndTime(
-                    nextTime, orientationValues);
+                    nextTime, _orientationValues);
             s.setTime(nextTime);
             _orientationAssemblyCondition->moveAllObservations(
-                    orientationValues);
+                    _orientationValues);
         }
         // update coordinates if any based on new time
         AssemblySolver::updateGoals(s);
@@ -498,16 +533,14 @@ void InverseKinematicsSolver::updateGoals(SimTK::State &s)
     double nextTime = s.getTime();
     // specify the marker observations to be matched
     if (_markersReference && _markersReference->getNumRefs() > 0) {
-        SimTK::Array_<SimTK::Vec3> markerValues;
-        _markersReference->getValuesAtTime(nextTime, markerValues);
-        _markerAssemblyCondition->moveAllObservations(markerValues);
+        _markersReference->getValuesAtTime(nextTime, _markerValues);
+        _markerAssemblyCondition->moveAllObservations(_markerValues);
     }
 
     // specify the orientation observations to be matched
     if (_orientationsReference && _orientationsReference->getNumRefs() > 0) {
-        SimTK::Array_<SimTK::Rotation> orientationValues;
-        _orientationsReference->getValuesAtTime(nextTime, orientationValues);
-        _orientationAssemblyCondition->moveAllObservations(orientationValues);
+        _orientationsReference->getValuesAtTime(nextTime, _orientationValues);
+        _orientationAssemblyCondition->moveAllObservations(_orientationValues);
     }
 }
 
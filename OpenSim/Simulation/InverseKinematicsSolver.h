@@ -124,6 +124,11 @@ public:
         to track a desired trajectory of coordinate values. */
     //virtual void track(SimTK::State &s);
 
+    /** Track as AssemblySolver::track() does, and then, if adaptive accuracy
+        is enabled, adjust the accuracy for the next frame according to the
+        marker errors of this frame. */
+    void track(SimTK::State &s) override;
+
     /** Return the number of markers used to solve for model coordinates.
         It is a count of the number of markers in the intersection of 
         the reference markers and model markers.
@@ -232,6 +237,18 @@ public:
         _advanceTimeFromReference = newValue;
     };
 
+    /** Adapt the accuracy of track() to the marker errors. After a frame
+        whose largest marker error is below `markerErrorThreshold`, the
+        accuracy is relaxed by a factor of 10, up to `relaxedAccuracy`;
+        after a frame whose largest marker error is above it, the accuracy is
+        tightened by a factor of 10, down to the accuracy passed to
+        setAccuracy(). Frames that fit the markers well then take fewer
+        iterations, while frames that do not are solved to full accuracy.
+        assemble() always uses the accuracy passed to setAccuracy(). A
+        threshold of 0 (default) disables adaptation. */
+    void setAdaptiveAccuracy(double relaxedAccuracy,
+                             double markerErrorThreshold);
+
 protected:
     /** Override to include point of interest matching (Marker tracking)
         as well ad Frame orientation (OSensor) tracking.
@@ -263,10 +280,20 @@ private:
     // the SimTK::Assembler and the memory is managed by the Assembler
     SimTK::ReferencePtr<SimTK::OrientationSensors> _orientationAssemblyCondition;
 
+    // Reference values of the current frame, kept between calls to
+    // updateGoals() so that tracking does not allocate at every frame.
+    SimTK::Array_<SimTK::Vec3> _markerValues;
+    SimTK::Array_<SimTK::Rotation> _orientationValues;
+
     // internal flag indicating whether time is advanced based on live data or
     // controlled by the driver porgram (typically based on pre-recorded data).
     bool _advanceTimeFromReference{false};
 
+    // Bounds on the accuracy of track() and the marker error that decides
+    // between them; a threshold of 0 disables adapting the accuracy.
+    double _relaxedAccuracy{0};
+    double _markerErrorThreshold{0};
+
 //=============================================================================
 };  // END of class InverseKinematicsSolver
 //=============================================================================
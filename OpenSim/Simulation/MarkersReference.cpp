@@ -23,6 +23,7 @@
 
 #include "MarkersReference.h"
 #include <SimTKcommon/internal/State.h>
+#include <algorithm>
 #include <cmath>
 
 using namespace std;
@@ -132,6 +133,18 @@ populateFromMarkerData(const TimeSeriesTable_<SimTK::Vec3>& markerTable,
 
     // Names must be assigned before weights can be updated
     updateInternalWeights();
+
+    updateFrameValues();
+}
+
+void MarkersReference::updateFrameValues() {
+    const int nr = static_cast<int>(_markerTable.getNumRows());
+    const int nc = static_cast<int>(_markerTable.getNumColumns());
+    const auto& matrix = _markerTable.getMatrix();
+    _frameValues.resize(static_cast<size_t>(nr) * nc);
+    for (int r = 0; r < nr; ++r)
+        for (int c = 0; c < nc; ++c)
+            _frameValues[static_cast<size_t>(r) * nc + c] = matrix(r, c);
 }
 
 SimTK::Vec2 MarkersReference::getValidTimeRange() const {
@@ -156,10 +169,38 @@ const SimTK::Array_<std::string>& MarkersReference::getNames() const {
 
 void MarkersReference::getValuesAtTime(double time,
                                   SimTK::Array_<Vec3>& values) const {
-    const auto rowView = _markerTable.getNearestRow(time);
-    values.clear();
-    for(int i = 0; i < rowView.ncol(); ++i)
-        values.push_back(rowView[i]);
+    const auto& times = _markerTable.getIndependentColumn();
+    const int nearest =
+            static_cast<int>(_markerTable.getNearestRowIndexForTime(time));
+    // The frames before and after time, if interpolating.
+    int first = nearest;
+    int second = nearest;
+    if (_interpolate) {
+        if (time < times[nearest] && nearest > 0)
+            first = nearest - 1;
+        else if (time > times[nearest] &&
+                 nearest + 1 < static_cast<int>(times.size()))
+            second = nearest + 1;
+    }
+
+    const int n = getNumRefs();
+    values.resize(n);
+    const Vec3* firstValues = getValuesAtFrame(first);
+    if (first == second) {
+        std::copy(firstValues, firstValues + n, values.begin());
+        return;
+    }
+    const Vec3* secondValues = getValuesAtFrame(second);
+    const double s = (time - times[first]) / (times[second] - times[first]);
+    for (int i = 0; i < n; ++i)
+        values[i] = firstValues[i] + s * (secondValues[i] - firstValues[i]);
+}
+
+const SimTK::Vec3* MarkersReference::getValuesAtFrame(int frame) const {
+    OPENSIM_THROW_IF(frame < 0 || frame >= static_cast<int>(getNumFrames()),
+            IndexOutOfRange, frame, 0,
+            static_cast<int>(getNumFrames()) - 1);
+    return _frameValues.data() + static_cast<size_t>(frame) * getNumRefs();
 }
 
 // void
@@ -143,9 +143,17 @@ public:
     SimTK::Vec2 getValidTimeRange() const override;
     /** get the names of the markers serving as references */
     const SimTK::Array_<std::string>& getNames() const override;
-    /** get the value of the MarkersReference  */
+    /** get the value of the MarkersReference at the frame nearest to `time`,
+        or interpolated linearly between the frames around `time` if
+        setInterpolateValues(true) was called. `values` is resized to
+        getNumRefs(), so passing the same array at every time step avoids
+        reallocating it. */
     void getValuesAtTime(
             double time, SimTK::Array_<SimTK::Vec3> &values) const override;
+    /** get the values of all markers at the given frame (row of the marker
+        table), stored contiguously in the same order as names. The pointer
+        is valid as long as the marker data of this reference is unchanged. */
+    const SimTK::Vec3* getValuesAtFrame(int frame) const;
     // The following two methods are commented out as they are not implemented
     // and we don't want users to think it *is* implemented when viewing
     // doxygen.
@@ -176,6 +184,12 @@ public:
     void setMarkerWeightSet(const Set<MarkerWeight>& markerWeights);
     void setDefaultWeight(double weight);
     size_t getNumFrames() const;
+    /** Whether getValuesAtTime() interpolates linearly between frames
+        (true) or returns the frame nearest to the requested time (false,
+        default). A marker that is missing (NaN) in either frame is missing
+        in the interpolated values. */
+    void setInterpolateValues(bool interpolate) { _interpolate = interpolate; }
+    bool getInterpolateValues() const { return _interpolate; }
 
 private:
     void constructProperties();
@@ -184,8 +198,13 @@ private:
                            const Set<MarkerWeight>& markerWeightSet,
                            const std::string& units = "Meters");
     void updateInternalWeights() const;
+    void updateFrameValues();
 
     TimeSeriesTable_<SimTK::Vec3> _markerTable;
+    // Copy of the marker table stored row by row, so that the values of a
+    // frame are contiguous.
+    std::vector<SimTK::Vec3> _frameValues;
+    bool _interpolate{false};
     // marker names inside the marker data
     SimTK::Array_<std::string> _markerNames;
     // List of weights guaranteed to be in the same order as marker names.
@@ -349,9 +349,43 @@ printResults(const string &aBaseName,const string &aDir,double aDT,
 
 ArrayPtrs<Storage>& Analysis::getStorageList()
 {
+    flushResultBuffers();
     return _storageList;
 }
 
+void Analysis::flushResultBuffers() const
+{
+    for (auto& buffer : _resultBuffers) {
+        buffer.second->flushTo(*buffer.first);
+    }
+}
+
+ResultBuffer& Analysis::addResultBuffer(Storage& aStorage, int aNumColumns)
+{
+    _resultBuffers.emplace_back(&aStorage,
+            std::unique_ptr<ResultBuffer>(new ResultBuffer(aNumColumns)));
+    return *_resultBuffers.back().second;
+}
+
+void Analysis::clearResultBuffers()
+{
+    _resultBuffers.clear();
+}
+
+void Analysis::appendResults(Analysis& aAnalysis)
+{
+    ArrayPtrs<Storage>& storages = getStorageList();
+    ArrayPtrs<Storage>& otherStorages = aAnalysis.getStorageList();
+    OPENSIM_THROW_IF_FRMOBJ(storages.getSize() != otherStorages.getSize(),
+            Exception,
+            "Expected the analysis to append to have {} storages, but it has "
+            "{}.", storages.getSize(), otherStorages.getSize());
+    for (int i = 0; i < storages.getSize(); ++i) {
+        if (storages[i] == nullptr || otherStorages[i] == nullptr) continue;
+        storages[i]->append(*otherStorages[i]);
+    }
+}
+
 // GET AND SET
 //=============================================================================
 //_____________________________________________________________________________
@@ -35,8 +35,13 @@
 #include <OpenSim/Common/PropertyInt.h>
 #include <OpenSim/Common/ArrayPtrs.h>
 #include <OpenSim/Common/Array.h>
+#include <OpenSim/Common/ResultBuffer.h>
 #include <OpenSim/Common/Storage.h>
 
+#include <memory>
+#include <utility>
+#include <vector>
+
 namespace SimTK {
 class State;
 }
@@ -94,6 +99,13 @@ protected:
     ArrayPtrs<Storage> _storageList;
     bool _printResultFiles;
 
+private:
+#ifndef SWIG
+    /** Buffers of results and the storages to which they are flushed. */
+    mutable std::vector<std::pair<Storage*, std::unique_ptr<ResultBuffer>>>
+            _resultBuffers;
+#endif
+
 //=============================================================================
 // METHODS
 //=============================================================================
@@ -208,7 +220,57 @@ public:
     void setStorageInterval(int aInterval);
     int getStorageInterval() const;
 #endif
+    /** The storages of this analysis, with any buffered results flushed to
+    them (see flushResultBuffers()). */
     virtual ArrayPtrs<Storage>& getStorageList();
+    /**
+     * Append the rows recorded in the result buffers of this analysis (see
+     * addResultBuffer()) to their storages. Analyses that buffer their
+     * results call this in end() and printResults(), and before returning
+     * their storages; call it to read the storages directly while the
+     * analysis is being performed.
+     */
+    void flushResultBuffers() const;
+
+    //--------------------------------------------------------------------------
+    // FRAME INDEPENDENCE
+    //--------------------------------------------------------------------------
+    /**
+     * Whether the results of this analysis at each step depend only on the
+     * state at that step, and not on the states at previous steps (e.g.,
+     * through integration or finite differencing). If so, a tool may perform
+     * the analysis on blocks of consecutive states concurrently, each block
+     * with a copy of the model and of this analysis, calling begin() at the
+     * first state of each block, and then append the results of the copies
+     * in time order with appendResults(). Returns false unless overridden.
+     */
+    virtual bool isFrameIndependent() const { return false; }
+    /**
+     * Append the results of a copy of this analysis, that was performed on
+     * states after those of this analysis, to the results of this analysis.
+     * The default implementation appends the rows of each storage in
+     * getStorageList() to the corresponding storage of this analysis;
+     * analyses that record to other storages override this method.
+     *
+     * @param aAnalysis Copy of this analysis whose results are appended.
+     */
+    virtual void appendResults(Analysis& aAnalysis);
+
+protected:
+    /**
+     * Create a buffer to which record() can append the rows of results
+     * for `aStorage` (a row of `aNumColumns` values, not counting time, per
+     * step) without allocating memory for each row; flushResultBuffers()
+     * appends the buffered rows to `aStorage`. The buffer is owned by this
+     * analysis and remains valid until clearResultBuffers() is called, which
+     * must be done before `aStorage` is deleted.
+     */
+    ResultBuffer& addResultBuffer(Storage& aStorage, int aNumColumns);
+    /** Discard the result buffers, and any rows they hold. */
+    void clearResultBuffers();
+
+public:
+
     void setPrintResultFiles(bool aToWrite) { _printResultFiles = aToWrite; }
     bool getPrintResultFiles() const { return _printResultFiles; }
 
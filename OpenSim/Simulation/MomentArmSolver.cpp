@@ -60,20 +60,41 @@ Refer to Moment-arm Theory document by Michael Sherman for details.
 **********************************************************************************/
 double MomentArmSolver::solve(const State &state, const Coordinate &aCoord,
                               const GeometryPath &path) const
+{
+    // compute the coupling between coordinates due to constraints
+    _coupling = computeCoupling(state, aCoord);
+
+    _generalizedForces = computeGeneralizedForces(state, path);
+
+    // Moment-arm is the effective torque (since tension is 1) at the 
+    // coordinate of interest taking into account the generalized forces also 
+    // acting on other coordinates that are coupled via constraint.
+    return ~_coupling*_generalizedForces;
+}
+
+SimTK::Vector MomentArmSolver::computeCoupling(const State &state,
+                                               const Coordinate &aCoord) const
 {
     //Local modifiable copy of the state
     State& s_ma = _stateCopy;
     s_ma.updQ() = state.getQ();
 
-    // compute the coupling between coordinates due to constraints
-    _coupling = computeCouplingVector(s_ma, aCoord);
+    return computeCouplingVector(s_ma, aCoord);
+}
+
+SimTK::Vector MomentArmSolver::computeGeneralizedForces(const State &state,
+                                                const GeometryPath &path) const
+{
+    //Local modifiable copy of the state
+    State& s_ma = _stateCopy;
+    s_ma.updQ() = state.getQ();
 
     // set speeds to zero
     s_ma.updU() = 0;
 
     // zero out all the forces
     _bodyForces *= 0;
-    _generalizedForces = 0;
+    Vector generalizedForces(s_ma.getNU(), 0.0);
 
     // apply a tension of unity to the bodies of the path
     Vector pathDependentMobilityForces(s_ma.getNU(), 0.0);
@@ -84,13 +105,10 @@ double MomentArmSolver::solve(const State &state, const Coordinate &aCoord,
     // Convert body spatial forces F to equivalent mobility forces f based on 
     // geometry (no dynamics required): f = ~J(q) * F.
     getModel().getMultibodySystem().getMatterSubsystem()
-        .multiplyBySystemJacobianTranspose(s_ma, _bodyForces, _generalizedForces);
+        .multiplyBySystemJacobianTranspose(s_ma, _bodyForces, generalizedForces);
 
-    _generalizedForces += pathDependentMobilityForces;
-    // Moment-arm is the effective torque (since tension is 1) at the 
-    // coordinate of interest taking into account the generalized forces also 
-    // acting on other coordinates that are coupled via constraint.
-    return ~_coupling*_generalizedForces;
+    generalizedForces += pathDependentMobilityForces;
+    return generalizedForces;
 }
 
 
@@ -83,6 +83,28 @@ public:
     double solve(const SimTK::State& state, const Coordinate &coordinate, 
         const Array<PointForceDirection *> &pfds) const;
 
+    /** Compute the coupling vector of a coordinate: the speeds of all the
+        mobilities when the speed of the coordinate is 1 and the constraints
+        are satisfied. The moment-arm of any path about the coordinate is the
+        dot product of this vector with the generalized forces of the path
+        (see computeGeneralizedForces()), so the coupling vector of a
+        coordinate can be shared by all paths at the same state.
+    @param  state               current state of the model
+    @param  coordinate          Coordinate about which we want moment-arms
+    @return coupling            one element per mobility (u) of the model
+    */
+    SimTK::Vector computeCoupling(const SimTK::State& state,
+        const Coordinate &coordinate) const;
+
+    /** Compute the generalized forces, f = ~J*F, due to a unit tension along
+        a GeometryPath. These do not depend on the coordinate of interest.
+    @param  state               current state of the model
+    @param  path                GeometryPath that is to carry the tension
+    @return f                   one element per mobility (u) of the model
+    */
+    SimTK::Vector computeGeneralizedForces(const SimTK::State& state,
+        const GeometryPath &path) const;
+
 private:
     // Internal state of the solver initialized as a copy of the default state
     mutable SimTK::State _stateCopy;
@@ -26,6 +26,8 @@
 #include <OpenSim/Common/TRCFileAdapter.h>
 #include <SimTKcommon/internal/State.h>
 
+#include <algorithm>
+
 using namespace std;
 using namespace SimTK;
 
@@ -114,6 +116,13 @@ void OrientationsReference::populateFromOrientationData()
         throw Exception("OrientationsReference: Mismatch between the number "
             "of orientation names and weights. Verify that orientation names "
             "are unique.");
+
+    const int nr = int(_orientationData.getNumRows());
+    const auto& matrix = _orientationData.getMatrix();
+    _frameValues.resize(size_t(nr) * no);
+    for (int r = 0; r < nr; ++r)
+        for (int c = 0; c < int(no); ++c)
+            _frameValues[size_t(r) * no + c] = matrix(r, c);
 }
 
 int OrientationsReference::getNumRefs() const
@@ -159,17 +168,57 @@ void OrientationsReference::getValuesAtTime(
         double time, SimTK::Array_<Rotation> &values) const
 {
 
-    // get values for time
-    SimTK::RowVector_<Rotation> row = _orientationData.getRow(time);
+    const auto& times = _orientationData.getIndependentColumn();
+    int first, second;
+    if (_interpolate) {
+        // The frames before and after time.
+        first = second = getNearestFrame(time);
+        if (time < times[first] && first > 0)
+            --first;
+        else if (time > times[second] && second + 1 < int(times.size()))
+            ++second;
+    } else {
+        // The frame at exactly this time.
+        const auto iter = std::lower_bound(times.begin(), times.end(), time);
+        OPENSIM_THROW_IF(iter == times.end() || *iter != time, KeyNotFound,
+                std::to_string(time));
+        first = second = int(iter - times.begin());
+    }
 
-    int n = row.size();
+    const int n = getNumRefs();
     values.resize(n);
-
+    const Rotation* firstValues = getValuesAtFrame(first);
+    if (first == second) {
+        std::copy(firstValues, firstValues + n, values.begin());
+        return;
+    }
+    // Rotate from the first orientation toward the second about the axis of
+    // the rotation between them (i.e., slerp).
+    const Rotation* secondValues = getValuesAtFrame(second);
+    const double s = (time - times[first]) / (times[second] - times[first]);
     for (int i = 0; i < n; ++i) {
-        values[i] = row[i];
+        const Vec4 angleAxis = (~firstValues[i] * secondValues[i])
+                                       .convertRotationToAngleAxis();
+        values[i] = firstValues[i] *
+                    Rotation(s * angleAxis[0],
+                            UnitVec3(angleAxis[1], angleAxis[2], angleAxis[3]));
     }
 }
 
+int OrientationsReference::getNearestFrame(double time) const
+{
+    return int(_orientationData.getNearestRowIndexForTime(time));
+}
+
+const SimTK::Rotation* OrientationsReference::getValuesAtFrame(
+        int frame) const
+{
+    const int nr = int(_orientationData.getNumRows());
+    OPENSIM_THROW_IF(frame < 0 || frame >= nr, IndexOutOfRange, frame, 0,
+            nr - 1);
+    return _frameValues.data() + size_t(frame) * getNumRefs();
+}
+
 /** get the weights of the Orientations */
 void  OrientationsReference::getWeights(const SimTK::State &s, SimTK::Array_<double> &weights) const
 {
@@ -122,9 +122,25 @@ public:
     const std::vector<double>& getTimes() const;
     /** get the names of the Orientations serving as references */
     const SimTK::Array_<std::string>& getNames() const override;
-    /** get the value of the OrientationsReference */
+    /** get the value of the OrientationsReference at `time`, or
+        interpolated (spherically) between the frames around `time` if
+        setInterpolateValues(true) was called. `values` is resized to
+        getNumRefs(), so passing the same array at every time step avoids
+        reallocating it.
+        @throws KeyNotFound if not interpolating and no frame is at exactly
+        `time`; use getValuesAtFrame(getNearestFrame(time)) for the frame
+        nearest to `time`. */
     void getValuesAtTime(double time,
         SimTK::Array_<SimTK::Rotation_<double>>& values) const override;
+    /** get the orientations at the given frame (row of the orientation
+        data), stored contiguously in the same order as names. The pointer is
+        valid as long as the orientation data of this reference is
+        unchanged. */
+    const SimTK::Rotation* getValuesAtFrame(int frame) const;
+    /** get the frame (row of the orientation data) whose time is nearest
+        to `time`.
+        @throws TimeOutOfRange if `time` is outside the range of the data. */
+    int getNearestFrame(double time) const;
     /** Default implementation does not support streaming */
     virtual void getNextValuesAndTime(
             double& time, SimTK::Array_<SimTK::Rotation_<double>>& values) override {
@@ -151,6 +167,10 @@ public:
     InverseKinematicsSolver prior to solving at any instant in time. */
     void setOrientationWeightSet(const Set<OrientationWeight>& orientationWeights);
     void setDefaultWeight(double weight) { set_default_weight(weight); }
+    /** Whether getValuesAtTime() interpolates between frames (true) or
+        returns the frame nearest to the requested time (false, default). */
+    void setInterpolateValues(bool interpolate) { _interpolate = interpolate; }
+    bool getInterpolateValues() const { return _interpolate; }
 
 private:
     void constructProperties();
@@ -165,6 +185,10 @@ private:
     SimTK::Array_<std::string> _orientationNames;
     // corresponding list of weights guaranteed to be in the same order as names above
     SimTK::Array_<double> _weights;
+    // Copy of the orientation data stored row by row, so that the
+    // orientations of a frame are contiguous.
+    std::vector<SimTK::Rotation> _frameValues;
+    bool _interpolate{false};
 
 //=============================================================================
 };  // END of class OrientationsReference
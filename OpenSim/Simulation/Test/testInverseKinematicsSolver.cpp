@@ -76,6 +76,10 @@ generateOrientationsDataFromModelAndStates(const Model& model,
 // Verify that accuracy improves the number of decimals points to which
 // the solver solution (coordinates) can be trusted as it is tightened.
 void testAccuracy();
+// Verify that adaptive accuracy relaxes the accuracy of track() after
+// frames with small marker errors, tightens it after frames with large ones,
+// and that getLastAccuracy() reports the accuracy used for each frame.
+void testAdaptiveAccuracy();
 // Verify that the marker weights impact the solver and has the expected
 // effect of reducing the error for the marker weight that is increased. 
 void testUpdateMarkerWeights();
@@ -108,6 +112,10 @@ int main()
     catch (const std::exception& e) {
         cout << e.what() << endl; failures.push_back("testAccuracy");
     }
+    try { testAdaptiveAccuracy(); }
+    catch (const std::exception& e) {
+        cout << e.what() << endl; failures.push_back("testAdaptiveAccuracy");
+    }
     try { testUpdateMarkerWeights(); }
     catch (const std::exception& e) {
         cout << e.what() << endl;
@@ -210,6 +218,40 @@ void testMarkersReference()
         SimTK_ASSERT_ALWAYS(weights[i] == double(i),
             "Mismatched weight to marker.");
     }
+
+    // Values are returned for the nearest frame, or interpolated.
+    TimeSeriesTable_<SimTK::Vec3> movingData;
+    movingData.setColumnLabels(labels);
+    for (size_t r{0}; r < nr; ++r) {
+        SimTK::RowVector_<SimTK::Vec3> row{int(nc)};
+        for (size_t m{0}; m < nc; ++m)
+            row[int(m)] = SimTK::Vec3(double(r), double(m), -double(r * m));
+        movingData.appendRow(0.1*r, row);
+    }
+    MarkersReference movingRef(movingData, Set<MarkerWeight>());
+    SimTK::Array_<SimTK::Vec3> values;
+    for (size_t r{0}; r < nr; ++r) {
+        const SimTK::Vec3* frameValues = movingRef.getValuesAtFrame(int(r));
+        for (size_t m{0}; m < nc; ++m) {
+            SimTK_ASSERT_ALWAYS(frameValues[m] ==
+                    movingData.getRowAtIndex(r)[int(m)],
+                "Mismatched marker value in frame.");
+        }
+    }
+    movingRef.getValuesAtTime(0.17, values);
+    SimTK_ASSERT_ALWAYS(values.size() == nc && values[4] ==
+            movingData.getRowAtIndex(2)[4],
+        "Expected the values of the nearest frame.");
+    movingRef.setInterpolateValues(true);
+    movingRef.getValuesAtTime(0.17, values);
+    for (size_t m{0}; m < nc; ++m) {
+        const SimTK::Vec3 expected(1.7, double(m), -1.7 * m);
+        SimTK_ASSERT_ALWAYS((values[m] - expected).norm() < 1e-10,
+            "Expected interpolated marker values.");
+    }
+    movingRef.getValuesAtTime(0.4, values);
+    SimTK_ASSERT_ALWAYS(values[5] == movingData.getRowAtIndex(4)[5],
+        "Expected the values of the last frame.");
 }
 
 void testOrientationsReference() {
@@ -278,6 +320,44 @@ void testOrientationsReference() {
         SimTK_ASSERT_ALWAYS(weights[i] == double(i),
                 "Mismatched weight to orientation sensor.");
     }
+
+    // Orientations are returned for the frame at a time, for the nearest
+    // frame, or interpolated.
+    TimeSeriesTable_<SimTK::Rotation> rotatingData;
+    rotatingData.setColumnLabels(labels);
+    for (size_t r{0}; r < nr; ++r) {
+        SimTK::RowVector_<SimTK::Rotation> row{int(nc)};
+        for (size_t m{0}; m < nc; ++m)
+            row[int(m)] = SimTK::Rotation(0.2 * r * (m + 1), SimTK::ZAxis);
+        rotatingData.appendRow(0.1 * r, row);
+    }
+    OrientationsReference rotatingRef(rotatingData);
+    SimTK::Array_<SimTK::Rotation> values;
+    rotatingRef.getValuesAtTime(rotatingData.getIndependentColumn()[2], values);
+    SimTK_ASSERT_ALWAYS(values.size() == nc &&
+            values[3].isSameRotationToWithinAngle(
+                    rotatingData.getRowAtIndex(2)[3], 1e-10),
+            "Expected the orientations of the frame at the time.");
+    bool threw = false;
+    try {
+        rotatingRef.getValuesAtTime(0.17, values);
+    } catch (const KeyNotFound&) {
+        threw = true;
+    }
+    SimTK_ASSERT_ALWAYS(threw,
+            "Expected no orientations between frames without interpolation.");
+    SimTK_ASSERT_ALWAYS(rotatingRef.getNearestFrame(0.17) == 2 &&
+            rotatingRef.getValuesAtFrame(2)[3].isSameRotationToWithinAngle(
+                    rotatingData.getRowAtIndex(2)[3], 1e-10),
+            "Expected the orientations of the nearest frame.");
+    rotatingRef.setInterpolateValues(true);
+    rotatingRef.getValuesAtTime(0.17, values);
+    for (size_t m{0}; m < nc; ++m) {
+        const SimTK::Rotation expected(0.2 * 1.7 * (m + 1), SimTK::ZAxis);
+        SimTK_ASSERT_ALWAYS(
+                values[m].isSameRotationToWithinAngle(expected, 1e-10),
+                "Expected interpolated orientations.");
+    }
 }
 
 
@@ -397,6 +477,68 @@ void testAccuracy()
         "when accuracy was tightened.");
 }
 
+void testAdaptiveAccuracy()
+{
+    cout << "\ntestInverseKinematicsSolver::testAdaptiveAccuracy()" << endl;
+
+    std::unique_ptr<Model> pendulum{ constructPendulumWithMarkers() };
+    Coordinate& coord = pendulum->getCoordinateSet()[0];
+
+    SimTK::State state = pendulum->initSystem();
+    coord.setValue(state, 0.123456789);
+    StatesTrajectory states;
+    states.append(state);
+
+    // Offset one marker out of the plane of motion of the pendulum so that
+    // it always has an error of 5 cm.
+    const double markerError = 0.05;
+    SimTK::RowVector_<SimTK::Vec3> biases(3, SimTK::Vec3(0));
+    biases[0] = SimTK::Vec3(0, 0, markerError);
+    std::shared_ptr<MarkersReference>
+        markersRef(
+            new MarkersReference(generateMarkerDataFromModelAndStates(
+                    *pendulum, states, biases),
+            Set<MarkerWeight>()));
+    markersRef->setDefaultWeight(1.0);
+
+    const auto checkLastAccuracy = [](const InverseKinematicsSolver& solver,
+                                       double expected) {
+        cout << "Accuracy used: " << solver.getLastAccuracy()
+             << "; expected: " << expected << endl;
+        SimTK_ASSERT_ALWAYS(
+                abs(solver.getLastAccuracy() - expected) <= 1e-3 * expected,
+                "InverseKinematicsSolver did not use the expected accuracy.");
+    };
+
+    const double accuracy = 1e-8;
+    const double relaxedAccuracy = 1e-4;
+    SimTK::Array_<CoordinateReference> coordRefs;
+    coord.setValue(state, 0.0);
+    InverseKinematicsSolver ikSolver(*pendulum, markersRef, coordRefs);
+    ikSolver.setAccuracy(accuracy);
+    // All frames are below the threshold: the accuracy is relaxed.
+    ikSolver.setAdaptiveAccuracy(relaxedAccuracy, 10 * markerError);
+    ikSolver.assemble(state);
+    checkLastAccuracy(ikSolver, accuracy);
+
+    double expected = accuracy;
+    for (int i = 0; i < 6; ++i) {
+        ikSolver.track(state);
+        checkLastAccuracy(ikSolver, expected);
+        expected = std::min(10 * expected, relaxedAccuracy);
+    }
+
+    // All frames are above the threshold: the accuracy is tightened back to
+    // the accuracy passed to setAccuracy().
+    ikSolver.setAdaptiveAccuracy(relaxedAccuracy, markerError / 10);
+    expected = relaxedAccuracy;
+    for (int i = 0; i < 6; ++i) {
+        ikSolver.track(state);
+        checkLastAccuracy(ikSolver, expected);
+        expected = std::max(expected / 10, accuracy);
+    }
+}
+
 void testUpdateMarkerWeights()
 {
     cout << "\ntestInverseKinematicsSolver::testUpdateMarkerWeights()" << endl;
@@ -36,6 +36,7 @@
 //=============================================================================
 #include <OpenSim/Simulation/osimSimulation.h>
 #include <OpenSim/Actuators/Thelen2003Muscle.h>
+#include <OpenSim/Analyses/MuscleAnalysis.h>
 #include <OpenSim/Auxiliary/auxiliaryTestFunctions.h>
 #include <OpenSim/Common/LoadOpenSimLibrary.h>
 
@@ -56,6 +57,8 @@ void testMomentArmDefinitionForModel(const string &filename,
 
 void testMomentArmsAcrossCompoundJoint();
 
+void testMuscleAnalysisMomentArms(const string &filename);
+
 int main()
 {
     clock_t startTime = clock();
@@ -128,6 +131,11 @@ int main()
 
         testMomentArmDefinitionForModel("CoupledCoordinatesMPPsMomentArmTest.osim", "foot_angle", "vas_int_r", SimTK::Vec2(-2*SimTK::Pi/3, SimTK::Pi/18), -1.0, "Multiple moving path points: FAILED");
         cout << "Multiple moving path points coupled coordinates test: PASSED\n" << endl;
+
+        testMuscleAnalysisMomentArms("testMomentArmsConstraintB.osim");
+        testMuscleAnalysisMomentArms("CoupledCoordinatesMPPsMomentArmTest.osim");
+        testMuscleAnalysisMomentArms("gait2354_simbody.osim");
+        cout << "MuscleAnalysis moment arms of all muscles and coordinates: PASSED\n" << endl;
     }
     catch (const Exception& e) {
         e.print(cerr);
@@ -166,6 +174,71 @@ void testMomentArmsAcrossCompoundJoint()
         0.0, "testMomentArmsAcrossCompoundJoint: FAILED");
 }
 
+// MuscleAnalysis skips the muscles that cannot span a coordinate and shares
+// the constraint coupling of each coordinate among muscles. Its moment arms
+// must match those computed for each muscle and coordinate on their own.
+void testMuscleAnalysisMomentArms(const string &filename)
+{
+    Model model(filename);
+    SimTK::State& s = model.initSystem();
+    MuscleAnalysis analysis(&model);
+
+    const CoordinateSet& coordinates = model.getCoordinateSet();
+    const ArrayPtrs<MuscleAnalysis::StorageCoordinatePair>& pairs =
+        analysis.getMomentArmStorageArray();
+    ASSERT(pairs.getSize() == coordinates.getSize());
+    // The first column label is time.
+    const Array<string>& labels = analysis.getColumnLabels();
+    const int nm = labels.getSize() - 1;
+    ASSERT(nm > 0);
+
+    // Each step is at a new time; Storage overwrites a row at a repeated time.
+    const int numSteps = 3;
+    const double dt = 0.01;
+    std::vector<SimTK::Matrix> expected;
+    for (int k = 0; k < numSteps; ++k) {
+        s.setTime(k*dt);
+        // Move every coordinate away from its default value, within its range.
+        for (int i = 0; i < coordinates.getSize(); ++i) {
+            const Coordinate& coord = coordinates[i];
+            if (coord.getLocked(s) || coord.isDependent(s)) continue;
+            double value = coord.getDefaultValue() + 0.2*k;
+            value = std::min(std::max(value, coord.getRangeMin()),
+                             coord.getRangeMax());
+            coord.setValue(s, value, false);
+        }
+        model.assemble(s);
+        model.realizeVelocity(s);
+
+        SimTK::Matrix momentArms(pairs.getSize(), nm);
+        for (int i = 0; i < pairs.getSize(); ++i) {
+            for (int j = 0; j < nm; ++j) {
+                const Muscle& muscle = model.getMuscles().get(labels[j+1]);
+                momentArms(i, j) = muscle.computeMomentArm(s, *pairs[i]->q);
+            }
+        }
+        expected.push_back(momentArms);
+        analysis.step(s, k);
+    }
+
+    // Getting the storages again flushes the results recorded by step().
+    const ArrayPtrs<MuscleAnalysis::StorageCoordinatePair>& results =
+            analysis.getMomentArmStorageArray();
+    for (int i = 0; i < results.getSize(); ++i) {
+        const Storage& store = *results[i]->momentArmStore;
+        ASSERT(store.getSize() == numSteps);
+        for (int k = 0; k < numSteps; ++k) {
+            ASSERT_EQUAL(k*dt, store.getStateVector(k)->getTime(), 1e-12);
+            const Array<double>& row = store.getStateVector(k)->getData();
+            for (int j = 0; j < nm; ++j) {
+                ASSERT_EQUAL(expected[k](i, j), row[j], 1e-10, __FILE__,
+                    __LINE__, filename + ": moment arm of " + labels[j+1] +
+                    " about " + pairs[i]->q->getName());
+            }
+        }
+    }
+}
+
 //==========================================================================================================
 // moment_arm = dl/dtheta, definition using inexact perturbation technique
 //==========================================================================================================
@@ -21,6 +21,7 @@
  * -------------------------------------------------------------------------- */
 #include <OpenSim/Common/XMLDocument.h>
 #include "AnalyzeTool.h"
+#include <OpenSim/Common/CommonUtilities.h>
 #include <OpenSim/Common/IO.h>
 #include <OpenSim/Common/GCVSplineSet.h>
 
@@ -35,6 +36,8 @@
 #include <OpenSim/Simulation/Model/PrescribedForce.h>
 #include <OpenSim/Actuators/Thelen2003Muscle.h>
 
+#include <thread>
+
 using namespace OpenSim;
 using namespace std;
 
@@ -59,6 +62,7 @@ AnalyzeTool::AnalyzeTool() :
     _coordinatesFileName(_coordinatesFileNameProp.getValueStr()),
     _speedsFileName(_speedsFileNameProp.getValueStr()),
     _lowpassCutoffFrequency(_lowpassCutoffFrequencyProp.getValueDbl()),
+    _parallel(_parallelProp.getValueInt()),
     _printResultFiles(true),
     _loadModelAndInput(false)
 {
@@ -79,6 +83,7 @@ AnalyzeTool::AnalyzeTool(const string &aFileName, bool aLoadModelAndInput) :
     _coordinatesFileName(_coordinatesFileNameProp.getValueStr()),
     _speedsFileName(_speedsFileNameProp.getValueStr()),
     _lowpassCutoffFrequency(_lowpassCutoffFrequencyProp.getValueDbl()),
+    _parallel(_parallelProp.getValueInt()),
     _printResultFiles(true),
     _loadModelAndInput(aLoadModelAndInput)
 {
@@ -111,6 +116,7 @@ AnalyzeTool::AnalyzeTool(Model& aModel) :
     _coordinatesFileName(_coordinatesFileNameProp.getValueStr()),
     _speedsFileName(_speedsFileNameProp.getValueStr()),
     _lowpassCutoffFrequency(_lowpassCutoffFrequencyProp.getValueDbl()),
+    _parallel(_parallelProp.getValueInt()),
     _printResultFiles(true),
     _loadModelAndInput(false)
 {
@@ -171,6 +177,7 @@ AnalyzeTool(const AnalyzeTool &aTool) :
     _coordinatesFileName(_coordinatesFileNameProp.getValueStr()),
     _speedsFileName(_speedsFileNameProp.getValueStr()),
     _lowpassCutoffFrequency(_lowpassCutoffFrequencyProp.getValueDbl()),
+    _parallel(_parallelProp.getValueInt()),
     _loadModelAndInput(false)
 {
     setNull();
@@ -191,6 +198,7 @@ setNull()
     _coordinatesFileName = "";
     _speedsFileName = "";
     _lowpassCutoffFrequency = -1.0;
+    _parallel = 0;
 
     _statesStore = NULL;
 
@@ -236,6 +244,15 @@ void AnalyzeTool::setupProperties()
     _lowpassCutoffFrequencyProp.setName("lowpass_cutoff_frequency_for_coordinates");
     _propertySet.append( &_lowpassCutoffFrequencyProp );
 
+    comment = "Perform the analyses in parallel? 0: no, analyze the states in sequence (default); "
+                 "1: use all cores; greater than 1: use this number of threads. Each thread analyzes "
+                 "a block of consecutive states with its own copy of the model. This is only done if "
+                 "all analyses that are on are frame-independent (e.g., BodyKinematics, PointKinematics, "
+                 "MuscleAnalysis, JointReaction, ForceReporter and ProbeReporter) and have a step interval of 1.";
+    _parallelProp.setComment(comment);
+    _parallelProp.setName("parallel");
+    _parallelProp.setValue(0);
+    _propertySet.append( &_parallelProp );
 }
 
 
@@ -259,6 +276,7 @@ operator=(const AnalyzeTool &aTool)
     _coordinatesFileName = aTool._coordinatesFileName;
     _speedsFileName = aTool._speedsFileName;
     _lowpassCutoffFrequency= aTool._lowpassCutoffFrequency;
+    _parallel = aTool._parallel;
     _statesStore = aTool._statesStore;
     _printResultFiles = aTool._printResultFiles;
     return(*this);
@@ -589,8 +607,13 @@ bool AnalyzeTool::run(bool plotting)
     //  _statesStore->getTime(++iInitial,ti);
     //}
 
+    OPENSIM_THROW_IF_FRMOBJ(_parallel < 0, Exception,
+        "Expected parallel to be non-negative, but got {}.", _parallel);
+    const int numThreads =
+            _parallel == 0 ? 1 : (_parallel == 1 ? 0 : _parallel);
+
     log_info("Executing the analyses from {} to {}...", ti, tf);
-    run(s, *_model, iInitial, iFinal, *_statesStore, _solveForEquilibriumForAuxiliaryStates);
+    run(s, *_model, iInitial, iFinal, *_statesStore, _solveForEquilibriumForAuxiliaryStates, numThreads);
     _model->getMultibodySystem().realize(s, SimTK::Stage::Position );
     } catch (const Exception& x) {
         x.print(cout);
@@ -613,26 +636,105 @@ bool AnalyzeTool::run(bool plotting)
 //=============================================================================
 // HELPER
 //=============================================================================
-void AnalyzeTool::run(SimTK::State& s, Model &aModel, int iInitial, int iFinal, const Storage &aStatesStore, bool aSolveForEquilibrium)
+namespace {
+/** Set the state to the states at index i of the states storage. */
+void setStateFromStorage(SimTK::State& s, Model& aModel, int i,
+        const Storage& aStatesStore, const Array<int>& dataToModel,
+        SimTK::Vector& stateData, SimTK::Vector& stateValues,
+        bool aSolveForEquilibrium)
 {
-    AnalysisSet& analysisSet = aModel.updAnalysisSet();
+    const int nsData = dataToModel.getSize();
 
-    for(int i=0;i<analysisSet.getSize();i++) {
-        analysisSet.get(i).setStatesStore(aStatesStore);
+    aStatesStore.getTime(i,s.updTime()); // time
+    double t = s.getTime();
+    aModel.setAllControllersEnabled(true);
+
+    aStatesStore.getData(i,nsData,&stateData[0]); // states
+    // Get data into local Vector and assign to State using common utility
+    // to handle internal (non-OpenSim) states that may exist
+
+    for (int k=0; k < nsData; ++k) {
+        stateValues[dataToModel[k]] = stateData[k];
     }
+    aModel.setStateVariableValues(s, stateValues);
+   
+    // Adjust configuration to match constraints and other goals
+    aModel.assemble(s);
+
+    // equilibrateMuscles before realization as it may affect forces
+    if(aSolveForEquilibrium){
+        try{// might not be able to equilibrate if model is in
+            // a non-physical pose. For example, a pose where the 
+            // muscle length is shorter than the tendon slack-length.
+            // the muscle will throw an Exception in this case.
+            aModel.equilibrateMuscles(s);
+        }
+        catch (const std::exception& e) {
+            log_warn("AnalyzeTool::run() unable to equilibrate muscles at "
+                "time = {}. Reason: {}.", t, e.what());
+        }
+    }
+    // Make sure model is at least ready to provide kinematics
+    aModel.getMultibodySystem().realize(s, SimTK::Stage::Velocity);
+}
 
+/** Perform the analyses of the model at the states with indices iFirst to
+iLast of a run that ends at iFinal. The analyses begin at iFirst. */
+void analyzeStates(SimTK::State& s, Model& aModel, int iFirst, int iLast,
+        int iFinal, const Storage& aStatesStore,
+        const Array<int>& dataToModel, SimTK::Vector stateValues,
+        bool aSolveForEquilibrium)
+{
+    AnalysisSet& analysisSet = aModel.updAnalysisSet();
+    SimTK::Vector stateData(dataToModel.getSize());
+    for(int i=iFirst;i<=iLast;i++) {
+        setStateFromStorage(s, aModel, i, aStatesStore, dataToModel,
+                stateData, stateValues, aSolveForEquilibrium);
 
-    // PERFORM THE ANALYSES
-    double /*tPrev=0.0,*/t=0.0/*,dt=0.0*/;
-    int ny = s.getNY();
-    Array<double> dydt(0.0,ny);
-    Array<double> yFromStorage(0.0,ny);
+        if(i==iFirst) {
+            analysisSet.begin(s);
+        } else if(i==iFinal) {
+            analysisSet.end(s);
+        // Step
+        } else {
+            analysisSet.step(s,i);
+        }
+    }
+}
+
+/** Whether the analyses that are on can be performed on blocks of states
+concurrently; if not, the reason is logged. */
+bool canAnalyzeInParallel(const AnalysisSet& analysisSet)
+{
+    for(int i=0;i<analysisSet.getSize();i++) {
+        const Analysis& analysis = analysisSet.get(i);
+        if(!analysis.getOn()) continue;
+        if(!analysis.isFrameIndependent()) {
+            log_warn("AnalyzeTool: {} ({}) depends on previous states; "
+                     "performing the analyses in sequence.",
+                    analysis.getName(), analysis.getConcreteClassName());
+            return false;
+        }
+        if(analysis.getStepInterval() != 1) {
+            log_warn("AnalyzeTool: {} has a step interval of {}; performing "
+                     "the analyses in sequence.",
+                    analysis.getName(), analysis.getStepInterval());
+            return false;
+        }
+    }
+    return true;
+}
+} // anonymous namespace
 
-    const Array<string>& labels =  aStatesStore.getColumnLabels();
-    int numOpenSimStates = labels.getSize()-1;
+void AnalyzeTool::run(SimTK::State& s, Model &aModel, int iInitial, int iFinal,
+        const Storage &aStatesStore, bool aSolveForEquilibrium,
+        int aNumThreads)
+{
+    AnalysisSet& analysisSet = aModel.updAnalysisSet();
 
-    SimTK::Vector stateData;
-    stateData.resize(numOpenSimStates);
+    for(int i=0;i<analysisSet.getSize();i++) {
+        analysisSet.get(i).setStatesStore(aStatesStore);
+    }
 
     // There is no guarantee that the order in which a model had written out
     // its states will be the same order in which the states will be created,
@@ -663,47 +765,66 @@ void AnalyzeTool::run(SimTK::State& s, Model &aModel, int iInitial, int iFinal,
     // model defaults.
     SimTK::Vector stateValues = aModel.getStateVariableValues(s);
 
-    for(int i=iInitial;i<=iFinal;i++) {
-        // tPrev = t;
-        aStatesStore.getTime(i,s.updTime()); // time
-        t = s.getTime();
-        aModel.setAllControllersEnabled(true);
-
-        aStatesStore.getData(i,numOpenSimStates,&stateData[0]); // states
-        // Get data into local Vector and assign to State using common utility
-        // to handle internal (non-OpenSim) states that may exist
+    // PERFORM THE ANALYSES
+    if(aNumThreads < 1) {
+        aNumThreads = static_cast<int>(std::thread::hardware_concurrency());
+    }
+    const int numStates = iFinal - iInitial + 1;
+    const int numBlocks = std::min(aNumThreads, numStates);
+    if(numBlocks <= 1 || !canAnalyzeInParallel(analysisSet)) {
+        analyzeStates(s, aModel, iInitial, iFinal, iFinal, aStatesStore,
+                dataToModel, stateValues, aSolveForEquilibrium);
+        return;
+    }
 
-        for (int k=0; k < nsData; ++k) {
-            stateValues[dataToModel[k]] = stateData[k];
+    // The first block of states is analyzed with the model itself, and each
+    // other block with its own copy of the model and its analyses. Copy and
+    // initialize the models on this thread; copying a model can read files
+    // (e.g., the data of ExternalLoads).
+    struct Block {
+        int first;
+        int last;
+        std::unique_ptr<Model> model;
+    };
+    std::vector<Block> blocks(numBlocks);
+    for(int b=0;b<numBlocks;b++) {
+        Block& block = blocks[b];
+        block.first = iInitial + (int)((long long)b * numStates / numBlocks);
+        block.last =
+                iInitial + (int)((long long)(b + 1) * numStates / numBlocks) - 1;
+        if(b == 0) continue;
+        block.model.reset(aModel.clone());
+        SimTK::State& state = block.model->initSystem();
+        for (const auto& force : aModel.getComponentList<Force>()) {
+            block.model->getComponent<Force>(force.getAbsolutePath())
+                    .setAppliesForce(state, force.appliesForce(s));
         }
-        aModel.setStateVariableValues(s, stateValues);
-       
-        // Adjust configuration to match constraints and other goals
-        aModel.assemble(s);
-
-        // equilibrateMuscles before realization as it may affect forces
-        if(aSolveForEquilibrium){
-            try{// might not be able to equilibrate if model is in
-                // a non-physical pose. For example, a pose where the 
-                // muscle length is shorter than the tendon slack-length.
-                // the muscle will throw an Exception in this case.
-                aModel.equilibrateMuscles(s);
-            }
-            catch (const std::exception& e) {
-                log_warn("AnalyzeTool::run() unable to equilibrate muscles at "
-                    "time = {}. Reason: {}.", t, e.what());
-            }
+        AnalysisSet& copies = block.model->updAnalysisSet();
+        for(int i=0;i<copies.getSize();i++) {
+            copies.get(i).setStatesStore(aStatesStore);
         }
-        // Make sure model is at least ready to provide kinematics
-        aModel.getMultibodySystem().realize(s, SimTK::Stage::Velocity);
-
-        if(i==iInitial) {
-            analysisSet.begin(s);
-        } else if(i==iFinal) {
-            analysisSet.end(s);
-        // Step
-        } else {
-            analysisSet.step(s,i);
+    }
+    log_info("AnalyzeTool: analyzing {} blocks of states concurrently.",
+            numBlocks);
+
+    parallelFor(numBlocks, [&](int b) {
+        const Block& block = blocks[b];
+        Model& model = b == 0 ? aModel : *block.model;
+        SimTK::State& state = b == 0 ? s : model.updWorkingState();
+        analyzeStates(state, model, block.first, block.last, iFinal,
+                aStatesStore, dataToModel, stateValues, aSolveForEquilibrium);
+    }, numBlocks);
+
+    // Append the results of the copies of the analyses in time order.
+    for(int b=1;b<numBlocks;b++) {
+        AnalysisSet& copies = blocks[b].model->updAnalysisSet();
+        for(int i=0;i<analysisSet.getSize();i++) {
+            analysisSet.get(i).appendResults(copies.get(i));
         }
     }
+
+    // Leave the state at the last states, as when analyzing in sequence.
+    SimTK::Vector stateData(nsData);
+    setStateFromStorage(s, aModel, iFinal, aStatesStore, dataToModel,
+            stateData, stateValues, aSolveForEquilibrium);
 }
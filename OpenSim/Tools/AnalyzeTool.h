@@ -68,6 +68,10 @@ private:
     /** Low-pass cut-off frequency for filtering the coordinates (does not apply to states). */
     PropertyDbl _lowpassCutoffFrequencyProp;
     double &_lowpassCutoffFrequency;
+    /** Analyze blocks of consecutive states in parallel (0: no, 1: use all
+    cores, greater than 1: number of threads). */
+    PropertyInt _parallelProp;
+    int &_parallel;
 
     /** Storage for the model states. */
     Storage *_statesStore;
@@ -119,6 +123,8 @@ public:
     void setSpeedsFileName(const std::string &aFileName) { _speedsFileName = aFileName; }
     double getLowpassCutoffFrequency() const { return _lowpassCutoffFrequency; }
     void setLowpassCutoffFrequency(double aLowpassCutoffFrequency) { _lowpassCutoffFrequency = aLowpassCutoffFrequency; }
+    int getParallel() const { return _parallel; }
+    void setParallel(int aParallel) { _parallel = aParallel; }
     bool getLoadModelAndInput() const { return _loadModelAndInput; }
     void setLoadModelAndInput(bool b) { _loadModelAndInput = b; }
 
@@ -140,7 +146,16 @@ public:
     // HELPER
     //--------------------------------------------------------------------------
 #ifndef SWIG
-    static void run(SimTK::State& s, Model &aModel, int iInitial, int iFinal, const Storage &aStatesStore, bool aSolveForEquilibrium);
+    /** Perform the analyses of aModel at the states with indices iInitial
+    to iFinal of aStatesStore. If aNumThreads is not 1 (less than 1 means
+    the number of hardware threads) and every analysis that is on is
+    frame-independent (Analysis::isFrameIndependent()) with a step interval
+    of 1, blocks of consecutive states are analyzed concurrently, each block
+    but the first with its own copy of aModel and its analyses; the results
+    of the copies are then appended to those of aModel's analyses. */
+    static void run(SimTK::State& s, Model &aModel, int iInitial, int iFinal,
+            const Storage &aStatesStore, bool aSolveForEquilibrium,
+            int aNumThreads=1);
 #endif
 //=============================================================================
 };  // END of class AnalyzeTool
@@ -0,0 +1,281 @@
+/* -------------------------------------------------------------------------- *
+ *                       OpenSim:  BatchToolRunner.cpp                        *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2021 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "BatchToolRunner.h"
+#include "AnalyzeTool.h"
+#include "InverseDynamicsTool.h"
+#include "InverseKinematicsTool.h"
+#include <OpenSim/Common/CommonUtilities.h>
+#include <OpenSim/Common/IO.h>
+#include <OpenSim/Common/Stopwatch.h>
+#include <OpenSim/Simulation/Model/Model.h>
+
+#include <map>
+#include <mutex>
+
+using namespace OpenSim;
+
+namespace {
+
+/// A setup file that has been loaded, and the model it will run on.
+struct Step {
+    std::string setupFile;
+    std::string directory;
+    /// Directory of the external loads file, if the tool has one.
+    std::string externalLoadsDirectory;
+    std::unique_ptr<Object> tool;
+    const Model* model = nullptr;
+    /// Why the step cannot run, if it cannot.
+    std::string error;
+};
+
+std::string getAbsolutePath(
+        const std::string& setupFile, const std::string& fileName) {
+    return convertRelativeFilePathToAbsoluteFromXMLDocument(
+            setupFile, fileName);
+}
+
+/// Construct the concrete tool, as `opensim-cmd run-tool` does, but without
+/// loading its model.
+void loadTool(Step& step, std::string& modelFile) {
+    std::unique_ptr<Object> obj(Object::makeObjectFromFile(step.setupFile));
+    OPENSIM_THROW_IF(obj == nullptr, Exception,
+            "A problem occurred when trying to load file '{}'.",
+            step.setupFile);
+
+    std::string externalLoadsFile;
+    if (dynamic_cast<InverseKinematicsTool*>(obj.get())) {
+        auto* tool = new InverseKinematicsTool(step.setupFile, false);
+        step.tool.reset(tool);
+        modelFile = tool->get_model_file();
+    } else if (dynamic_cast<InverseDynamicsTool*>(obj.get())) {
+        auto* tool = new InverseDynamicsTool(step.setupFile, false);
+        step.tool.reset(tool);
+        modelFile = tool->getModelFileName();
+        externalLoadsFile = tool->getExternalLoadsFileName();
+    } else if (dynamic_cast<AnalyzeTool*>(obj.get())) {
+        auto* tool = new AnalyzeTool(step.setupFile, false);
+        step.tool.reset(tool);
+        modelFile = tool->getModelFilename();
+        externalLoadsFile = tool->getExternalLoadsFileName();
+    } else {
+        OPENSIM_THROW(Exception,
+                "The file '{}' defines a {}, but only InverseKinematicsTool, "
+                "InverseDynamicsTool and AnalyzeTool setup files can be run "
+                "in a batch.",
+                step.setupFile, obj->getConcreteClassName());
+    }
+
+    if (!externalLoadsFile.empty() && externalLoadsFile != "Unassigned") {
+        step.externalLoadsDirectory = IO::getParentDirectory(
+                getAbsolutePath(step.setupFile, externalLoadsFile));
+    }
+}
+
+/// Run the tool of the step on a copy of its model.
+bool runStep(Step& step, std::mutex& cloneMutex) {
+    std::unique_ptr<Model> model;
+    {
+        std::lock_guard<std::mutex> lock(cloneMutex);
+        model.reset(step.model->clone());
+    }
+    // Destroy the tool before the model it refers to.
+    std::unique_ptr<Object> tool(std::move(step.tool));
+
+    if (auto* ik = dynamic_cast<InverseKinematicsTool*>(tool.get())) {
+        ik->setModel(*model);
+        return ik->run();
+    } else if (auto* id = dynamic_cast<InverseDynamicsTool*>(tool.get())) {
+        id->setModel(*model);
+        return id->run();
+    } else if (auto* analyze = dynamic_cast<AnalyzeTool*>(tool.get())) {
+        // As AnalyzeTool(setupFile) does after loading the model.
+        analyze->updateModelForces(*model, step.setupFile);
+        analyze->setModel(*model);
+        analyze->setLoadModelAndInput(true);
+        return analyze->run();
+    }
+    return false;
+}
+
+} // anonymous namespace
+
+BatchToolRunner::BatchToolRunner() = default;
+
+BatchToolRunner::BatchToolRunner(const Model& model) : _model(model.clone()) {}
+
+BatchToolRunner::~BatchToolRunner() = default;
+
+void BatchToolRunner::addTrial(const std::vector<std::string>& setupFiles) {
+    OPENSIM_THROW_IF(setupFiles.empty(), Exception,
+            "Expected a trial to have at least one setup file.");
+    _trials.push_back(setupFiles);
+}
+
+const std::vector<std::string>& BatchToolRunner::getTrial(int index) const {
+    OPENSIM_THROW_IF(index < 0 || index >= getNumTrials(), IndexOutOfRange,
+            index, 0, getNumTrials() - 1);
+    return _trials[index];
+}
+
+void BatchToolRunner::setNumThreads(int numThreads) {
+    OPENSIM_THROW_IF(numThreads < 0, Exception,
+            "Expected the number of threads to be non-negative, but got {}.",
+            numThreads);
+    _numThreads = numThreads;
+}
+
+std::vector<BatchToolRunner::StepResult> BatchToolRunner::run() const {
+    const int numTrials = getNumTrials();
+
+    // Load every setup file, and every distinct model file, once.
+    // ------------------------------------------------------------
+    // This happens on this thread, as parsing the files changes the working
+    // directory.
+    std::vector<std::vector<Step>> trials(numTrials);
+    std::vector<StepResult> results;
+    std::vector<int> firstResult(numTrials);
+    std::map<std::string, std::unique_ptr<Model>> models;
+    for (int itrial = 0; itrial < numTrials; ++itrial) {
+        firstResult[itrial] = (int)results.size();
+        for (const auto& setupFile : _trials[itrial]) {
+            Step step;
+            step.setupFile = SimTK::Pathname::getAbsolutePathname(setupFile);
+            step.directory = IO::getParentDirectory(step.setupFile);
+            StepResult result;
+            result.trial = itrial;
+            result.setupFile = setupFile;
+            try {
+                std::string modelFile;
+                loadTool(step, modelFile);
+                result.toolName = step.tool->getConcreteClassName();
+                if (_model) {
+                    step.model = _model.get();
+                } else {
+                    OPENSIM_THROW_IF(modelFile.empty(), Exception,
+                            "No model file was specified in '{}'.",
+                            setupFile);
+                    modelFile = getAbsolutePath(step.setupFile, modelFile);
+                    auto& model = models[modelFile];
+                    if (!model) {
+                        log_info("BatchToolRunner: loading model {}.",
+                                modelFile);
+                        model.reset(new Model(modelFile));
+                        model->finalizeFromProperties();
+                    }
+                    step.model = model.get();
+                }
+            } catch (const std::exception& ex) {
+                step.error = ex.what();
+            }
+            trials[itrial].push_back(std::move(step));
+            results.push_back(result);
+        }
+    }
+
+    // Group the trials by the directory they run in.
+    // ----------------------------------------------
+    // A trial whose files are in several directories forms its own group.
+    std::vector<std::string> groupDirectories;
+    std::vector<std::vector<int>> groups;
+    std::map<std::string, int> groupIndices;
+    for (int itrial = 0; itrial < numTrials; ++itrial) {
+        const std::string& directory = trials[itrial].front().directory;
+        bool shared = true;
+        for (const auto& step : trials[itrial]) {
+            shared = shared && step.directory == directory &&
+                     (step.externalLoadsDirectory.empty() ||
+                             step.externalLoadsDirectory == directory);
+        }
+        if (shared && groupIndices.count(directory)) {
+            groups[groupIndices[directory]].push_back(itrial);
+            continue;
+        }
+        if (shared) groupIndices[directory] = (int)groups.size();
+        groupDirectories.push_back(directory);
+        groups.push_back({itrial});
+    }
+
+    // Run the trials of each group concurrently.
+    // ------------------------------------------
+    std::mutex cloneMutex;
+    auto runTrial = [&](int itrial) {
+        bool failed = false;
+        for (int istep = 0; istep < (int)trials[itrial].size(); ++istep) {
+            Step& step = trials[itrial][istep];
+            StepResult& result = results[firstResult[itrial] + istep];
+            if (failed) {
+                result.message =
+                        "Skipped because a previous step of the trial failed.";
+                continue;
+            }
+            if (!step.error.empty()) {
+                result.message = step.error;
+                failed = true;
+                continue;
+            }
+            log_info("BatchToolRunner: running {} ({}).", result.setupFile,
+                    result.toolName);
+            Stopwatch watch;
+            try {
+                result.success = runStep(step, cloneMutex);
+                if (!result.success) result.message = "The tool failed.";
+            } catch (const std::exception& ex) {
+                result.message = ex.what();
+            }
+            result.elapsedTime = watch.getElapsedTime();
+            failed = !result.success;
+        }
+        // Release the tools of skipped steps.
+        trials[itrial].clear();
+    };
+    for (int igroup = 0; igroup < (int)groups.size(); ++igroup) {
+        const auto& group = groups[igroup];
+        auto cwd = IO::CwdChanger::changeTo(groupDirectories[igroup]);
+        parallelFor((int)group.size(),
+                [&](int index) { runTrial(group[index]); }, _numThreads);
+    }
+
+    return results;
+}
+
+void BatchToolRunner::printSummary(const std::vector<StepResult>& results) {
+    int numSucceeded = 0;
+    double totalTime = 0;
+    for (const auto& result : results) {
+        if (result.success) ++numSucceeded;
+        totalTime += result.elapsedTime;
+    }
+    log_info("BatchToolRunner: {} of {} setup files succeeded; the tools ran "
+             "for a total of {:.2f} s.",
+            numSucceeded, results.size(), totalTime);
+    for (const auto& result : results) {
+        if (result.success) {
+            log_info("  trial {}: {} ({}) succeeded in {:.2f} s.",
+                    result.trial, result.setupFile, result.toolName,
+                    result.elapsedTime);
+        } else {
+            log_error("  trial {}: {} ({}) failed: {}", result.trial,
+                    result.setupFile, result.toolName, result.message);
+        }
+    }
+}
@@ -0,0 +1,117 @@
+#ifndef OPENSIM_BATCH_TOOL_RUNNER_H_
+#define OPENSIM_BATCH_TOOL_RUNNER_H_
+/* -------------------------------------------------------------------------- *
+ *                        OpenSim:  BatchToolRunner.h                         *
+ * -------------------------------------------------------------------------- *
+ * The OpenSim API is a toolkit for musculoskeletal modeling and simulation.  *
+ * See http://opensim.stanford.edu and the NOTICE file for more information.  *
+ * OpenSim is developed at Stanford University and supported by the US        *
+ * National Institutes of Health (U54 GM072970, R24 HD065690) and by DARPA    *
+ * through the Warrior Web program.                                           *
+ *                                                                            *
+ * Copyright (c) 2005-2021 Stanford University and the Authors                *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "osimToolsDLL.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace OpenSim {
+
+class Model;
+
+/** Run a queue of trials, each a sequence of InverseKinematicsTool,
+InverseDynamicsTool and AnalyzeTool setup files (e.g., IK, then ID, then
+StaticOptimization), in one process. Trials run concurrently; the setup
+files of a trial run in order, each starting after the previous one has
+finished, so a step can read the results of the steps before it. If a step
+fails, the remaining steps of its trial are skipped.
+
+Each distinct model file named by the setup files is loaded only once; every
+step runs on its own copy of that model, so at most getNumThreads() copies
+exist at a time. Alternatively, pass a model to the constructor to use it
+for every step instead of the setup files' model files. Relative model file
+paths are resolved against the directory of the setup file.
+
+The tools resolve relative file paths against the process's working
+directory, which they change to the directory of their setup file while
+they run. Therefore, only trials whose files (setup files and external
+loads files) are all in the same directory run concurrently; directories are
+processed one after another, and trials whose files span several
+directories run on their own.
+
+@code{.cpp}
+BatchToolRunner runner;
+runner.addTrial({"walk1_Setup_IK.xml", "walk1_Setup_ID.xml"});
+runner.addTrial({"walk2_Setup_IK.xml", "walk2_Setup_ID.xml"});
+runner.setNumThreads(4);
+const auto results = runner.run();
+BatchToolRunner::printSummary(results);
+@endcode */
+class OSIMTOOLS_API BatchToolRunner {
+public:
+    /** The outcome of running one setup file.                               */
+    struct StepResult {
+        /** Index of the trial, in the order the trials were added.          */
+        int trial = 0;
+        std::string setupFile;
+        /** Concrete class name of the tool (e.g., InverseKinematicsTool), or
+        empty if the setup file could not be loaded.                          */
+        std::string toolName;
+        bool success = false;
+        /** Error message if the step did not succeed.                       */
+        std::string message;
+        /** Wall-clock time (seconds) spent running the tool, not including
+        the time to load the model file.                                      */
+        double elapsedTime = 0;
+    };
+
+    BatchToolRunner();
+    /** Run every step on a copy of `model` instead of the model file given
+    in its setup file. The model is copied.                                   */
+    explicit BatchToolRunner(const Model& model);
+    ~BatchToolRunner();
+
+    /** Append a trial whose setup files are run in the given order.        */
+    void addTrial(const std::vector<std::string>& setupFiles);
+    /** Append a trial with a single setup file.                             */
+    void addSetupFile(const std::string& setupFile) { addTrial({setupFile}); }
+    int getNumTrials() const { return (int)_trials.size(); }
+    const std::vector<std::string>& getTrial(int index) const;
+    /** Remove all trials from the queue.                                    */
+    void clearTrials() { _trials.clear(); }
+
+    /** The maximum number of trials (and copies of a model) in progress at
+    once. If 0 (default), the number of hardware threads is used.           */
+    void setNumThreads(int numThreads);
+    int getNumThreads() const { return _numThreads; }
+
+    /** Run the trials in the queue, and return one result per setup file,
+    ordered by trial and then by step. This does not throw if a step
+    fails.                                                                    */
+    std::vector<StepResult> run() const;
+
+    /** Log the tool, status and time of each step.                          */
+    static void printSummary(const std::vector<StepResult>& results);
+
+private:
+    std::unique_ptr<Model> _model;
+    std::vector<std::vector<std::string>> _trials;
+    int _numThreads = 0;
+};
+
+} // namespace OpenSim
+
+#endif // OPENSIM_BATCH_TOOL_RUNNER_H_
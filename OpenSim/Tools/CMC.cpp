@@ -31,7 +31,9 @@
 //=============================================================================
 #include "CMC.h"
 #include "VectorFunctionForActuators.h"
+#include <OpenSim/Common/CommonUtilities.h>
 #include <OpenSim/Common/RootSolver.h>
+#include <OpenSim/Common/StorageInterpolator.h>
 #include <OpenSim/Simulation/Control/ControlConstant.h>
 #include <OpenSim/Simulation/Control/ControlLinear.h>
 #include <OpenSim/Tools/CMC_Joint.h>
@@ -155,6 +157,15 @@ void CMC::copyData( const CMC &aCmc )
    _paramList             = aCmc._paramList;
    _verbose               = aCmc._verbose;
    _predictor             = aCmc._predictor;
+   _useParallelPredictor  = aCmc._useParallelPredictor;
+   _initialGuessForces    = aCmc._initialGuessForces;
+   _initialGuessInterpolator = aCmc._initialGuessInterpolator;
+   if(_initialGuessInterpolator) {
+       _initialGuessCursor.reset(
+               new StorageInterpolator::Cursor(*_initialGuessInterpolator));
+   } else {
+       _initialGuessCursor.reset();
+   }
    _f                     = aCmc._f;
    _taskSet               = aCmc._taskSet;
 
@@ -201,8 +212,12 @@ setNull()
     _pErrStore.reset();
     _vErrStore.reset();
     _stressTermWeightStore.reset();
+    _initialGuessForces.reset();
+    _initialGuessInterpolator.reset();
+    _initialGuessCursor.reset();
     _useCurvatureFilter = false;
     _verbose = false;
+    _useParallelPredictor = false;
     _paramList.setSize(0);
     _controlSet.setSize(0);
     setAuthors("Frank Anderson");
@@ -449,6 +464,75 @@ getActuatorForcePredictor()
 {
     return(_predictor);
 }
+//_____________________________________________________________________________
+/**
+ * Set whether the actuator forces at the lower and upper control bounds
+ * are computed concurrently, each on its own copy of the model.
+ */
+void CMC::
+setUseParallelPredictor(bool aTrueFalse)
+{
+    _useParallelPredictor = aTrueFalse;
+}
+//_____________________________________________________________________________
+/**
+ * Get whether the actuator forces at the lower and upper control bounds
+ * are computed concurrently.
+ */
+bool CMC::
+getUseParallelPredictor() const
+{
+    return(_useParallelPredictor);
+}
+//_____________________________________________________________________________
+/**
+ * Set the actuator forces from which the optimizer starts at each time.
+ */
+void CMC::
+setInitialGuessForces(const Storage* aForces)
+{
+    if(aForces) {
+        _initialGuessForces.reset(new Storage(*aForces));
+        _initialGuessInterpolator.reset(
+                new StorageInterpolator(*_initialGuessForces));
+        _initialGuessCursor.reset(
+                new StorageInterpolator::Cursor(*_initialGuessInterpolator));
+    } else {
+        _initialGuessForces.reset();
+        _initialGuessInterpolator.reset();
+        _initialGuessCursor.reset();
+    }
+}
+//_____________________________________________________________________________
+/**
+ * Create the predictor that computes actuator forces on a copy of the model,
+ * with its own actuator system and copies of the desired trajectories (the
+ * splines cache work arrays, so they cannot be shared between threads).
+ */
+void CMC::
+createParallelPredictor()
+{
+    _predictorModel.reset(_model->clone());
+    _predictorModel->updAnalysisSet().clearAndDestroy();
+    SimTK::State& s = _predictorModel->initSystem();
+
+    CMCActuatorSubsystem* actSubsys = _predictor->getCMCActSubsys();
+    _predictorSystem.reset(new CMCActuatorSystem());
+    _predictorSubsystem.reset(
+            new CMCActuatorSubsystem(*_predictorSystem, _predictorModel.get()));
+    _predictorQSet.reset(actSubsys->getCoordinateTrajectories()->clone());
+    _predictorSubsystem->setCoordinateTrajectories(_predictorQSet.get());
+    if(actSubsys->getSpeedTrajectories()) {
+        _predictorUSet.reset(actSubsys->getSpeedTrajectories()->clone());
+        _predictorSubsystem->setSpeedTrajectories(_predictorUSet.get());
+    }
+    _predictorSystem->realizeTopology();
+    _predictorSubsystem->setCompleteState(s);
+
+    _parallelPredictor.reset(new VectorFunctionForActuators(
+            _predictorSystem.get(), _predictorModel.get(),
+            _predictorSubsystem.get()));
+}
 
 //-----------------------------------------------------------------------------
 // ERROR STORAGE
@@ -852,8 +936,45 @@ computeControls(SimTK::State& s, ControlSet &controlSet)
     _predictor->setInitialTime(tiReal);
     _predictor->setFinalTime(tfReal);
     _predictor->setTargetForces(&zero[0]);
-    _predictor->evaluate(s, &xmin[0], &fmin[0]);
-    _predictor->evaluate(s, &xmax[0], &fmax[0]);
+    if(_useParallelPredictor) {
+        if(!_parallelPredictor) createParallelPredictor();
+
+        // The copy of the model integrates the same controls over
+        // [tiReal,tfReal] as this one: the value at tiReal, and the value
+        // that the predictor sets at tfReal.
+        CMC& controller = dynamic_cast<CMC&>(
+                _predictorModel->updControllerSet().get("CMC"));
+        ControlSet& controls = controller.updControlSet();
+        for(i=0;i<controls.getSize();i++) {
+            ControlLinear& control = dynamic_cast<ControlLinear&>(controls[i]);
+            control.clearControlNodes();
+            double x = _controlSet[i].getControlValue(tiReal);
+            if(!SimTK::isNaN(x)) control.setControlValue(tiReal,x);
+        }
+        // Start from the same complete state as _predictor does, as it
+        // would have been used to evaluate the lower bounds in serial.
+        CMCActuatorSubsystem* actSubsys = _parallelPredictor->getCMCActSubsys();
+        actSubsys->setCompleteState(
+                _predictor->getCMCActSubsys()->getCompleteState());
+        actSubsys->setCoordinateCorrections(&qCorrection[0]);
+        actSubsys->setSpeedCorrections(&uCorrection[0]);
+        _parallelPredictor->setInitialTime(tiReal);
+        _parallelPredictor->setFinalTime(tfReal);
+        _parallelPredictor->setTargetForces(&zero[0]);
+
+        // The upper bounds are evaluated with _predictor so that its
+        // complete state, used below, is the same as in the serial case.
+        parallelFor(2, [&](int which) {
+            if(which == 0) {
+                _parallelPredictor->evaluate(s, &xmin[0], &fmin[0]);
+            } else {
+                _predictor->evaluate(s, &xmax[0], &fmax[0]);
+            }
+        }, 2);
+    } else {
+        _predictor->evaluate(s, &xmin[0], &fmin[0]);
+        _predictor->evaluate(s, &xmax[0], &fmax[0]);
+    }
 
     SimTK::State newState = _predictor->getCMCActSubsys()->getCompleteState();
     
@@ -866,6 +987,7 @@ computeControls(SimTK::State& s, ControlSet &controlSet)
 
     // Print actuator force range if range is small
     double range;
+    std::vector<bool> boundsCollapsed(N, false);
     for(i=0;i<N;i++) {
         range = fmax[i] - fmin[i];
         if(range<1.0) {
@@ -882,6 +1004,7 @@ computeControls(SimTK::State& s, ControlSet &controlSet)
             // for force if it uses xmin or:: xmax, but since it uses xmax last
             // it returns xmax as the control value. Make xmax = xmin to avoid that.
             xmax[i] = xmin[i];
+            boundsCollapsed[i] = true;
         }
     }
 
@@ -905,6 +1028,21 @@ computeControls(SimTK::State& s, ControlSet &controlSet)
 
     if(!_target->prepareToOptimize(newState, &_f[0])) {
         // No direct solution, need to run optimizer
+        if(_initialGuessForces) {
+            // Start from the forces at this time in the initial guess,
+            // within the bounds on the forces.
+            StorageInterpolator::Cursor& guess = *_initialGuessCursor;
+            guess.seek(tiReal);
+            for(i=0;i<N;i++) {
+                int index = _initialGuessForces->getStateIndex(
+                        getActuatorSet()[i].getName());
+                if(index<0 ||
+                        index>=_initialGuessInterpolator->getNumColumns())
+                    continue;
+                _f[i] = SimTK::clamp(lowerBounds[i],guess.getValue(index),
+                        upperBounds[i]);
+            }
+        }
         Vector fVector(N,&_f[0],true);
 
         try {
@@ -945,7 +1083,15 @@ computeControls(SimTK::State& s, ControlSet &controlSet)
     Array<double> tol(4.0e-3,N);
     Array<double> fErrors(0.0,N);
     Array<double> controls(0.0,N);
-    controls = rootSolver.solve(s, xmin,xmax,tol);
+    // The forces at the control bounds were computed above, so the root
+    // solver need not integrate the actuators for them again. Where the
+    // upper bound was collapsed onto the lower bound, so is its force.
+    Array<double> fa(0.0,N),fb(0.0,N);
+    for(i=0;i<N;i++) {
+        fa[i] = fmin[i] - _f[i];
+        fb[i] = boundsCollapsed[i] ? fa[i] : fmax[i] - _f[i];
+    }
+    controls = rootSolver.solve(s, xmin,xmax,fa,fb,tol);
     if(_verbose) {
         log_info("CMC::computeControls, root solve (tFinal = {}):", _tf);
         log_info(" -- controls = {}", _tf, controls);
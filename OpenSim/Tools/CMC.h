@@ -32,6 +32,7 @@
 // INCLUDE
 //============================================================================
 #include "osimToolsDLL.h"
+#include <OpenSim/Common/StorageInterpolator.h>
 #include <OpenSim/Simulation/Control/ControlSet.h>
 #include <OpenSim/Simulation/Control/TrackingController.h>
 
@@ -45,6 +46,9 @@ class Model;
 class OptimizationTarget;
 class VectorFunctionForActuators;
 class CMC_TaskSet;
+class CMCActuatorSystem;
+class CMCActuatorSubsystem;
+class FunctionSet;
 
 //=============================================================================
 //=============================================================================
@@ -132,6 +136,27 @@ protected:
     /** Vector function for estimating actuator forces over a specified time
     interval. */
     VectorFunctionForActuators *_predictor;
+    /** Flag indicating whether to compute the actuator forces at the lower
+    and upper control bounds concurrently. */
+    bool _useParallelPredictor;
+    /** Copy of the model, and of the actuator system and trajectories, on
+    which the forces at the lower control bounds are computed while
+    _predictor computes those at the upper bounds. Created when first
+    needed; not copied with the controller. */
+    std::unique_ptr<Model> _predictorModel;
+    std::unique_ptr<FunctionSet> _predictorQSet;
+    std::unique_ptr<FunctionSet> _predictorUSet;
+    std::unique_ptr<CMCActuatorSystem> _predictorSystem;
+    std::unique_ptr<CMCActuatorSubsystem> _predictorSubsystem;
+    std::unique_ptr<VectorFunctionForActuators> _parallelPredictor;
+    /** Actuator forces from which the optimizer starts at each time, if
+    set. */
+    std::shared_ptr<Storage> _initialGuessForces;
+    /** Interpolator of _initialGuessForces, built once when it is set. */
+    std::shared_ptr<StorageInterpolator> _initialGuessInterpolator;
+    /** Cursor of _initialGuessInterpolator at the last time the optimizer
+    started from the initial guess; each copy of CMC has its own. */
+    std::unique_ptr<StorageInterpolator::Cursor> _initialGuessCursor;
     /** Array of actuator forces for achieving the desired accelerations. */
     Array<double> _f;
 
@@ -173,6 +198,18 @@ public:
     bool getCheckTargetTime() const;
     void setActuatorForcePredictor(VectorFunctionForActuators *aPredictor);
     VectorFunctionForActuators* getActuatorForcePredictor();
+    /** Compute the actuator forces at the lower and upper control bounds
+    concurrently, the former with a predictor on a copy of the model. This
+    uses two threads and the memory of a second model. Default: false. */
+    void setUseParallelPredictor(bool aTrueFalse);
+    bool getUseParallelPredictor() const;
+    /** Start the optimizer at each time from the actuator forces at that
+    time in aForces (e.g., the forces of the Actuation analysis of a
+    previous run), instead of from the forces found at the previous time.
+    Columns are matched to actuators by name; actuators without a column
+    start from the previous time as before. The storage is copied. Pass
+    nullptr to go back to the default. */
+    void setInitialGuessForces(const Storage* aForces);
     Storage* getPositionErrorStorage() const;
     Storage* getVelocityErrorStorage() const;
     Storage* getStressTermWeightStorage() const;
@@ -221,6 +258,9 @@ public:
      // for adding any components to the underlying system
      void extendAddToSystem( SimTK::MultibodySystem& system) const override; 
 
+ private:
+     void createParallelPredictor();
+
 //=============================================================================
 };  // END of class CMC
 //=============================================================================
@@ -70,6 +70,7 @@ CMCTool::CMCTool() :
     _targetDT(_targetDTProp.getValueDbl()),          
     //_useCurvatureFilter(_useCurvatureFilterProp.getValueBool()),
     _useFastTarget(_useFastTargetProp.getValueBool()),
+    _useParallelPredictor(_useParallelPredictorProp.getValueBool()),
     _optimizerAlgorithm(_optimizerAlgorithmProp.getValueStr()),
     _numericalDerivativeStepSize(_numericalDerivativeStepSizeProp.getValueDbl()),
     _optimizationConvergenceTolerance(_optimizationConvergenceToleranceProp.getValueDbl()),
@@ -100,6 +101,7 @@ CMCTool::CMCTool(const string &aFileName, bool aLoadModel) :
     _targetDT(_targetDTProp.getValueDbl()),          
     //_useCurvatureFilter(_useCurvatureFilterProp.getValueBool()),
     _useFastTarget(_useFastTargetProp.getValueBool()),
+    _useParallelPredictor(_useParallelPredictorProp.getValueBool()),
     _optimizerAlgorithm(_optimizerAlgorithmProp.getValueStr()),
     _numericalDerivativeStepSize(_numericalDerivativeStepSizeProp.getValueDbl()),
     _optimizationConvergenceTolerance(_optimizationConvergenceToleranceProp.getValueDbl()),
@@ -170,6 +172,7 @@ CMCTool(const CMCTool &aTool) :
     _targetDT(_targetDTProp.getValueDbl()),          
     //_useCurvatureFilter(_useCurvatureFilterProp.getValueBool()),
     _useFastTarget(_useFastTargetProp.getValueBool()),
+    _useParallelPredictor(_useParallelPredictorProp.getValueBool()),
     _optimizerAlgorithm(_optimizerAlgorithmProp.getValueStr()),
     _numericalDerivativeStepSize(_numericalDerivativeStepSizeProp.getValueDbl()),
     _optimizationConvergenceTolerance(_optimizationConvergenceToleranceProp.getValueDbl()),
@@ -202,6 +205,7 @@ setNull()
     _targetDT = 0.010;           
     //_useCurvatureFilter = false;       
     _useFastTarget = true;
+    _useParallelPredictor = false;
     _optimizerAlgorithm = "ipopt";
     _numericalDerivativeStepSize = 1.0e-4;
     _optimizationConvergenceTolerance = 1.0e-4;
@@ -294,6 +298,14 @@ void CMCTool::setupProperties()
     _useFastTargetProp.setName("use_fast_optimization_target");          
     _propertySet.append( &_useFastTargetProp );
 
+    comment = "Flag (true or false) indicating whether to compute the actuator "
+              "forces at the lower and upper control bounds concurrently, "
+              "using a copy of the model. This uses a second thread and the "
+              "memory of a second model.";
+    _useParallelPredictorProp.setComment(comment);
+    _useParallelPredictorProp.setName("use_parallel_predictor");
+    _propertySet.append( &_useParallelPredictorProp );
+
     comment = "Preferred optimizer algorithm (currently support \"ipopt\" or \"cfsqp\", "
                  "the latter requiring the osimCFSQP library.";
     _optimizerAlgorithmProp.setComment(comment);
@@ -361,6 +373,7 @@ operator=(const CMCTool &aTool)
     _numericalDerivativeStepSize = aTool._numericalDerivativeStepSize;
     _optimizationConvergenceTolerance = aTool._optimizationConvergenceTolerance;
     _useFastTarget = aTool._useFastTarget;
+    _useParallelPredictor = aTool._useParallelPredictor;
     _optimizerAlgorithm = aTool._optimizerAlgorithm;
     _maxIterations = aTool._maxIterations;
     _printLevel = aTool._printLevel;
@@ -736,6 +749,7 @@ bool CMCTool::run()
         log_info("Setting cmc controller to not use verbose printing.\n");
     }
     controller->setUseVerbosePrinting(_verbose);
+    controller->setUseParallelPredictor(_useParallelPredictor);
 
     controller->setCheckTargetTime(true);
 
@@ -103,6 +103,11 @@ private:
     PropertyBool _useFastTargetProp;         
     bool &_useFastTarget;
 
+    /** Flag indicating whether to compute the actuator forces at the lower
+    and upper control bounds concurrently, using a copy of the model. */
+    PropertyBool _useParallelPredictorProp;
+    bool &_useParallelPredictor;
+
     /** Preferred optimizer algorithm. */
     PropertyStr _optimizerAlgorithmProp;
     std::string &_optimizerAlgorithm;
@@ -192,6 +197,12 @@ public:
     bool getUseFastTarget() const { return _useFastTarget;};         
     void setUseFastTarget(bool useFastTarget) const {  _useFastTarget=useFastTarget; };
 
+    // Concurrent evaluation of the actuator force predictor
+    bool getUseParallelPredictor() const { return _useParallelPredictor; }
+    void setUseParallelPredictor(bool useParallelPredictor) {
+        _useParallelPredictor = useParallelPredictor;
+    }
+
     // Verbosity
     bool getUseVerbosePrinting() const {return _verbose;};
     void setUseVerbosePrinting(bool verbose) const { _verbose=verbose;};
@@ -25,6 +25,7 @@
 //=============================================================================
 #include <OpenSim/Common/Array.h>
 #include <OpenSim/Common/Storage.h>
+#include <OpenSim/Common/StorageInterpolator.h>
 #include <OpenSim/Simulation/Model/Model.h>
 #include <OpenSim/Actuators/CoordinateActuator.h>
 #include "CorrectionController.h"
@@ -144,6 +145,9 @@ copyData(const CorrectionController &aController)
     // Copy this class's members.
     _kp = aController._kp;
     _kv = aController._kv;
+    // The interpolator is rebuilt from the desired states when needed.
+    _yDesInterpolator.reset();
+    _yDesCursor.reset();
 }
 
 
@@ -196,6 +200,22 @@ void CorrectionController::setKv(double aKv)
 {
     _kv = aKv;
 }
+//-----------------------------------------------------------------------------
+// DESIRED STATES
+//-----------------------------------------------------------------------------
+//_____________________________________________________________________________
+/**
+ * Set the desired states, discarding the interpolator of the previous ones.
+ *
+ * @param aYDesStore Desired states of the model.
+ */
+void CorrectionController::
+setDesiredStatesStorage(const Storage* aYDesStore)
+{
+    TrackingController::setDesiredStatesStorage(aYDesStore);
+    _yDesInterpolator.reset();
+    _yDesCursor.reset();
+}
 
 
 //=============================================================================
@@ -218,8 +238,15 @@ void CorrectionController::computeControls(const SimTK::State& s, SimTK::Vector&
     // GET CURRENT DESIRED COORDINATES AND SPEEDS
     // Note: yDesired[0..nq-1] will contain the generalized coordinates
     // and yDesired[nq..nq+nu-1] will contain the generalized speeds.
+    const Storage& yDesStore = getDesiredStatesStorage();
+    if(!_yDesInterpolator) {
+        _yDesInterpolator.reset(new StorageInterpolator(yDesStore));
+        _yDesCursor.reset(new StorageInterpolator::Cursor(*_yDesInterpolator));
+    }
+    StorageInterpolator::Cursor& cursor = *_yDesCursor;
+    cursor.seek(t);
     Array<double> yDesired(0.0,nq+nu);
-    getDesiredStatesStorage().getDataAtTime(t, nq+nu,yDesired);
+    cursor.getValues(nq+nu, &yDesired[0]);
     
     SimTK::Vector actControls(1, 0.0);
 
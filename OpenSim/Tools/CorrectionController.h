@@ -28,6 +28,7 @@
 // INCLUDE
 //============================================================================
 #include "osimToolsDLL.h"
+#include <OpenSim/Common/StorageInterpolator.h>
 #include <OpenSim/Simulation/Control/TrackingController.h>
 
 
@@ -63,6 +64,14 @@ protected:
     /** States for the simulation. */
     Storage *_yDesStore;
 
+    /** Interpolator of the desired states storage, built the first time
+     *  controls are computed from it and discarded when the storage is
+     *  set. Changes to that storage in between are not seen. */
+    mutable std::shared_ptr<StorageInterpolator> _yDesInterpolator;
+    /** Cursor of _yDesInterpolator at the last time controls were
+     *  computed; built with the interpolator. */
+    mutable std::unique_ptr<StorageInterpolator::Cursor> _yDesCursor;
+
 
 //=============================================================================
 // METHODS
@@ -115,6 +124,7 @@ public:
     void setKp(double aKp);
     double getKv() const;
     void setKv(double aKv);
+    void setDesiredStatesStorage(const Storage* aYDesStore) override;
 
     //--------------------------------------------------------------------------
     // COMPUTATION
@@ -11,12 +11,120 @@
 #include <OpenSim/Simulation/Model/PhysicalOffsetFrame.h>
 #include <OpenSim/Simulation/InverseKinematicsSolver.h>
 #include <OpenSim/Simulation/OrientationsReference.h>
-
+#include <OpenSim/Simulation/BufferedOrientationsReference.h>
+#include <OpenSim/Common/Stopwatch.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdlib>
+#include <istream>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <sstream>
+#include <thread>
 
 using namespace OpenSim;
 using namespace SimTK;
 using namespace std;
 
+namespace {
+// Read the next line of the source. At the end of the source, wait for more
+// text to be appended until none has arrived for idleTimeout seconds; return
+// false if there was no line by then, or if `stop` is set while waiting.
+bool readLine(std::istream& source, std::string& line, double idleTimeout,
+        const std::atomic<bool>* stop = nullptr) {
+    using Clock = std::chrono::steady_clock;
+    line.clear();
+    auto lastRead = Clock::now();
+    std::string chunk;
+    while (true) {
+        std::getline(source, chunk);
+        if (!source.eof()) {
+            if (source.fail()) return false;
+            line += chunk;
+            break;
+        }
+        // The end was reached, possibly in the middle of a line.
+        if (!chunk.empty()) {
+            line += chunk;
+            lastRead = Clock::now();
+        }
+        if (stop && *stop) return false;
+        if (std::chrono::duration<double>(Clock::now() - lastRead).count() >=
+                idleTimeout) {
+            if (line.empty()) return false;
+            break;
+        }
+        source.clear();
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    if (!line.empty() && line.back() == '\r') line.pop_back();
+    return true;
+}
+
+// State shared between runInverseKinematicsWithOrientationsFromStream() and
+// the thread that reads the source. It is held by both so that the reader can
+// outlive the call if it is detached.
+struct StreamReaderState {
+    std::atomic<bool> done{false};
+    std::atomic<bool> stop{false};
+    std::exception_ptr exception;
+    // Notified when the reader puts a row in the queue or finishes.
+    std::mutex mutex;
+    std::condition_variable changed;
+    void notify() {
+        { std::lock_guard<std::mutex> lock(mutex); }
+        changed.notify_one();
+    }
+};
+
+std::vector<std::string> splitAtTabs(const std::string& line) {
+    std::vector<std::string> tokens;
+    std::istringstream stream(line);
+    std::string token;
+    while (std::getline(stream, token, '\t')) tokens.push_back(token);
+    return tokens;
+}
+
+// Parse a row of an orientations file: the time, then a quaternion
+// (w,x,y,z) per sensor. The quaternions are rotated into the OpenSim frame.
+void parseOrientationsRow(const std::string& line, int numSensors,
+        const Rotation& sensorToOpenSim, double& time,
+        RowVector_<Rotation>& row) {
+    const auto tokens = splitAtTabs(line);
+    OPENSIM_THROW_IF((int)tokens.size() != numSensors + 1, Exception,
+            "Expected a time and {} orientations in row '{}', but got {} "
+            "values.", numSensors, line, tokens.size());
+    char* end;
+    time = std::strtod(tokens[0].c_str(), &end);
+    OPENSIM_THROW_IF(end == tokens[0].c_str(), Exception,
+            "Expected a time at the start of row '{}'.", line);
+    row.resize(numSensors);
+    for (int i = 0; i < numSensors; ++i) {
+        const char* text = tokens[i + 1].c_str();
+        Vec4 q;
+        for (int k = 0; k < 4; ++k) {
+            q[k] = std::strtod(text, &end);
+            OPENSIM_THROW_IF(end == text, Exception,
+                    "Expected a quaternion 'w,x,y,z' for '{}' in row '{}'.",
+                    tokens[i + 1], line);
+            text = end;
+            if (k < 3) {
+                OPENSIM_THROW_IF(*text != ',', Exception,
+                        "Expected a quaternion 'w,x,y,z' for '{}' in row "
+                        "'{}'.", tokens[i + 1], line);
+                ++text;
+            }
+        }
+        row[i] = sensorToOpenSim * Rotation(Quaternion(q));
+    }
+}
+} // anonymous namespace
+
 
 IMUInverseKinematicsTool::IMUInverseKinematicsTool()
         : InverseKinematicsToolBase() {
@@ -255,6 +363,209 @@ void IMUInverseKinematicsTool::runInverseKinematicsWithOrientationsFromFile(
     ikReporter->clearTable();
 }
 
+int IMUInverseKinematicsTool::runInverseKinematicsWithOrientationsFromStream(
+        Model& model, std::shared_ptr<std::istream> sourcePtr,
+        const StreamingFrameFunction& frameFunction, int maxQueueDepth,
+        double idleTimeout) {
+    OPENSIM_THROW_IF_FRMOBJ(!sourcePtr, Exception,
+            "Expected a source of orientations, but got none.");
+    OPENSIM_THROW_IF_FRMOBJ(maxQueueDepth < 0, Exception,
+            "Expected maxQueueDepth to be non-negative, but got {}.",
+            maxQueueDepth);
+    std::istream& source = *sourcePtr;
+
+    // Read the header and the first row in the time range.
+    std::string line;
+    bool foundEndHeader = false;
+    while (!foundEndHeader && readLine(source, line, idleTimeout)) {
+        foundEndHeader = line.find("endheader") != std::string::npos;
+    }
+    OPENSIM_THROW_IF_FRMOBJ(!foundEndHeader, Exception,
+            "Expected the source to start with the header of an "
+            "orientations file, ending in 'endheader'.");
+    OPENSIM_THROW_IF_FRMOBJ(!readLine(source, line, idleTimeout), Exception,
+            "Expected the column labels of the orientations.");
+    auto labels = splitAtTabs(line);
+    OPENSIM_THROW_IF_FRMOBJ(labels.size() < 2, Exception,
+            "Expected the column labels 'time' and the sensor names, but got "
+            "'{}'.", line);
+    labels.erase(labels.begin());
+    const int numSensors = (int)labels.size();
+
+    const SimTK::Vec3& rotations = get_sensor_to_opensim_rotations();
+    const Rotation sensorToOpenSim(
+            SimTK::BodyOrSpaceType::SpaceRotationSequence,
+            rotations[0], SimTK::XAxis, rotations[1], SimTK::YAxis,
+            rotations[2], SimTK::ZAxis);
+
+    double time = SimTK::NaN;
+    RowVector_<Rotation> row;
+    do {
+        OPENSIM_THROW_IF_FRMOBJ(!readLine(source, line, idleTimeout),
+                Exception, "The source has no orientations in the time "
+                "range [{}, {}].", getStartTime(), getEndTime());
+        if (line.empty()) continue;
+        parseOrientationsRow(line, numSensors, sensorToOpenSim, time, row);
+        OPENSIM_THROW_IF_FRMOBJ(time > getEndTime(), Exception,
+                "The source has no orientations in the time range [{}, {}].",
+                getStartTime(), getEndTime());
+    } while (line.empty() || time < getStartTime());
+
+    SimTK::Matrix_<Rotation> firstRowData(1, numSensors);
+    firstRowData.updRow(0) = row;
+    TimeSeriesTable_<Rotation> firstRow(
+            std::vector<double>{time}, firstRowData, labels);
+    auto oRefs = std::make_shared<BufferedOrientationsReference>(
+            firstRow, &get_orientation_weights());
+    // Rows that are waiting to be solved are held in a lock-free queue.
+    oRefs->setQueueCapacity(std::max(1024, 2 * maxQueueDepth));
+
+    // Lock translational coordinates, as for a file.
+    for (auto& coord : model.updComponentList<Coordinate>()) {
+        if (coord.getMotionType() == Coordinate::Translational) {
+            coord.setDefaultLocked(true);
+        }
+    }
+    SimTK::State& s0 = model.initSystem();
+
+    const double accuracy = 1e-4;
+    SimTK::Array_<CoordinateReference> coordinateReferences;
+    InverseKinematicsSolver ikSolver(
+            model, nullptr, oRefs, coordinateReferences);
+    ikSolver.setAccuracy(accuracy);
+
+    StreamingFrame frame;
+    Stopwatch watch;
+    s0.updTime() = time;
+    ikSolver.assemble(s0);
+    frame.time = time;
+    frame.solveTime = watch.getElapsedTime();
+    frame.queueDepth = 1;
+
+    // Read the remaining rows on another thread. The reader owns a reference
+    // to the source, so the source outlives the reader even if the reader is
+    // detached below.
+    auto readerState = std::make_shared<StreamReaderState>();
+    const double endTime = getEndTime();
+    std::thread reader([readerState, oRefs, sourcePtr, numSensors,
+                               sensorToOpenSim, endTime, time, idleTimeout]() {
+        try {
+            std::string nextLine;
+            double rowTime;
+            RowVector_<Rotation> nextRow(numSensors);
+            while (!readerState->stop && readLine(*sourcePtr, nextLine,
+                                                 idleTimeout,
+                                                 &readerState->stop)) {
+                if (nextLine.empty() || readerState->stop) continue;
+                parseOrientationsRow(nextLine, numSensors, sensorToOpenSim,
+                        rowTime, nextRow);
+                if (rowTime > endTime) break;
+                if (rowTime <= time) continue;
+                oRefs->putValues(rowTime, nextRow);
+                readerState->notify();
+            }
+        } catch (...) {
+            readerState->exception = std::current_exception();
+        }
+        readerState->done = true;
+        readerState->notify();
+    });
+
+    ikSolver.setAdvanceTimeFromReference(true);
+    try {
+        if (frameFunction) frameFunction(s0, frame);
+        while (true) {
+            {
+                // Sleep until the reader puts a row in the queue or
+                // finishes; the timeout only guards against a missed
+                // notification.
+                std::unique_lock<std::mutex> lock(readerState->mutex);
+                readerState->changed.wait_for(lock,
+                        std::chrono::milliseconds(10), [&]() {
+                            return readerState->done ||
+                                   oRefs->getNumPendingValues() > 0;
+                        });
+            }
+            const bool done = readerState->done;
+            const int depth = oRefs->getNumPendingValues();
+            if (depth == 0) {
+                if (done) break;
+                continue;
+            }
+            frame.queueDepth = depth;
+            if (maxQueueDepth > 0 && depth > maxQueueDepth) {
+                frame.numDropped += oRefs->discardPendingValues(maxQueueDepth);
+            }
+            watch.reset();
+            ikSolver.track(s0); // takes the next row and advances time
+            frame.solveTime = watch.getElapsedTime();
+            ++frame.index;
+            frame.time = s0.getTime();
+            if (frameFunction) frameFunction(s0, frame);
+        }
+    } catch (...) {
+        // Stop the reader. Empty the queue so that the reader is not left
+        // waiting for room, and give it a moment to notice. A reader that is
+        // blocked reading the source (e.g., an idle pipe) cannot be
+        // interrupted; it is detached and exits once the source delivers a
+        // line or ends. It shares ownership of the source and of the queue,
+        // so neither is destroyed before it exits.
+        readerState->stop = true;
+        const auto deadline =
+                std::chrono::steady_clock::now() + std::chrono::seconds(1);
+        while (!readerState->done &&
+                std::chrono::steady_clock::now() < deadline) {
+            oRefs->discardPendingValues(0);
+            std::unique_lock<std::mutex> lock(readerState->mutex);
+            readerState->changed.wait_for(
+                    lock, std::chrono::milliseconds(10));
+        }
+        if (readerState->done) reader.join();
+        else reader.detach();
+        throw;
+    }
+    reader.join();
+    if (readerState->exception)
+        std::rethrow_exception(readerState->exception);
+
+    log_info("IMUInverseKinematicsTool: solved {} frames from the stream; "
+             "dropped {} rows.", frame.index + 1, frame.numDropped);
+    return frame.index + 1;
+}
+
+void IMUInverseKinematicsTool::writeOrientationsToStream(
+        const TimeSeriesTable_<SimTK::Quaternion>& orientations,
+        std::ostream& sink, bool realTime) {
+    using Clock = std::chrono::steady_clock;
+    sink << "DataType=Quaternion\nversion=3\nendheader\ntime";
+    for (const auto& label : orientations.getColumnLabels()) {
+        sink << "\t" << label;
+    }
+    sink << std::endl;
+
+    const auto& times = orientations.getIndependentColumn();
+    const auto start = Clock::now();
+    const auto precision = sink.precision(
+            std::numeric_limits<double>::max_digits10);
+    for (size_t i = 0; i < times.size(); ++i) {
+        if (realTime) {
+            std::this_thread::sleep_until(start +
+                    std::chrono::duration_cast<Clock::duration>(
+                            std::chrono::duration<double>(
+                                    times[i] - times.front())));
+        }
+        sink << times[i];
+        const auto row = orientations.getRowAtIndex(i);
+        for (int j = 0; j < row.size(); ++j) {
+            const SimTK::Quaternion& q = row[j];
+            sink << "\t" << q[0] << "," << q[1] << "," << q[2] << ","
+                 << q[3];
+        }
+        // Flush so that a reader sees each row as soon as it is written.
+        sink << std::endl;
+    }
+    sink.precision(precision);
+}
 
 // main driver
 bool IMUInverseKinematicsTool::run(bool visualizeResults)
@@ -44,6 +44,10 @@
 #include <OpenSim/Simulation/OrientationsReference.h>
 #include <OpenSim/Tools/InverseKinematicsToolBase.h>
 
+#include <functional>
+#include <iosfwd>
+#include <memory>
+
 namespace OpenSim {
 
 class Model;
@@ -112,6 +116,66 @@ public:
     void runInverseKinematicsWithOrientationsFromFile(Model& model,
                             const std::string& quaternionStoFileName, bool visualizeResults=false);
 
+#ifndef SWIG
+    /** Statistics of a frame solved by
+        runInverseKinematicsWithOrientationsFromStream(). */
+    struct StreamingFrame {
+        /** Index of the frame among the frames solved.                   */
+        int index = 0;
+        double time = SimTK::NaN;
+        /** Wall-clock time (seconds) spent solving the frame.            */
+        double solveTime = 0;
+        /** Number of rows waiting to be solved when the solver took the
+            frame, including the frame.                                   */
+        int queueDepth = 0;
+        /** Total number of rows dropped so far because the solver fell
+            behind.                                                       */
+        int numDropped = 0;
+    };
+    /** Called with the state of the model (posed at the frame) after each
+        frame is solved.                                                  */
+    typedef std::function<void(const SimTK::State& s,
+            const StreamingFrame& frame)> StreamingFrameFunction;
+
+    /** Solve for the orientations of the IMUs as they arrive from `source`
+        (e.g., a named pipe or a file that is still being written), and call
+        `frameFunction` with each solution. The source is the text of an
+        orientations (.sto) file of quaternions, as written by
+        writeOrientationsToStream(): a header ending in "endheader", the
+        column labels, and then a row per line. The rows are read on another
+        thread and handed to the InverseKinematicsSolver through a lock-free
+        BufferedOrientationsReference. If, when the solver is ready for the
+        next frame, more than `maxQueueDepth` rows are waiting, the oldest are
+        dropped so that the solver catches up with the newest, bounding the
+        latency; if `maxQueueDepth` is 0, no rows are dropped.
+        When the end of the source is reached, more rows are waited for up to
+        `idleTimeout` seconds (to follow a file that is being written); then
+        the remaining rows are solved and the number of frames solved is
+        returned. Only rows within the time range of the tool are solved,
+        with sensor_to_opensim_rotations and orientation_weights applied as
+        for a file.
+        The reader thread starts before `frameFunction` is called for the
+        first frame. If solving a frame (or `frameFunction`) throws, the
+        reader is stopped before the exception is rethrown. A reader that is
+        blocked inside a read of `source` (e.g., an idle pipe) cannot be
+        interrupted: it is detached instead, and exits once `source` delivers
+        a line or ends. The reader shares ownership of `source`, so the
+        stream stays valid until then. */
+    int runInverseKinematicsWithOrientationsFromStream(Model& model,
+            std::shared_ptr<std::istream> source,
+            const StreamingFrameFunction& frameFunction,
+            int maxQueueDepth = 1, double idleTimeout = 0);
+
+    /** Write orientations to `sink` in the format read by
+        runInverseKinematicsWithOrientationsFromStream(), flushing after each
+        row. If `realTime` is true, each row is written at its time relative
+        to the first row, in wall-clock time, to replay a recording (e.g.,
+        read by XsensDataReader or APDMDataReader) as if it were live. */
+    static void writeOrientationsToStream(
+            const TimeSeriesTable_<SimTK::Quaternion>& orientations,
+            std::ostream& sink, bool realTime = true);
+#endif
+
 private:
     void constructProperties();
 
@@ -63,7 +63,8 @@ InverseDynamicsTool::InverseDynamicsTool() : DynamicsTool(),
     _lowpassCutoffFrequency(_lowpassCutoffFrequencyProp.getValueDbl()),
     _outputGenForceFileName(_outputGenForceFileNameProp.getValueStr()),
     _jointsForReportingBodyForces(_jointsForReportingBodyForcesProp.getValueStrArray()),
-    _outputBodyForcesAtJointsFileName(_outputBodyForcesAtJointsFileNameProp.getValueStr())
+    _outputBodyForcesAtJointsFileName(_outputBodyForcesAtJointsFileNameProp.getValueStr()),
+    _parallel(_parallelProp.getValueInt())
 {
     setNull();
 }
@@ -82,7 +83,8 @@ InverseDynamicsTool::InverseDynamicsTool(const string &aFileName, bool aLoadMode
     _lowpassCutoffFrequency(_lowpassCutoffFrequencyProp.getValueDbl()),
     _outputGenForceFileName(_outputGenForceFileNameProp.getValueStr()),
     _jointsForReportingBodyForces(_jointsForReportingBodyForcesProp.getValueStrArray()),
-    _outputBodyForcesAtJointsFileName(_outputBodyForcesAtJointsFileNameProp.getValueStr())
+    _outputBodyForcesAtJointsFileName(_outputBodyForcesAtJointsFileNameProp.getValueStr()),
+    _parallel(_parallelProp.getValueInt())
 {
     setNull();
     updateFromXMLDocument();
@@ -104,7 +106,8 @@ InverseDynamicsTool::InverseDynamicsTool(const InverseDynamicsTool &aTool) :
     _lowpassCutoffFrequency(_lowpassCutoffFrequencyProp.getValueDbl()),
     _outputGenForceFileName(_outputGenForceFileNameProp.getValueStr()),
     _jointsForReportingBodyForces(_jointsForReportingBodyForcesProp.getValueStrArray()),
-    _outputBodyForcesAtJointsFileName(_outputBodyForcesAtJointsFileNameProp.getValueStr())
+    _outputBodyForcesAtJointsFileName(_outputBodyForcesAtJointsFileNameProp.getValueStr()),
+    _parallel(_parallelProp.getValueInt())
 {
     setNull();
     *this = aTool;
@@ -151,6 +154,14 @@ void InverseDynamicsTool::setupProperties()
     _outputBodyForcesAtJointsFileNameProp.setName("output_body_forces_file");
     _outputBodyForcesAtJointsFileNameProp.setValue("body_forces_at_joints.sto");
     _propertySet.append(&_outputBodyForcesAtJointsFileNameProp);
+
+    _parallelProp.setComment("Solve the time frames in parallel? "
+        "0: no, solve the frames in sequence (default); 1: use all cores; "
+        "greater than 1: use this number of threads. Each thread solves a "
+        "block of consecutive frames with its own copy of the model.");
+    _parallelProp.setName("parallel");
+    _parallelProp.setValue(0);
+    _propertySet.append(&_parallelProp);
 }
 
 //_____________________________________________________________________________
@@ -182,6 +193,7 @@ operator=(const InverseDynamicsTool &aTool)
     _lowpassCutoffFrequency = aTool._lowpassCutoffFrequency;
     _outputGenForceFileName = aTool._outputGenForceFileName;
     _outputBodyForcesAtJointsFileName = aTool._outputBodyForcesAtJointsFileName;
+    _parallel = aTool._parallel;
     _coordinateValues = NULL;
 
     return(*this);
@@ -250,6 +262,9 @@ bool InverseDynamicsTool::run()
         else
             modelFromFile = false;
 
+        OPENSIM_THROW_IF_FRMOBJ(_parallel < 0, Exception,
+            "Expected parallel to be non-negative, but got {}.", _parallel);
+
         _model->finalizeFromProperties();
         _model->printBasicInfo();
 
@@ -411,21 +426,54 @@ bool InverseDynamicsTool::run()
             times[i]=_coordinateValues->getStateVector(start_index+i)->getTime();
         }
 
+        JointSet jointsForEquivalentBodyForces;
+        getJointsByName(*_model, _jointsForReportingBodyForces, jointsForEquivalentBodyForces);
+        int nj = jointsForEquivalentBodyForces.getSize();
+        // Paths of the joints, to find them in the copies of the model that
+        // solve the frames in parallel.
+        std::vector<ComponentPath> jointPaths;
+        for (int j = 0; j < nj; ++j) {
+            jointPaths.push_back(
+                    jointsForEquivalentBodyForces[j].getAbsolutePath());
+        }
+
         // Preallocate results
         Array_<Vector> genForceTraj(nt, Vector(nCoords, 0.0));
+        Array_<Vector> bodyForcesTraj(nj > 0 ? nt : 0, Vector(6*nj, 0.0));
+
+        // if there are joints requested for equivalent body forces then
+        // calculate them for each frame, while the state holds the frame
+        InverseDynamicsSolver::FrameFunction calcBodyForces;
+        if (nj > 0) {
+            calcBodyForces = [&](const Model& model, const SimTK::State& state,
+                    int frame) {
+                Vector& forces = bodyForcesTraj[frame];
+                for (int j = 0; j < nj; ++j) {
+                    const SpatialVec equivalentBodyForceAtJoint =
+                            model.getComponent<Joint>(jointPaths[j])
+                                    .calcEquivalentSpatialForce(
+                                            state, genForceTraj[frame]);
+                    for (int k = 0; k < 3; ++k) {
+                        // body force components
+                        forces[6*j+k] = equivalentBodyForceAtJoint[1][k];
+                        // body torque components
+                        forces[6*j+k+3] = equivalentBodyForceAtJoint[0][k];
+                    }
+                }
+            };
+        }
 
         // solve for the trajectory of generalized forces that correspond to the 
         // coordinate trajectories provided
-        ivdSolver.solve(s, coordFunctions, coordinatesToSpeedsIndexMap, times,
-                genForceTraj);
+        const int numThreads =
+                _parallel == 0 ? 1 : (_parallel == 1 ? 0 : _parallel);
+        ivdSolver.solveInParallel(s, coordFunctions,
+                coordinatesToSpeedsIndexMap, times, genForceTraj, numThreads,
+                calcBodyForces);
         success = true;
 
         log_info("InverseDynamicsTool: {} time frames in {}.", nt, 
             watch.getElapsedTimeFormatted());
-    
-        JointSet jointsForEquivalentBodyForces;
-        getJointsByName(*_model, _jointsForReportingBodyForces, jointsForEquivalentBodyForces);
-        int nj = jointsForEquivalentBodyForces.getSize();
 
         // Generalized forces from ID Solver are in MultibodyTree order and not
         // necessarily in the order of the Coordinates in the Model.
@@ -450,45 +498,15 @@ bool InverseDynamicsTool::run()
 
         Storage genForceResults(nt);
         Storage bodyForcesResults(nt);
-        SpatialVec equivalentBodyForceAtJoint;
 
         for(int i=0; i<nt; i++){
             StateVector
                 genForceVec(times[i], genForceTraj[i]);
             genForceResults.append(genForceVec);
 
-            // if there are joints requested for equivalent body forces then calculate them
             if(nj>0){
-                Vector forces(6*nj, 0.0);
-                StateVector bodyForcesVec(times[i],
-                                          SimTK::Vector_<double>(6*nj,
-                                                                 &forces[0]));
-
-                s.updTime() = times[i];
-                Vector &q = s.updQ();
-                Vector &u = s.updU();
-
-                // Account for cases where qdot != u with coordinatesToSpeedsIndexMap
-                for( int j = 0; j < nq; ++j) {
-                    q[j] = coordFunctions.evaluate(j, 0, times[i]);
-                }
-                for (int j = 0; j < nu; ++j) {
-                    u[j] = coordFunctions.evaluate(
-                            coordinatesToSpeedsIndexMap[j], 1, times[i]);
-                }
-
-            
-                for(int j=0; j<nj; ++j){
-                    equivalentBodyForceAtJoint = jointsForEquivalentBodyForces[j].calcEquivalentSpatialForce(s, genForceTraj[i]);
-                    for(int k=0; k<3; ++k){
-                        // body force components
-                        bodyForcesVec.setDataValue(6*j+k, equivalentBodyForceAtJoint[1][k]); 
-                        // body torque components
-                        bodyForcesVec.setDataValue(6*j+k+3, equivalentBodyForceAtJoint[0][k]);
-                    }
-                }
+                StateVector bodyForcesVec(times[i], bodyForcesTraj[i]);
                 bodyForcesResults.append(bodyForcesVec);
-
             }
         }
 
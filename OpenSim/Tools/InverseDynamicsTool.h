@@ -88,6 +88,12 @@ protected:
     PropertyStr _outputBodyForcesAtJointsFileNameProp;
     std::string &_outputBodyForcesAtJointsFileName;
 
+    /** Number of threads that solve the time frames concurrently, each with
+        its own copy of the model: 0 (default) solves the frames in sequence,
+        1 uses all hardware threads. */
+    PropertyInt _parallelProp;
+    int &_parallel;
+
 //=============================================================================
 // METHODS
 //=============================================================================
@@ -156,6 +162,10 @@ public:
     void setLowpassCutoffFrequency(double aFrequency) {
         _lowpassCutoffFrequency = aFrequency;
     }
+    /** 0: solve the time frames in sequence; 1: solve them concurrently on
+        all hardware threads; greater than 1: use this number of threads. */
+    int getParallel() const { return _parallel; }
+    void setParallel(int parallel) { _parallel = parallel; }
     //--------------------------------------------------------------------------
     // INTERFACE
     //--------------------------------------------------------------------------
@@ -30,6 +30,7 @@
 #include "IKTaskSet.h"
 
 #include <OpenSim/Analyses/Kinematics.h>
+#include <OpenSim/Common/CommonUtilities.h>
 #include <OpenSim/Common/Constant.h>
 #include <OpenSim/Common/FunctionSet.h>
 #include <OpenSim/Common/GCVSplineSet.h>
@@ -40,10 +41,165 @@
 #include <OpenSim/Simulation/InverseKinematicsSolver.h>
 #include <OpenSim/Simulation/Model/Model.h>
 
+#include <thread>
+
 using namespace OpenSim;
 using namespace std;
 using namespace SimTK;
 
+namespace {
+// The solution of the frames of a trial: the coordinates of each frame and
+// the marker errors and locations requested for reporting.
+struct IKFrames {
+    explicit IKFrames(int numFrames)
+            : q(numFrames), squaredMarkerErrors(numFrames),
+              markerLocations(numFrames), numIterations(numFrames),
+              solveTimes(numFrames), accuracies(numFrames) {}
+
+    // Store the current solution of the solver as frame iframe. Frames can
+    // be stored concurrently, except for frame 0, which also stores the
+    // names of the markers in use.
+    void store(int iframe, InverseKinematicsSolver& solver,
+            const SimTK::State& s, bool reportErrors, bool reportLocations) {
+        q[iframe] = s.getQ();
+        numIterations[iframe] = solver.getNumIterations();
+        solveTimes[iframe] = solver.getSolveTime();
+        accuracies[iframe] = solver.getLastAccuracy();
+        if (reportErrors) {
+            squaredMarkerErrors[iframe].resize(solver.getNumMarkersInUse());
+            solver.computeCurrentSquaredMarkerErrors(
+                    squaredMarkerErrors[iframe]);
+        }
+        if (reportLocations)
+            solver.computeCurrentMarkerLocations(markerLocations[iframe]);
+        if (iframe == 0) {
+            markerNames.clear();
+            for (int j = 0; j < solver.getNumMarkersInUse(); ++j)
+                markerNames.push_back(solver.getMarkerNameForIndex(j));
+        }
+    }
+
+    std::vector<SimTK::Vector> q;
+    std::vector<SimTK::Array_<double>> squaredMarkerErrors;
+    std::vector<SimTK::Array_<Vec3>> markerLocations;
+    std::vector<std::string> markerNames;
+    // Statistics of the solver's track() for each frame.
+    std::vector<int> numIterations;
+    std::vector<double> solveTimes;
+    std::vector<double> accuracies;
+};
+
+// Number of time windows to solve concurrently, according to the tool's
+// parallel setting; 1 means that the frames are solved in sequence.
+int getNumParallelWindows(const InverseKinematicsTool& tool, int numFrames) {
+    const int parallel = tool.get_parallel();
+    if (parallel == 0) return 1;
+    const int numThreads = parallel == 1 ?
+            (int)std::thread::hardware_concurrency() : parallel;
+    // Each window should report at least twice as many frames as it solves
+    // only to warm up.
+    const int minFramesPerWindow =
+            std::max(1, 2 * tool.get_parallel_window_overlap());
+    return std::max(1, std::min(numThreads, numFrames / minFramesPerWindow));
+}
+
+// Solve the frames of the trial in numWindows consecutive time windows, each
+// with its own copy of the model and solver on its own thread. A window
+// assembles the model at its first frame and then tracks the frames that
+// follow, starting parallel_window_overlap frames before the first frame it
+// reports. Where a window's solution in the overlap disagrees with the
+// previous window's, it converged to a different solution, and it is solved
+// again (with ikSolver) starting from the previous window's solution, as the
+// frames are solved in sequence.
+void solveInParallel(const InverseKinematicsTool& tool, const Model& model,
+        InverseKinematicsSolver& ikSolver, SimTK::State& s,
+        const MarkersReference& markersReference,
+        const SimTK::Array_<CoordinateReference>& coordinateReferences,
+        const std::vector<double>& times, int start_ix, int numWindows,
+        IKFrames& frames) {
+    const int numFrames = (int)frames.q.size();
+    const int overlap = tool.get_parallel_window_overlap();
+    const bool reportErrors = tool.get_report_errors();
+    const bool reportLocations = tool.get_report_marker_locations();
+
+    struct Window {
+        int first; // First frame solved, by a full assembly.
+        int begin; // First frame reported.
+        int end;   // One past the last frame reported.
+        SimTK::Vector overlapQ; // Solution at frame begin - 1.
+        std::unique_ptr<Model> model;
+        std::shared_ptr<MarkersReference> markersReference;
+        SimTK::Array_<CoordinateReference> coordinateReferences;
+    };
+    // The models are copied and initialized on this thread.
+    std::vector<Window> windows(numWindows);
+    for (int w = 0; w < numWindows; ++w) {
+        Window& window = windows[w];
+        window.begin = start_ix + (int)((long long)w * numFrames / numWindows);
+        window.end =
+                start_ix + (int)((long long)(w + 1) * numFrames / numWindows);
+        window.first = std::max(start_ix, window.begin - overlap);
+        window.model.reset(model.clone());
+        // Only the model of the tool reports; discard copies of analyses.
+        window.model->updAnalysisSet().clearAndDestroy();
+        window.model->initSystem();
+        window.markersReference =
+                std::make_shared<MarkersReference>(markersReference);
+        window.coordinateReferences = coordinateReferences;
+    }
+
+    log_info("Solving {} frames in {} windows in parallel.", numFrames,
+            numWindows);
+    parallelFor(numWindows, [&](int w) {
+        Window& window = windows[w];
+        SimTK::State state = window.model->getWorkingState();
+        InverseKinematicsSolver solver(*window.model,
+                window.markersReference, window.coordinateReferences,
+                tool.get_constraint_weight());
+        solver.setAccuracy(tool.get_accuracy());
+        solver.setPredictorOrder(tool.get_predictor_order());
+        state.updTime() = times[window.first];
+        solver.assemble(state);
+        for (int i = window.first; i < window.end; ++i) {
+            state.updTime() = times[i];
+            solver.track(state);
+            if (i >= window.begin) {
+                frames.store(i - start_ix, solver, state, reportErrors,
+                        reportLocations);
+            } else if (i == window.begin - 1) {
+                window.overlapQ = state.getQ();
+            }
+        }
+        log_info("Solved frames {} to {}.", window.begin - start_ix,
+                window.end - 1 - start_ix);
+    }, numWindows);
+
+    // Stitch the windows together.
+    const double tolerance = std::max(1e-4, 100 * tool.get_accuracy());
+    for (int w = 1; w < numWindows; ++w) {
+        const Window& window = windows[w];
+        const SimTK::Vector& previous = frames.q[window.begin - 1 - start_ix];
+        const double difference = max(abs(window.overlapQ - previous));
+        if (difference <= tolerance) continue;
+
+        log_warn("InverseKinematicsTool: the solution at time {} differs "
+                 "between consecutive windows (max coordinate difference "
+                 "{}); solving frames {} to {} again in sequence.",
+                times[window.begin - 1], difference, window.begin - start_ix,
+                window.end - 1 - start_ix);
+        s.updTime() = times[window.begin];
+        s.updQ() = previous;
+        ikSolver.assemble(s);
+        for (int i = window.begin; i < window.end; ++i) {
+            s.updTime() = times[i];
+            ikSolver.track(s);
+            frames.store(i - start_ix, ikSolver, s, reportErrors,
+                    reportLocations);
+        }
+    }
+}
+} // anonymous namespace
+
 //=============================================================================
 // CONSTRUCTOR(S) AND DESTRUCTOR
 //=============================================================================
@@ -86,6 +242,10 @@ void InverseKinematicsTool::constructProperties()
     constructProperty_marker_file("");
     constructProperty_coordinate_file("");
     constructProperty_report_marker_locations(false);
+    constructProperty_parallel(0);
+    constructProperty_parallel_window_overlap(10);
+    constructProperty_predictor_order(0);
+    constructProperty_report_solver_statistics(false);
 }
 
 //=============================================================================
@@ -115,6 +275,13 @@ bool InverseKinematicsTool::run()
         else
             modelFromFile = false;
 
+        OPENSIM_THROW_IF_FRMOBJ(get_parallel() < 0, Exception,
+                "Expected 'parallel' to be non-negative, but got {}.",
+                get_parallel());
+        OPENSIM_THROW_IF_FRMOBJ(get_parallel_window_overlap() < 1, Exception,
+                "Expected 'parallel_window_overlap' to be at least 1, but got "
+                "{}.", get_parallel_window_overlap());
+
         // although newly loaded model will be finalized
         // there is no guarantee that the _model has not been edited/modified
         _model->finalizeFromProperties();
@@ -170,39 +337,59 @@ bool InverseKinematicsTool::run()
         InverseKinematicsSolver ikSolver(*_model, make_shared<MarkersReference>(markersReference),
             coordinateReferences, get_constraint_weight());
         ikSolver.setAccuracy(get_accuracy());
-        s.updTime() = times[start_ix];
-        ikSolver.assemble(s);
-        kinematicsReporter->begin(s);
+        ikSolver.setPredictorOrder(get_predictor_order());
+
+        Stopwatch watch;
+
+        // Solve all frames, keeping the coordinates and marker data of each.
+        IKFrames frames(Nframes);
+        const int numWindows = getNumParallelWindows(*this, Nframes);
+        if (numWindows > 1) {
+            solveInParallel(*this, *_model, ikSolver, s, markersReference,
+                    coordinateReferences, times, start_ix, numWindows,
+                    frames);
+        } else {
+            s.updTime() = times[start_ix];
+            ikSolver.assemble(s);
+            for (int i = start_ix; i <= final_ix; ++i) {
+                s.updTime() = times[i];
+                ikSolver.track(s);
+                frames.store(i - start_ix, ikSolver, s,
+                        get_report_errors(), get_report_marker_locations());
+                // show progress line every 1000 frames so users see progress
+                if (std::remainder(i - start_ix, 1000) == 0 && i != start_ix)
+                    log_info("Solved {} frame(s)...", i - start_ix);
+            }
+        }
 
-        AnalysisSet& analysisSet = _model->updAnalysisSet();
-        analysisSet.begin(s);
         // Get the actual number of markers the Solver is using, which
         // can be fewer than the number of references if there isn't a
         // corresponding model marker for each reference.
-        int nm = ikSolver.getNumMarkersInUse();
-        SimTK::Array_<double> squaredMarkerErrors(nm, 0.0);
-        SimTK::Array_<Vec3> markerLocations(nm, Vec3(0));
-        
+        const int nm = (int)frames.markerNames.size();
+
         Storage *modelMarkerLocations = get_report_marker_locations() ?
             new Storage(Nframes, "ModelMarkerLocations") : nullptr;
         Storage *modelMarkerErrors = get_report_errors() ? 
             new Storage(Nframes, "ModelMarkerErrors") : nullptr;
 
-        Stopwatch watch;
-
+        AnalysisSet& analysisSet = _model->updAnalysisSet();
         for (int i = start_ix; i <= final_ix; ++i) {
+            const int iframe = i - start_ix;
             s.updTime() = times[i];
-            ikSolver.track(s);
-            // show progress line every 1000 frames so users see progress
-            if (std::remainder(i - start_ix, 1000) == 0 && i != start_ix)
-                log_info("Solved {} frame(s)...", i - start_ix);
+            s.updQ() = frames.q[iframe];
+            if (i == start_ix) {
+                kinematicsReporter->begin(s);
+                analysisSet.begin(s);
+            }
+
             if(get_report_errors()){
+                const SimTK::Array_<double>& squaredMarkerErrors =
+                        frames.squaredMarkerErrors[iframe];
                 Array<double> markerErrors(0.0, 3);
                 double totalSquaredMarkerError = 0.0;
                 double maxSquaredMarkerError = 0.0;
                 int worst = -1;
 
-                ikSolver.computeCurrentSquaredMarkerErrors(squaredMarkerErrors);
                 for(int j=0; j<nm; ++j){
                     totalSquaredMarkerError += squaredMarkerErrors[j];
                     if(squaredMarkerErrors[j] > maxSquaredMarkerError){
@@ -221,11 +408,12 @@ bool InverseKinematicsTool::run()
                          "marker error: RMS = {}, max = {} ({})", 
                     i, s.getTime(), totalSquaredMarkerError, rms,
                     sqrt(maxSquaredMarkerError), 
-                    ikSolver.getMarkerNameForIndex(worst));
+                    worst < 0 ? "" : frames.markerNames[worst]);
             }
 
             if(get_report_marker_locations()){
-                ikSolver.computeCurrentMarkerLocations(markerLocations);
+                const SimTK::Array_<Vec3>& markerLocations =
+                        frames.markerLocations[iframe];
                 Array<double> locations(0.0, 3*nm);
                 for(int j=0; j<nm; ++j){
                     for(int k=0; k<3; ++k)
@@ -276,7 +464,7 @@ bool InverseKinematicsTool::run()
 
             for(int j=0; j<nm; ++j){
                 for(int k=0; k<3; ++k)
-                    labels.set(3*j+k+1, ikSolver.getMarkerNameForIndex(j)+XYZ[k]);
+                    labels.set(3*j+k+1, frames.markerNames[j]+XYZ[k]);
             }
             modelMarkerLocations->setColumnLabels(labels);
             modelMarkerLocations->setName("Model Marker Locations from IK");
@@ -289,10 +477,34 @@ bool InverseKinematicsTool::run()
             delete modelMarkerLocations;
         }
 
+        if (get_report_solver_statistics()) {
+            Storage statistics(Nframes, "SolverStatistics");
+            Array<string> labels("", 4);
+            labels[0] = "time";
+            labels[1] = "num_iterations";
+            labels[2] = "solve_time";
+            labels[3] = "accuracy";
+            statistics.setColumnLabels(labels);
+            statistics.setName("Solver Statistics from IK");
+            for (int iframe = 0; iframe < Nframes; ++iframe) {
+                const double values[3] = {(double)frames.numIterations[iframe],
+                        frames.solveTimes[iframe], frames.accuracies[iframe]};
+                statistics.append(times[start_ix + iframe], 3, values);
+            }
+            IO::makeDir(getResultsDir());
+            Storage::printResult(&statistics, trialName + "_ik_solver_statistics",
+                                 getResultsDir(), -1, ".sto");
+        }
+
         success = true;
 
-        log_info("InverseKinematicsTool completed {} frames in {}.", Nframes,
-            watch.getElapsedTimeFormatted());
+        long long totalIterations = 0;
+        for (int numIterations : frames.numIterations)
+            totalIterations += numIterations;
+        log_info("InverseKinematicsTool completed {} frames in {} ({:.1f} "
+                 "iterations per frame).", Nframes,
+            watch.getElapsedTimeFormatted(),
+            Nframes > 0 ? (double)totalIterations / Nframes : 0.0);
     }
     catch (const std::exception& ex) {
         log_error("InverseKinematicsTool Failed: {}", ex.what());
@@ -71,6 +71,30 @@ public:
             "Flag indicating whether or not to report model marker locations. "
             "Note, model marker locations are expressed in Ground.");
 
+    OpenSim_DECLARE_PROPERTY(parallel, int,
+            "Solve consecutive time windows of the trial in parallel? "
+            "0: no, solve the frames in sequence (default); 1: use all cores; "
+            "greater than 1: use this number of threads. Each window uses its "
+            "own copy of the model.");
+
+    OpenSim_DECLARE_PROPERTY(parallel_window_overlap, int,
+            "When solving in parallel, the number of frames (at least 1) that "
+            "each window solves before the first frame it reports, and over "
+            "which its solution is checked against the previous window's. "
+            "Default is 10.");
+
+    OpenSim_DECLARE_PROPERTY(predictor_order, int,
+            "Initial guess for the solution of each frame: 0: the solution of "
+            "the previous frame (default); 1: extrapolate linearly from the "
+            "previous 2 frames; 2: extrapolate quadratically from the "
+            "previous 3 frames. Extrapolating can reduce the number of "
+            "iterations per frame for fast motions or low frame rates.");
+
+    OpenSim_DECLARE_PROPERTY(report_solver_statistics, bool,
+            "Flag indicating whether or not to report the number of "
+            "iterations, the time and the accuracy used by the solver for "
+            "each frame.");
+
 //=============================================================================
 // METHODS
 //=============================================================================
@@ -70,6 +70,7 @@ RRATool::RRATool() :
     _initialTimeForCOMAdjustment(_initialTimeForCOMAdjustmentProp.getValueDbl()),
     _finalTimeForCOMAdjustment(_finalTimeForCOMAdjustmentProp.getValueDbl()),
     _adjustedCOMBody(_adjustedCOMBodyProp.getValueStr()),
+    _numberOfPasses(_numberOfPassesProp.getValueInt()),
     _outputModelFile(_outputModelFileProp.getValueStr()),
     _verbose(_verboseProp.getValueBool())
 {
@@ -95,6 +96,7 @@ RRATool::RRATool(const string &aFileName, bool aLoadModel) :
     _initialTimeForCOMAdjustment(_initialTimeForCOMAdjustmentProp.getValueDbl()),
     _finalTimeForCOMAdjustment(_finalTimeForCOMAdjustmentProp.getValueDbl()),
     _adjustedCOMBody(_adjustedCOMBodyProp.getValueStr()),
+    _numberOfPasses(_numberOfPassesProp.getValueInt()),
     _outputModelFile(_outputModelFileProp.getValueStr()),
     _verbose(_verboseProp.getValueBool())
 {
@@ -160,6 +162,7 @@ RRATool(const RRATool &aTool) :
     _initialTimeForCOMAdjustment(_initialTimeForCOMAdjustmentProp.getValueDbl()),
     _finalTimeForCOMAdjustment(_finalTimeForCOMAdjustmentProp.getValueDbl()),
     _adjustedCOMBody(_adjustedCOMBodyProp.getValueStr()),
+    _numberOfPasses(_numberOfPassesProp.getValueInt()),
     _outputModelFile(_outputModelFileProp.getValueStr()),
     _verbose(_verboseProp.getValueBool())
 {
@@ -190,6 +193,7 @@ setNull()
     _adjustCOMToReduceResiduals = false;
     _initialTimeForCOMAdjustment = -1;
     _finalTimeForCOMAdjustment = -1;
+    _numberOfPasses = 1;
     _outputModelFile = "";
     _adjustKinematicsToReduceResiduals=true;
     _verbose = false;
@@ -279,6 +283,18 @@ void RRATool::setupProperties()
     _adjustedCOMBodyProp.setName("adjusted_com_body");
     _propertySet.append( &_adjustedCOMBodyProp );
 
+    comment = "Number of passes (default 1). Each pass after the first moves the "
+                 "center of mass of the adjusted body to reduce the average residuals "
+                 "of the previous pass and tracks the desired kinematics again, reusing "
+                 "the model, the fitted kinematics and the external loads, and starting "
+                 "the optimizer from the actuator forces of the previous pass. The "
+                 "model's system is rebuilt (initSystem()) for each pass after the "
+                 "first, since its mass properties change. Requires "
+                 "adjust_com_to_reduce_residuals to be true if greater than 1.";
+    _numberOfPassesProp.setComment(comment);
+    _numberOfPassesProp.setName("number_of_passes");
+    _propertySet.append( &_numberOfPassesProp );
+
     comment = "Name of the output model file (.osim) containing adjustments to anthropometry "
                  "made to reduce average residuals. This file is written if the property "
                  "adjust_com_to_reduce_residuals is set to true. If a name is not specified, "
@@ -325,6 +341,7 @@ operator=(const RRATool &aTool)
     _adjustCOMToReduceResiduals = aTool._adjustCOMToReduceResiduals;
     _initialTimeForCOMAdjustment = aTool._initialTimeForCOMAdjustment;
     _finalTimeForCOMAdjustment = aTool._finalTimeForCOMAdjustment;
+    _numberOfPasses = aTool._numberOfPasses;
     _verbose = aTool._verbose;
 
     return(*this);
@@ -372,6 +389,12 @@ bool RRATool::run()
             throw Exception("RRATool: ERROR- Body '"+_adjustedCOMBody+"' specified in "+
                                  _adjustedCOMBodyProp.getName()+" not found",__FILE__,__LINE__);
     }
+    if(_numberOfPasses < 1)
+        throw Exception("RRATool: ERROR- "+_numberOfPassesProp.getName()+" must be at least 1",
+                             __FILE__,__LINE__);
+    if(_numberOfPasses > 1 && !_adjustCOMToReduceResiduals)
+        throw Exception("RRATool: ERROR- "+_numberOfPassesProp.getName()+" is greater than 1 but "+
+                             _adjustCOMToReduceResidualsProp.getName()+" is false",__FILE__,__LINE__);
 
     /*bool externalLoads = */createExternalLoads(_externalLoadsFileName, *_model);
 
@@ -617,30 +640,6 @@ bool RRATool::run()
             _constraintsFileName);
     }
 
-    // ---- INITIAL STATES ----
-    Array<double> q(0.0,nq);
-    Array<double> u(0.0,nu);
-    if(desiredKinFlag) {
-        log_info("Using the generalized coordinates specified in '{}' to set "
-            "the initial configuration.", _desiredKinematicsFileName);
-        qSet->evaluate(q,0,_ti);
-        uSet->evaluate(u,0,_ti);
-    } else {
-        log_info("Using the generalized coordinates specified as zeros to set "
-            "the initial configuration.");
-    }
-
-    // formCompleteStorages ensures qSet is in order of model Coordinates
-    // but we cannot assume order of coordinates is the same in the State,
-    // so set each Coordinate value and speed individually.
-    const CoordinateSet& coords = _model->getCoordinateSet();
-    for (int i = 0; i < nq; ++i) {
-        // The last argument to setValue is a bool to enforce kinematic constraints
-        // or not. It is being set to true when we set the last coordinate value.
-        coords[i].setValue(s, q[i], i==(nq-1));
-        coords[i].setSpeedValue(s, u[i]);
-    }
-
     // Actuator force predictor
     // This requires the trajectories of the generalized coordinates
     // to be specified.
@@ -724,164 +723,222 @@ bool RRATool::run()
 
     controller->setCheckTargetTime(true);
 
-    // ---- SIMULATION ----
-    //
-    // Manager
-    Manager manager(*_model);
-    manager.setIntegratorMaximumStepSize(_maxDT);
-    manager.setIntegratorMinimumStepSize(_minDT);
-    manager.setIntegratorAccuracy(_errorTolerance);
+    // ---- PASSES ----
+    // Every pass tracks the same desired kinematics with the same model,
+    // controller, predictor and splines. After every pass but the last, the
+    // center of mass of the adjusted body is moved to reduce the average
+    // residuals of that pass, and the optimizer of the next pass starts from
+    // its actuator forces.
+    const double tiFirstPass = _ti;
+    Array<double> FAve(0.0,3),MAve(0.0,3);
+    stringstream adjQMsg;
+    for(int pass=1;pass<=_numberOfPasses;pass++) {
+        if(_numberOfPasses > 1) {
+            log_info("RRA pass {} of {}.", pass, _numberOfPasses);
+        }
+
+        // ---- INITIAL STATES ----
+        Array<double> q(0.0,nq);
+        Array<double> u(0.0,nu);
+        if(desiredKinFlag) {
+            log_info("Using the generalized coordinates specified in '{}' to set "
+                "the initial configuration.", _desiredKinematicsFileName);
+            qSet->evaluate(q,0,_ti);
+            uSet->evaluate(u,0,_ti);
+        } else {
+            log_info("Using the generalized coordinates specified as zeros to set "
+                "the initial configuration.");
+        }
+
+        // formCompleteStorages ensures qSet is in order of model Coordinates
+        // but we cannot assume order of coordinates is the same in the State,
+        // so set each Coordinate value and speed individually.
+        const CoordinateSet& coords = _model->getCoordinateSet();
+        for (int i = 0; i < nq; ++i) {
+            // The last argument to setValue is a bool to enforce kinematic constraints
+            // or not. It is being set to true when we set the last coordinate value.
+            coords[i].setValue(s, q[i], i==(nq-1));
+            coords[i].setSpeedValue(s, u[i]);
+        }
+
+        // ---- SIMULATION ----
+        //
+        // Manager
+        Manager manager(*_model);
+        manager.setIntegratorMaximumStepSize(_maxDT);
+        manager.setIntegratorMinimumStepSize(_minDT);
+        manager.setIntegratorAccuracy(_errorTolerance);
     
-    _model->setAllControllersEnabled( true );
-
-    manager.setSessionName(getName());
-    s.setTime(_ti);
-    double finalTime = _tf - _targetDT - SimTK::Zero;
-
-    // Initialize integrand controls using controls read in from file (which specify min/max control values)
-    initializeControlSetUsingConstraints(NULL,controlConstraints, controller->updControlSet());
-
-    // Initial auxiliary states
-    time_t startTime,finishTime;
-    double elapsedTime;
-    if( s.getNZ() > 0) { // If there are actuator states (i.e. muscles dynamics)
-        log_info("-----------------------------------------------------------------");
-        log_info("Computing initial values for muscles states (activation, length):");
-        log_info("-----------------------------------------------------------------");
+        _model->setAllControllersEnabled( true );
+
+        manager.setSessionName(getName());
+        s.setTime(_ti);
+        double finalTime = _tf - _targetDT - SimTK::Zero;
+
+        // Initialize integrand controls using controls read in from file (which specify min/max control values)
+        initializeControlSetUsingConstraints(NULL,controlConstraints, controller->updControlSet());
+
+        // Initial auxiliary states
+        time_t startTime,finishTime;
+        double elapsedTime;
+        if( s.getNZ() > 0) { // If there are actuator states (i.e. muscles dynamics)
+            log_info("-----------------------------------------------------------------");
+            log_info("Computing initial values for muscles states (activation, length):");
+            log_info("-----------------------------------------------------------------");
+            time(&startTime);
+            log_info(" -- Start time = {}", getTimeString(startTime));
+            log_info("-----------------------------------------------------------------");
+            log_info("");
+
+            try {
+            controller->computeInitialStates(s,_ti);
+            }
+            catch(const Exception& x) {
+            // TODO: eventually might want to allow writing of partial results
+                log_error(x.what());
+                return false;
+            }
+            catch(...) {
+                // TODO: eventually might want to allow writing of partial results
+                // close open files if we die prematurely (e.g. Opt fail)
+                return false;
+            }
+            time(&finishTime);
+            // copy the final states from the last integration 
+            s.updY() = cmcActSubsystem.getCompleteState().getY();
+            log_info("----------------------------------");
+            log_info("Finished computing initial states:");
+            log_info("----------------------------------");
+            log_info(" -- Start time = {}", getTimeString(startTime));
+            log_info(" -- Finish time = {}", getTimeString(finishTime));
+            elapsedTime = difftime(finishTime, startTime);
+            log_info(" -- Elapsed time = {} seconds.", elapsedTime);
+            log_info("----------------------------------");
+            log_info("");
+
+        } else {
+            cmcActSubsystem.setCompleteState( s );
+            actuatorSystemState.updTime() = _ti; 
+            s.updTime() = _ti;
+            actuatorSystem.realize(actuatorSystemState, Stage::Time );
+            controller->setTargetDT(1.0e-8);
+            controller->computeControls( s, controller->updControlSet() );
+            controller->setTargetDT(_targetDT);
+        }
+
+        // ---- INTEGRATE ----
+        log_info("--------------------------------------------");
+        log_info("Using CMC to track the specified kinematics:");
+        log_info("--------------------------------------------");
+        log_info(" -- Integrating from {} to {}", _ti, _tf);
+        s.updTime() = _ti;
+        controller->setTargetTime( _ti );
         time(&startTime);
         log_info(" -- Start time = {}", getTimeString(startTime));
-        log_info("-----------------------------------------------------------------");
+        log_info("--------------------------------------------");
         log_info("");
 
+        _model->getMultibodySystem().realize(s, Stage::Acceleration );
+
+        controller->updTaskSet().computeAccelerations(s);
+
+        cmcActSubsystem.setCompleteState( s );
+
+        // Set output file names so that files are flushed regularly in case we fail
+        IO::makeDir(getResultsDir());   // Create directory for output in case it doesn't exist
+        manager.getStateStorage().setOutputFileName(getResultsDir() + "/" + getName() + "_states.sto");
         try {
-        controller->computeInitialStates(s,_ti);
+            manager.initialize(s);
+            manager.integrate(finalTime);
         }
         catch(const Exception& x) {
-        // TODO: eventually might want to allow writing of partial results
+            // TODO: eventually might want to allow writing of partial results
             log_error(x.what());
+            cwd.restore();
+            // close open files if we die prematurely (e.g. Opt fail)
+            manager.getStateStorage().print(getResultsDir() + "/" + getName() + "_states.sto");
             return false;
         }
         catch(...) {
             // TODO: eventually might want to allow writing of partial results
+            cwd.restore();
             // close open files if we die prematurely (e.g. Opt fail)
+            manager.getStateStorage().print(getResultsDir() + "/" + getName() + "_states.sto");
             return false;
         }
         time(&finishTime);
-        // copy the final states from the last integration 
-        s.updY() = cmcActSubsystem.getCompleteState().getY();
-        log_info("----------------------------------");
-        log_info("Finished computing initial states:");
-        log_info("----------------------------------");
+        log_info("-------------------------------------------");
+        log_info("Finished tracking the specified kinematics:");
+        log_info("-------------------------------------------");
+        if( _verbose ){
+          log_info(" -- States = {}", s.getY());
+        }
         log_info(" -- Start time = {}", getTimeString(startTime));
         log_info(" -- Finish time = {}", getTimeString(finishTime));
         elapsedTime = difftime(finishTime, startTime);
         log_info(" -- Elapsed time = {} seconds.", elapsedTime);
-        log_info("----------------------------------");
+        log_info("-------------------------------------------");
         log_info("");
 
-    } else {
-        cmcActSubsystem.setCompleteState( s );
-        actuatorSystemState.updTime() = _ti; 
-        s.updTime() = _ti;
-        actuatorSystem.realize(actuatorSystemState, Stage::Time );
-        controller->setTargetDT(1.0e-8);
-        controller->computeControls( s, controller->updControlSet() );
-        controller->setTargetDT(_targetDT);
-    }
-
-    // ---- INTEGRATE ----
-    log_info("--------------------------------------------");
-    log_info("Using CMC to track the specified kinematics:");
-    log_info("--------------------------------------------");
-    log_info(" -- Integrating from {} to {}", _ti, _tf);
-    s.updTime() = _ti;
-    controller->setTargetTime( _ti );
-    time(&startTime);
-    log_info(" -- Start time = {}", getTimeString(startTime));
-    log_info("--------------------------------------------");
-    log_info("");
-
-    _model->getMultibodySystem().realize(s, Stage::Acceleration );
-
-    controller->updTaskSet().computeAccelerations(s);
+        // AVERAGE RESIDUALS
+        const Storage *forceStore = NULL;
+        if(_model->getAnalysisSet().getIndex("Actuation") != -1) {
+            Actuation& actuation = (Actuation&)_model->getAnalysisSet().get("Actuation");
+            forceStore = actuation.getForceStorage();
+            computeAverageResiduals(*forceStore,FAve,MAve);
+        }
 
-    cmcActSubsystem.setCompleteState( s );
+        // PREPARE THE NEXT PASS
+        // The model keeps its components; only its mass properties change, so
+        // its system is rebuilt, but nothing is reloaded.
+        if(pass<_numberOfPasses) {
+            log_info("Average residuals after pass {}: FX={} FY={} FZ={} MX={} "
+                "MY={} MZ={}.", pass, FAve[0], FAve[1], FAve[2], MAve[0],
+                MAve[1], MAve[2]);
+            massAdjMsg += adjustCOMToReduceResiduals(FAve,MAve);
+            _model->initSystem();
+            _model->getMultibodySystem().realize(s, Stage::Position );
+            _model->equilibrateMuscles(s);
+            if(forceStore) controller->setInitialGuessForces(forceStore);
+            // computeInitialStates() advanced the initial time.
+            _ti = tiFirstPass;
+            continue;
+        }
 
-    // Set output file names so that files are flushed regularly in case we fail
-    IO::makeDir(getResultsDir());   // Create directory for output in case it doesn't exist
-    manager.getStateStorage().setOutputFileName(getResultsDir() + "/" + getName() + "_states.sto");
-    try {
-        manager.initialize(s);
-        manager.integrate(finalTime);
-    }
-    catch(const Exception& x) {
-        // TODO: eventually might want to allow writing of partial results
-        log_error(x.what());
-        cwd.restore();
-        // close open files if we die prematurely (e.g. Opt fail)
-        manager.getStateStorage().print(getResultsDir() + "/" + getName() + "_states.sto");
-        return false;
-    }
-    catch(...) {
-        // TODO: eventually might want to allow writing of partial results
-        cwd.restore();
-        // close open files if we die prematurely (e.g. Opt fail)
+        // ---- RESULTS -----
+        printResults(getName(),getResultsDir()); // this will create results directory if necessary
+        controller->updControlSet().print(getResultsDir() + "/" + getName() + "_controls.xml");
+        _model->printControlStorage(getResultsDir() + "/" + getName() + "_controls.sto");
         manager.getStateStorage().print(getResultsDir() + "/" + getName() + "_states.sto");
-        return false;
-    }
-    time(&finishTime);
-    log_info("-------------------------------------------");
-    log_info("Finished tracking the specified kinematics:");
-    log_info("-------------------------------------------");
-    if( _verbose ){
-      log_info(" -- States = {}", s.getY());
-    }
-    log_info(" -- Start time = {}", getTimeString(startTime));
-    log_info(" -- Finish time = {}", getTimeString(finishTime));
-    elapsedTime = difftime(finishTime, startTime);
-    log_info(" -- Elapsed time = {} seconds.", elapsedTime);
-    log_info("-------------------------------------------");
-    log_info("");
-
-    // ---- RESULTS -----
-    printResults(getName(),getResultsDir()); // this will create results directory if necessary
-    controller->updControlSet().print(getResultsDir() + "/" + getName() + "_controls.xml");
-    _model->printControlStorage(getResultsDir() + "/" + getName() + "_controls.sto");
-    manager.getStateStorage().print(getResultsDir() + "/" + getName() + "_states.sto");
-    /*
-    Storage statesDegrees(manager.getStateStorage());
-    _model->getSimbodyEngine().convertRadiansToDegrees(statesDegrees);
-    statesDegrees.setWriteSIMMHeader(true);
-    statesDegrees.print(getResultsDir() + "/" + getName() + "_states_degrees.mot");
-    */
-    controller->getPositionErrorStorage()->print(getResultsDir() + "/" + getName() + "_pErr.sto");
-
-    stringstream adjQMsg;
-    if(_model->getAnalysisSet().getIndex("Actuation") != -1) {
-        Actuation& actuation = (Actuation&)_model->getAnalysisSet().get("Actuation");
-        Array<double> FAve(0.0,3),MAve(0.0,3);
-        Storage *forceStore = actuation.getForceStorage();
-        computeAverageResiduals(*forceStore,FAve,MAve);
-
-        adjQMsg << endl;
-        adjQMsg << "************************************************************" << endl;
-        adjQMsg << "*                   Final Average Residuals                *" << endl;
-        adjQMsg << "************************************************************" << endl;
-        adjQMsg << "* After "<<_adjustedCOMBody<<" COM and Kinematics adjustments:"<< endl;
-        adjQMsg << "*  FX="<<FAve[0]<<" FY="<<FAve[1]<<" FZ="<<FAve[2]<<endl;
-        adjQMsg << "*  MX="<<MAve[0]<<" MY="<<MAve[1]<<" MZ="<<MAve[2]<<endl;
-        adjQMsg << "************************************************************\n" << endl;
-
-        // Write the average residuals (DC offsets) out to a file
-        ofstream residualFile((getResultsDir() + "/" + getName() + "_avgResiduals.txt").c_str());
-        residualFile << "Average Residuals:\n\n";
-        residualFile << "FX average = " << FAve[0] << "\n";
-        residualFile << "FY average = " << FAve[1] << "\n";
-        residualFile << "FZ average = " << FAve[2] << "\n";
-        residualFile << "MX average = " << MAve[0] << "\n";
-        residualFile << "MY average = " << MAve[1] << "\n";
-        residualFile << "MZ average = " << MAve[2] << "\n";
-        residualFile.close();
+        /*
+        Storage statesDegrees(manager.getStateStorage());
+        _model->getSimbodyEngine().convertRadiansToDegrees(statesDegrees);
+        statesDegrees.setWriteSIMMHeader(true);
+        statesDegrees.print(getResultsDir() + "/" + getName() + "_states_degrees.mot");
+        */
+        controller->getPositionErrorStorage()->print(getResultsDir() + "/" + getName() + "_pErr.sto");
+
+        if(forceStore) {
+            adjQMsg << endl;
+            adjQMsg << "************************************************************" << endl;
+            adjQMsg << "*                   Final Average Residuals                *" << endl;
+            adjQMsg << "************************************************************" << endl;
+            adjQMsg << "* After "<<_adjustedCOMBody<<" COM and Kinematics adjustments:"<< endl;
+            adjQMsg << "*  FX="<<FAve[0]<<" FY="<<FAve[1]<<" FZ="<<FAve[2]<<endl;
+            adjQMsg << "*  MX="<<MAve[0]<<" MY="<<MAve[1]<<" MZ="<<MAve[2]<<endl;
+            adjQMsg << "************************************************************\n" << endl;
+
+            // Write the average residuals (DC offsets) out to a file
+            ofstream residualFile((getResultsDir() + "/" + getName() + "_avgResiduals.txt").c_str());
+            residualFile << "Average Residuals:\n\n";
+            residualFile << "FX average = " << FAve[0] << "\n";
+            residualFile << "FY average = " << FAve[1] << "\n";
+            residualFile << "FZ average = " << FAve[2] << "\n";
+            residualFile << "MX average = " << MAve[0] << "\n";
+            residualFile << "MY average = " << MAve[1] << "\n";
+            residualFile << "MZ average = " << MAve[2] << "\n";
+            residualFile.close();
+        }
     }
 
     // Write new model file
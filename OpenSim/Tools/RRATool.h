@@ -106,6 +106,12 @@ private:
     /** Name of the body whose center of mass is adjusted. */
     PropertyStr _adjustedCOMBodyProp;
     std::string &_adjustedCOMBody;
+    /** Number of passes. Each pass after the first adjusts the center of
+    mass of the adjusted body to reduce the average residuals of the
+    previous pass, and then tracks the desired kinematics again. The model's
+    system is rebuilt with initSystem() for each of these passes. */
+    PropertyInt _numberOfPassesProp;
+    int &_numberOfPasses;
     /** Name of the output model file containing adjustments to anthropometry
     made to reduce average residuals. This file is written if the property
     adjust_com_to_reduce_residuals is set to true. */
@@ -170,6 +176,9 @@ public:
     const std::string &getAdjustedCOMBody() { return _adjustedCOMBody; }
     void setAdjustedCOMBody(const std::string &aBody) { _adjustedCOMBody = aBody; }
 
+    int getNumberOfPasses() const { return _numberOfPasses; }
+    void setNumberOfPasses(int aNumberOfPasses) { _numberOfPasses = aNumberOfPasses; }
+
     double getLowpassCutoffFrequency() const { return _lowpassCutoffFrequency; }
     void setLowpassCutoffFrequency(double aLowpassCutoffFrequency) { _lowpassCutoffFrequency = aLowpassCutoffFrequency; }
 